@@ -2,7 +2,14 @@ class_name Area
 extends Resource
 
 var color: Color
-var polygon: PackedVector2Array
+var polygon: PackedVector2Array:
+	set(value):
+		# The simulation reassigns every polygon each tick, mostly unchanged
+		if value == polygon:
+			return
+		polygon = value
+		polygon_version += 1
+var polygon_version: int = 0	# Bumped when the polygon data changes, keys navigation caches
 var owner_id: int
 var polygon_id: int
 var center: Vector2
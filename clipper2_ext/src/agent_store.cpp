@@ -0,0 +1,523 @@
+#include "agent_store.h"
+#include "polygon_queries.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+void AgentStore::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("configure", "spawn_fade_time", "die_fade_time", "unit_alpha", "slot_reach_time", "min_speed", "max_speed"),
+        &AgentStore::configure
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_area", "key", "polygon", "offsets"),
+        &AgentStore::set_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("remove_area", "key"),
+        &AgentStore::remove_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_area_strengths", "keys", "strengths"),
+        &AgentStore::set_area_strengths
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_group_rates", "rates"),
+        &AgentStore::set_group_rates
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_owner_tints", "tints"),
+        &AgentStore::set_owner_tints
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("add_agent", "position", "area_key", "owner_id"),
+        &AgentStore::add_agent
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("kill_in_area", "area_key", "count"),
+        &AgentStore::kill_in_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("kill_area", "area_key"),
+        &AgentStore::kill_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear"),
+        &AgentStore::clear
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_assignments", "indices", "slots", "groups", "holding"),
+        &AgentStore::set_assignments
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_groups", "indices", "groups"),
+        &AgentStore::set_groups
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear_groups"),
+        &AgentStore::clear_groups
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_count"),
+        &AgentStore::get_count
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("begin_step", "delta"),
+        &AgentStore::begin_step
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("finish_step", "delta", "waypoints", "path_lengths"),
+        &AgentStore::finish_step
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_moving_agents", "min_speed"),
+        &AgentStore::get_moving_agents
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("compact"),
+        &AgentStore::compact
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("build_instance_buffers", "capacity", "group_dimmed", "dim_amount", "holding_scale",
+                "fake_positions", "fake_owners", "fake_holding", "fake_tint"),
+        &AgentStore::build_instance_buffers
+    );
+
+    ClassDB::bind_method(D_METHOD("get_positions"), &AgentStore::get_positions);
+    ClassDB::bind_method(D_METHOD("get_states"), &AgentStore::get_states);
+    ClassDB::bind_method(D_METHOD("get_targets"), &AgentStore::get_targets);
+    ClassDB::bind_method(D_METHOD("get_area_keys"), &AgentStore::get_area_keys);
+
+    BIND_CONSTANT(STATE_SPAWNING);
+    BIND_CONSTANT(STATE_ALIVE);
+    BIND_CONSTANT(STATE_DYING);
+    BIND_CONSTANT(STATE_REMOVED);
+}
+
+void AgentStore::configure(double p_spawn_fade_time, double p_die_fade_time, double p_unit_alpha,
+        double p_slot_reach_time, double p_min_speed, double p_max_speed) {
+    ERR_FAIL_COND_MSG(!(p_spawn_fade_time > 0.0 && p_die_fade_time > 0.0 && p_slot_reach_time > 0.0),
+            "Fade and slot reach times must be positive");
+    spawn_fade_time = p_spawn_fade_time;
+    die_fade_time = p_die_fade_time;
+    unit_alpha = p_unit_alpha;
+    slot_reach_time = p_slot_reach_time;
+    min_speed = p_min_speed;
+    max_speed = p_max_speed;
+}
+
+// ---------------------------------------------------------------------------
+// Areas, groups and owners
+// ---------------------------------------------------------------------------
+
+void AgentStore::set_area(int64_t key, const PackedVector2Array &polygon, const Array &offsets) {
+    AreaShape &area = areas[key];
+    area.polygon.assign(polygon.ptr(), polygon.ptr() + polygon.size());
+    for (size_t i = 0; i < area.polygon.size(); i++) {
+        const Vector2 &p = area.polygon[i];
+        area.bounds_min = i == 0 ? p : area.bounds_min.min(p);
+        area.bounds_max = i == 0 ? p : area.bounds_max.max(p);
+    }
+
+    area.offset_points.clear();
+    area.ring_start.assign(1, 0);
+    for (int r = 0; r < offsets.size(); r++) {
+        PackedVector2Array ring = offsets[r];
+        area.offset_points.insert(area.offset_points.end(), ring.ptr(), ring.ptr() + ring.size());
+        area.ring_start.push_back(static_cast<int>(area.offset_points.size()));
+    }
+}
+
+void AgentStore::remove_area(int64_t key) {
+    areas.erase(key);
+}
+
+void AgentStore::set_area_strengths(const PackedInt64Array &keys, const PackedFloat32Array &strengths) {
+    ERR_FAIL_COND_MSG(strengths.size() != keys.size(), "One strength per area key is required");
+    for (int64_t k = 0; k < keys.size(); k++) {
+        auto it = areas.find(keys[k]);
+        if (it != areas.end()) {
+            it->second.strength = strengths[k];
+        }
+    }
+}
+
+void AgentStore::set_group_rates(const PackedFloat32Array &rates) {
+    group_rates.assign(rates.ptr(), rates.ptr() + rates.size());
+}
+
+void AgentStore::set_owner_tints(const PackedColorArray &tints) {
+    owner_tints = tints;
+}
+
+// ---------------------------------------------------------------------------
+// Agents
+// ---------------------------------------------------------------------------
+
+void AgentStore::resize_agents(int n) {
+    positions.resize(n);
+    velocities.resize(n);
+    alphas.resize(n);
+    states.resize(n);
+    slots.resize(n);
+    area_keys.resize(n);
+    owners.resize(n);
+    groups.resize(n);
+    holding.resize(n);
+    targets.resize(n);
+    stepped.resize(n);
+    navigating.resize(n);
+    expansion_speeds.resize(n);
+}
+
+int AgentStore::add_agent(const Vector2 &position, int64_t area_key, int owner_id) {
+    const int i = get_count();
+    resize_agents(i + 1);
+    positions.set(i, position);
+    velocities.set(i, Vector2());
+    alphas.set(i, 0.0f);
+    states.set(i, STATE_SPAWNING);
+    slots.set(i, Vector2());
+    area_keys.set(i, area_key);
+    owners[i] = owner_id;
+    groups[i] = -1;
+    holding[i] = 0;
+    targets.set(i, Vector2());
+    stepped[i] = 0;
+    navigating[i] = 0;
+    expansion_speeds[i] = -1.0f;
+    return i;
+}
+
+PackedInt32Array AgentStore::kill_in_area(int64_t area_key, int count) {
+    PackedInt32Array result;
+    int32_t *state = states.ptrw();
+    const int64_t *area_key_of = area_keys.ptr();
+    for (int i = 0; i < get_count() && result.size() < count; i++) {
+        if (area_key_of[i] == area_key && state[i] == STATE_ALIVE) {
+            state[i] = STATE_DYING;
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+PackedInt32Array AgentStore::kill_area(int64_t area_key) {
+    PackedInt32Array result;
+    int32_t *state = states.ptrw();
+    const int64_t *area_key_of = area_keys.ptr();
+    for (int i = 0; i < get_count(); i++) {
+        if (area_key_of[i] == area_key && state[i] != STATE_DYING && state[i] != STATE_REMOVED) {
+            state[i] = STATE_DYING;
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+void AgentStore::clear() {
+    resize_agents(0);
+}
+
+void AgentStore::set_assignments(const PackedInt32Array &indices, const PackedVector2Array &p_slots,
+        const PackedInt32Array &p_groups, const PackedByteArray &p_holding) {
+    const int64_t m = indices.size();
+    ERR_FAIL_COND_MSG(p_slots.size() != m || p_groups.size() != m || p_holding.size() != m,
+            "Assignment arrays must all have one entry per index");
+    Vector2 *slot = slots.ptrw();
+    for (int64_t k = 0; k < m; k++) {
+        const int i = indices[k];
+        ERR_CONTINUE_MSG(i < 0 || i >= get_count(), vformat("Agent index %d is out of range", i));
+        slot[i] = p_slots[k];
+        groups[i] = p_groups[k];
+        holding[i] = p_holding[k] != 0;
+    }
+}
+
+void AgentStore::set_groups(const PackedInt32Array &indices, const PackedInt32Array &p_groups) {
+    ERR_FAIL_COND_MSG(p_groups.size() != indices.size(), "One group per index is required");
+    for (int64_t k = 0; k < indices.size(); k++) {
+        const int i = indices[k];
+        ERR_CONTINUE_MSG(i < 0 || i >= get_count(), vformat("Agent index %d is out of range", i));
+        groups[i] = p_groups[k];
+    }
+}
+
+void AgentStore::clear_groups() {
+    std::fill(groups.begin(), groups.end(), -1);
+}
+
+int AgentStore::get_count() const {
+    return static_cast<int>(positions.size());
+}
+
+// ---------------------------------------------------------------------------
+// Stepping
+// ---------------------------------------------------------------------------
+
+// Closest point on any offset ring (UnitLayer.get_closest_point_to_offset),
+// Vector2() when the area has no rings
+Vector2 AgentStore::closest_offset_point(const AreaShape &area, const Vector2 &point) const {
+    Vector2 closest;
+    real_t min_distance_squared = INFINITY;
+    for (size_t r = 0; r + 1 < area.ring_start.size(); r++) {
+        const int start = area.ring_start[r];
+        const int count = area.ring_start[r + 1] - start;
+        real_t distance_squared = 0.0f;
+        const Vector2 clamped = closest_point_on_ring(area.offset_points.data() + start, count, point, &distance_squared);
+        if (distance_squared < min_distance_squared) {
+            min_distance_squared = distance_squared;
+            closest = clamped;
+        }
+    }
+    return closest;
+}
+
+PackedInt32Array AgentStore::begin_step(double delta) {
+    PackedInt32Array result;
+    const int n = get_count();
+    Vector2 *pos = positions.ptrw();
+    float *alpha = alphas.ptrw();
+    int32_t *state = states.ptrw();
+    Vector2 *target = targets.ptrw();
+    const Vector2 *slot = slots.ptr();
+    const int64_t *area_key = area_keys.ptr();
+
+    for (int i = 0; i < n; i++) {
+        stepped[i] = 0;
+        navigating[i] = 0;
+        expansion_speeds[i] = -1.0f;
+        if (state[i] == STATE_SPAWNING) {
+            alpha[i] += static_cast<float>(delta / spawn_fade_time);
+            if (alpha[i] >= unit_alpha) {
+                alpha[i] = static_cast<float>(unit_alpha);
+                state[i] = STATE_ALIVE;
+            }
+        } else if (state[i] == STATE_DYING) {
+            alpha[i] -= static_cast<float>(delta / die_fade_time);
+            if (alpha[i] <= 0.0f) {
+                alpha[i] = 0.0f;
+                state[i] = STATE_REMOVED;
+            }
+        }
+        if (state[i] == STATE_REMOVED) continue;
+
+        auto it = areas.find(area_key[i]);
+        if (it == areas.end()) continue;
+        const AreaShape &area = it->second;
+        const int count = static_cast<int>(area.polygon.size());
+        if (count <= 2) continue;
+        stepped[i] = 1;
+
+        if (!polygon_contains_point(area.polygon.data(), count, area.bounds_min, area.bounds_max, pos[i])) {
+            pos[i] = closest_point_on_ring(area.polygon.data(), count, pos[i]);
+        }
+        if (state[i] == STATE_DYING) continue;
+
+        // Only offensive lines get the expansion speed boost
+        const int group = groups[i];
+        if (!holding[i] && group >= 0 && group < static_cast<int>(group_rates.size()) && group_rates[group] >= 0.0f) {
+            expansion_speeds[i] = group_rates[group] * area.strength;
+        }
+
+        target[i] = closest_offset_point(area, slot[i]);
+        navigating[i] = 1;
+        result.push_back(i);
+    }
+    return result;
+}
+
+void AgentStore::finish_step(double delta, const PackedVector2Array &waypoints, const PackedFloat32Array &path_lengths) {
+    const int n = get_count();
+    ERR_FAIL_COND_MSG(waypoints.size() != n || path_lengths.size() != n,
+            "Waypoints and path lengths must have one entry per agent");
+
+    Vector2 *pos = positions.ptrw();
+    Vector2 *vel = velocities.ptrw();
+    const Vector2 *waypoint = waypoints.ptr();
+    const float *path_length = path_lengths.ptr();
+
+    for (int i = 0; i < n; i++) {
+        if (!stepped[i]) continue;
+        if (navigating[i]) {
+            const double dist = path_length[i];
+            if (std::isnan(dist)) {
+                // No navigation region yet, keep the velocity
+            } else if (dist < 0.0) {
+                vel[i] = Vector2();
+            } else {
+                double desired = dist / slot_reach_time;
+                const double es = expansion_speeds[i];
+                if (es >= 0.0) {
+                    desired = std::max(desired, es * (std::sqrt(dist + 1.0) - 1.0));
+                    desired = std::max(desired, 0.05 * es * dist);
+                }
+                desired = std::max(std::min(max_speed, desired), min_speed);
+                vel[i] = (waypoint[i] - pos[i]).normalized() * static_cast<real_t>(desired);
+            }
+            if (vel[i].length() > max_speed) {
+                vel[i] = vel[i].normalized() * static_cast<real_t>(max_speed);
+            }
+        }
+        pos[i] += vel[i] * static_cast<real_t>(delta);
+    }
+}
+
+PackedInt32Array AgentStore::get_moving_agents(double min_speed_for_trail) const {
+    PackedInt32Array result;
+    const int32_t *state = states.ptr();
+    const Vector2 *vel = velocities.ptr();
+    for (int i = 0; i < get_count(); i++) {
+        if (stepped[i] && state[i] != STATE_DYING && vel[i].length() >= min_speed_for_trail) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+PackedInt32Array AgentStore::compact() {
+    int n = get_count();
+    PackedInt32Array origin;
+    origin.resize(n);
+    int32_t *from = origin.ptrw();
+    for (int i = 0; i < n; i++) {
+        from[i] = i;
+    }
+
+    Vector2 *pos = positions.ptrw();
+    Vector2 *vel = velocities.ptrw();
+    float *alpha = alphas.ptrw();
+    int32_t *state = states.ptrw();
+    Vector2 *slot = slots.ptrw();
+    int64_t *area_key = area_keys.ptrw();
+    Vector2 *target = targets.ptrw();
+
+    int i = 0;
+    while (i < n) {
+        if (state[i] != STATE_REMOVED) {
+            i++;
+            continue;
+        }
+        const int last = --n;
+        from[i] = from[last];
+        pos[i] = pos[last];
+        vel[i] = vel[last];
+        alpha[i] = alpha[last];
+        state[i] = state[last];
+        slot[i] = slot[last];
+        area_key[i] = area_key[last];
+        owners[i] = owners[last];
+        groups[i] = groups[last];
+        holding[i] = holding[last];
+        target[i] = target[last];
+        stepped[i] = stepped[last];
+        navigating[i] = navigating[last];
+        expansion_speeds[i] = expansion_speeds[last];
+    }
+
+    origin.resize(n);
+    resize_agents(n);
+    return origin;
+}
+
+// ---------------------------------------------------------------------------
+// Drawing
+// ---------------------------------------------------------------------------
+
+Array AgentStore::build_instance_buffers(int capacity, const PackedByteArray &group_dimmed, double dim_amount,
+        double holding_scale, const PackedVector2Array &fake_positions, const PackedInt32Array &fake_owners,
+        const PackedByteArray &fake_holding, const Color &fake_tint) const {
+    Array result;
+    ERR_FAIL_COND_V_MSG(capacity < 0, result, "Instance capacity must not be negative");
+    ERR_FAIL_COND_V_MSG(fake_owners.size() != fake_positions.size() || fake_holding.size() != fake_positions.size(),
+            result, "Fake arrays must all have one entry per fake agent");
+
+    // Transform2D columns x, y and origin as the MultiMesh stores them, then
+    // the color
+    constexpr int STRIDE = 12;
+    PackedFloat32Array buffers[2];
+    int used[2] = { 0, 0 };
+    for (PackedFloat32Array &buffer : buffers) {
+        buffer.resize(static_cast<int64_t>(capacity) * STRIDE);
+        std::fill(buffer.ptrw(), buffer.ptrw() + buffer.size(), 0.0f);
+    }
+
+    auto write = [&](const Vector2 &pos, const Color &tint, float alpha, int owner_id, bool is_holding) {
+        const int side = owner_id == 0 ? 0 : 1;
+        if (used[side] >= capacity) return;
+        const float scale = is_holding ? static_cast<float>(holding_scale) : 1.0f;
+        float *out = buffers[side].ptrw() + static_cast<int64_t>(used[side]++) * STRIDE;
+        out[0] = scale;
+        out[1] = 0.0f;
+        out[2] = 0.0f;
+        out[3] = pos.x;
+        out[4] = 0.0f;
+        out[5] = scale;
+        out[6] = 0.0f;
+        out[7] = pos.y;
+        out[8] = tint.r;
+        out[9] = tint.g;
+        out[10] = tint.b;
+        out[11] = alpha;
+    };
+
+    for (int64_t k = 0; k < fake_positions.size(); k++) {
+        write(fake_positions[k], fake_tint, fake_tint.a, fake_owners[k], fake_holding[k] != 0);
+    }
+
+    const float shade = static_cast<float>(1.0 - dim_amount);
+    const Vector2 *pos = positions.ptr();
+    const float *alpha = alphas.ptr();
+    for (int i = 0; i < get_count(); i++) {
+        if (!(alpha[i] > 0.01f)) continue;
+        const int owner_id = owners[i];
+        Color tint = owner_id >= 0 && owner_id < owner_tints.size() ? owner_tints[owner_id] : Color(1, 1, 1, 1);
+        const int group = groups[i];
+        if (group >= 0 && group < group_dimmed.size() && group_dimmed[group]) {
+            tint.r *= shade;
+            tint.g *= shade;
+            tint.b *= shade;
+        }
+        write(pos[i], tint, alpha[i], owner_id, holding[i] != 0);
+    }
+
+    result.push_back(buffers[0]);
+    result.push_back(buffers[1]);
+    return result;
+}
+
+PackedVector2Array AgentStore::get_positions() const {
+    return positions;
+}
+
+PackedInt32Array AgentStore::get_states() const {
+    return states;
+}
+
+PackedVector2Array AgentStore::get_targets() const {
+    return targets;
+}
+
+PackedInt64Array AgentStore::get_area_keys() const {
+    return area_keys;
+}
@@ -0,0 +1,150 @@
+#ifndef AGENT_STORE_H
+#define AGENT_STORE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+// Structure-of-arrays agent state for UnitLayer, kept across ticks, and its
+// per-tick integration. Agent k is UnitLayer._agents[k]; the GDScript side
+// only spawns, kills and assigns slots and groups. States are UnitLayer.State
+// values (0 spawning, 1 alive, 2 dying); an agent whose fade-out ended
+// becomes STATE_REMOVED until compact() drops it.
+//
+// Areas are keyed by polygon_id and uploaded when their polygon changes.
+// Groups are small indices into the group rate table (the unit-strength
+// expansion speed of each original area), -1 for none.
+//
+// A tick is begin_step (fades, containment, navigation targets), the caller's
+// path queries for the listed agents, then finish_step (speed model and
+// movement).
+class AgentStore : public RefCounted {
+    GDCLASS(AgentStore, RefCounted);
+
+public:
+    static constexpr int STATE_SPAWNING = 0;
+    static constexpr int STATE_ALIVE = 1;
+    static constexpr int STATE_DYING = 2;
+    static constexpr int STATE_REMOVED = 3;
+
+private:
+    struct AreaShape {
+        std::vector<Vector2> polygon;
+        Vector2 bounds_min;
+        Vector2 bounds_max;
+        // Offset rings, points[ring_start[r] .. ring_start[r + 1])
+        std::vector<Vector2> offset_points;
+        std::vector<int> ring_start;
+        float strength = 0.0f;
+    };
+    std::unordered_map<int64_t, AreaShape> areas;
+    std::vector<float> group_rates;
+    PackedColorArray owner_tints;
+
+    double spawn_fade_time = 0.25;
+    double die_fade_time = 0.25;
+    double unit_alpha = 1.0;
+    double slot_reach_time = 0.5;
+    double min_speed = 0.0;
+    double max_speed = 6000.0;
+
+    PackedVector2Array positions;
+    PackedVector2Array velocities;
+    PackedFloat32Array alphas;
+    PackedInt32Array states;
+    PackedVector2Array slots;
+    PackedInt64Array area_keys;
+    std::vector<int32_t> owners;
+    std::vector<int32_t> groups;
+    std::vector<uint8_t> holding;
+    PackedVector2Array targets;
+    // Per step: 1 for agents that moved (live, non-degenerate area), 1 for
+    // those routed, and the expansion speed boost (negative for none)
+    std::vector<uint8_t> stepped;
+    std::vector<uint8_t> navigating;
+    std::vector<float> expansion_speeds;
+
+    Vector2 closest_offset_point(const AreaShape &area, const Vector2 &point) const;
+    void resize_agents(int n);
+
+protected:
+    static void _bind_methods();
+
+public:
+    void configure(double p_spawn_fade_time, double p_die_fade_time, double p_unit_alpha,
+            double p_slot_reach_time, double p_min_speed, double p_max_speed);
+
+    // Replaces area key: its territory and the offset rings (Array of
+    // PackedVector2Array) slots are pulled onto
+    void set_area(int64_t key, const PackedVector2Array &polygon, const Array &offsets);
+    // Agents still in the area stop moving; kill_area them first
+    void remove_area(int64_t key);
+    // Strength density of each listed area, scaling its agents' group rates
+    void set_area_strengths(const PackedInt64Array &keys, const PackedFloat32Array &strengths);
+    // Unit-strength expansion speed per group index, negative for no boost
+    void set_group_rates(const PackedFloat32Array &rates);
+    // Instance color per owner id for build_instance_buffers
+    void set_owner_tints(const PackedColorArray &tints);
+
+    // Appends a spawning agent (transparent, no slot or group), returns its index
+    int add_agent(const Vector2 &position, int64_t area_key, int owner_id);
+    // Starts the fade-out of up to count alive agents of the area, lowest
+    // index first. Returns the agents it touched.
+    PackedInt32Array kill_in_area(int64_t area_key, int count);
+    // Starts the fade-out of every agent of the area not already dying
+    PackedInt32Array kill_area(int64_t area_key);
+    void clear();
+
+    // indices[k] gets slots[k], groups[k] and holding[k]
+    void set_assignments(const PackedInt32Array &indices, const PackedVector2Array &p_slots,
+            const PackedInt32Array &p_groups, const PackedByteArray &p_holding);
+    void set_groups(const PackedInt32Array &indices, const PackedInt32Array &p_groups);
+    void clear_groups();
+
+    int get_count() const;
+
+    // Fades, pulls agents back inside their area and clamps their slots onto
+    // the area's offset rings. Returns the agents that want a path from
+    // get_positions()[i] to get_targets()[i] inside get_area_keys()[i].
+    PackedInt32Array begin_step(double delta);
+
+    // waypoints[i] and path_lengths[i] (one entry per agent, read for the
+    // agents begin_step listed) are the next path point and the path length
+    // from the agent. A negative length stops the agent, NaN keeps its
+    // velocity (no navigation region). Agents that are not holding get a
+    // speed boost of their group rate times their area strength.
+    void finish_step(double delta, const PackedVector2Array &waypoints, const PackedFloat32Array &path_lengths);
+
+    // Agents of this step that are not dying and moved at least min_speed
+    PackedInt32Array get_moving_agents(double min_speed_for_trail) const;
+
+    // Swap-removes STATE_REMOVED agents. Result k is the index agent k had before.
+    PackedInt32Array compact();
+
+    // [friendly, enemy] MultiMesh buffers (TRANSFORM_2D with colors, 12
+    // floats per instance, capacity instances each): the fakes first, then
+    // the agents above 0.01 alpha, owner 0 in the first buffer. Agents take
+    // their owner tint, darkened by dim_amount when group_dimmed[group] is
+    // set, and holding ones are scaled by holding_scale. Unused instances
+    // are transparent.
+    Array build_instance_buffers(int capacity, const PackedByteArray &group_dimmed, double dim_amount,
+            double holding_scale, const PackedVector2Array &fake_positions, const PackedInt32Array &fake_owners,
+            const PackedByteArray &fake_holding, const Color &fake_tint) const;
+
+    PackedVector2Array get_positions() const;
+    PackedInt32Array get_states() const;
+    PackedVector2Array get_targets() const;
+    PackedInt64Array get_area_keys() const;
+};
+
+#endif // AGENT_STORE_H
@@ -0,0 +1,273 @@
+#include "assignment_solver.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace godot;
+
+void AssignmentSolver::_bind_methods() {
+    ClassDB::bind_static_method(
+        "AssignmentSolver",
+        D_METHOD("solve", "costs", "n"),
+        &AssignmentSolver::solve
+    );
+
+    ClassDB::bind_static_method(
+        "AssignmentSolver",
+        D_METHOD("solve_groups", "costs", "sizes", "auction_min_n"),
+        &AssignmentSolver::solve_groups,
+        DEFVAL(0)
+    );
+}
+
+static bool all_finite(const float *cost, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!std::isfinite(cost[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Jonker-Volgenant
+// ---------------------------------------------------------------------------
+
+// rowsol[i] = column of row i. Column reduction and reduction transfer give
+// an optimal partial assignment with column prices v; each free row is then
+// added along a shortest augmenting path (Dijkstra on reduced costs).
+static void solve_jv(const float *cost, int n, int32_t *rowsol) {
+    const double big = std::numeric_limits<double>::max();
+    auto c = [&](int i, int j) { return static_cast<double>(cost[static_cast<size_t>(i) * n + j]); };
+
+    std::vector<int> colsol(n, -1);
+    std::vector<double> v(n);
+    std::vector<int> matches(n, 0);
+    std::fill(rowsol, rowsol + n, -1);
+
+    // Column reduction, last column first as in the original
+    for (int j = n - 1; j >= 0; j--) {
+        double min = c(0, j);
+        int imin = 0;
+        for (int i = 1; i < n; i++) {
+            if (c(i, j) < min) {
+                min = c(i, j);
+                imin = i;
+            }
+        }
+        v[j] = min;
+        if (++matches[imin] == 1) {
+            rowsol[imin] = j;
+            colsol[j] = imin;
+        }
+    }
+
+    // Reduction transfer: rows holding one column pass their slack to it
+    std::vector<int> free_rows;
+    for (int i = 0; i < n; i++) {
+        if (matches[i] == 0) {
+            free_rows.push_back(i);
+        } else if (matches[i] == 1) {
+            const int j1 = rowsol[i];
+            double min = big;
+            for (int j = 0; j < n; j++) {
+                if (j != j1) {
+                    min = std::min(min, c(i, j) - v[j]);
+                }
+            }
+            if (min < big) {
+                v[j1] -= min;
+            }
+        }
+    }
+
+    std::vector<double> d(n);
+    std::vector<int> pred(n);
+    std::vector<int> collist(n);
+    for (int freerow : free_rows) {
+        for (int j = 0; j < n; j++) {
+            d[j] = c(freerow, j) - v[j];
+            pred[j] = freerow;
+            collist[j] = j;
+        }
+        // collist[0 .. low) are scanned, [low .. up) are at the current
+        // minimum distance, [up .. n) are still to do
+        int low = 0;
+        int up = 0;
+        int last = 0;
+        int endofpath = -1;
+        double min = 0.0;
+        while (endofpath < 0) {
+            if (up == low) {
+                last = low - 1;
+                min = d[collist[up++]];
+                for (int k = up; k < n; k++) {
+                    const int j = collist[k];
+                    const double h = d[j];
+                    if (h <= min) {
+                        if (h < min) {
+                            up = low;
+                            min = h;
+                        }
+                        collist[k] = collist[up];
+                        collist[up++] = j;
+                    }
+                }
+                for (int k = low; k < up; k++) {
+                    if (colsol[collist[k]] < 0) {
+                        endofpath = collist[k];
+                        break;
+                    }
+                }
+            }
+            if (endofpath < 0) {
+                const int j1 = collist[low++];
+                const int i = colsol[j1];
+                const double h = c(i, j1) - v[j1] - min;
+                for (int k = up; k < n; k++) {
+                    const int j = collist[k];
+                    const double v2 = c(i, j) - v[j] - h;
+                    if (v2 < d[j]) {
+                        pred[j] = i;
+                        if (v2 == min) {
+                            if (colsol[j] < 0) {
+                                endofpath = j;
+                                break;
+                            }
+                            collist[k] = collist[up];
+                            collist[up++] = j;
+                        }
+                        d[j] = v2;
+                    }
+                }
+            }
+        }
+
+        // Price update of the scanned columns, then flip the path
+        for (int k = 0; k <= last; k++) {
+            const int j1 = collist[k];
+            v[j1] += d[j1] - min;
+        }
+        int i;
+        do {
+            i = pred[endofpath];
+            colsol[endofpath] = i;
+            const int j1 = endofpath;
+            endofpath = rowsol[i];
+            rowsol[i] = j1;
+        } while (i != freerow);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Auction
+// ---------------------------------------------------------------------------
+
+// Gauss-Seidel forward auction on benefits -cost with epsilon scaling. The
+// final epsilon keeps the total within 1e-6 of the widest row range of the
+// optimum; rows of equal costs (padding rows) do not widen it.
+static void solve_auction(const float *cost, int n, int32_t *rowsol) {
+    auto c = [&](int i, int j) { return static_cast<double>(cost[static_cast<size_t>(i) * n + j]); };
+
+    double range = 0.0;
+    for (int i = 0; i < n; i++) {
+        const float *row = cost + static_cast<size_t>(i) * n;
+        const auto bounds = std::minmax_element(row, row + n);
+        range = std::max(range, static_cast<double>(*bounds.second) - *bounds.first);
+    }
+    std::fill(rowsol, rowsol + n, -1);
+    if (n == 1 || range == 0.0) {
+        for (int i = 0; i < n; i++) {
+            rowsol[i] = i;
+        }
+        return;
+    }
+
+    const double final_eps = range * 1e-6 / n;
+    std::vector<double> price(n, 0.0);
+    std::vector<int> owner(n, -1);
+    std::vector<int> unassigned;
+    unassigned.reserve(n);
+    for (double eps = range * 0.25;; eps = std::max(final_eps, eps * 0.2)) {
+        std::fill(owner.begin(), owner.end(), -1);
+        std::fill(rowsol, rowsol + n, -1);
+        unassigned.clear();
+        for (int i = n - 1; i >= 0; i--) {
+            unassigned.push_back(i);
+        }
+        while (!unassigned.empty()) {
+            const int i = unassigned.back();
+            unassigned.pop_back();
+            double best = -std::numeric_limits<double>::max();
+            double second = best;
+            int best_j = 0;
+            for (int j = 0; j < n; j++) {
+                const double value = -c(i, j) - price[j];
+                if (value > best) {
+                    second = best;
+                    best = value;
+                    best_j = j;
+                } else if (value > second) {
+                    second = value;
+                }
+            }
+            price[best_j] += best - second + eps;
+            if (owner[best_j] >= 0) {
+                rowsol[owner[best_j]] = -1;
+                unassigned.push_back(owner[best_j]);
+            }
+            owner[best_j] = i;
+            rowsol[i] = best_j;
+        }
+        if (eps <= final_eps) {
+            break;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------
+
+PackedInt32Array AssignmentSolver::solve(const PackedFloat32Array &costs, int n) {
+    PackedInt32Array result;
+    ERR_FAIL_COND_V_MSG(n <= 0, result, "Cost matrix must not be empty");
+    ERR_FAIL_COND_V_MSG(costs.size() != static_cast<int64_t>(n) * n, result, "Cost matrix must be square");
+    ERR_FAIL_COND_V_MSG(!all_finite(costs.ptr(), costs.size()), result,
+            "Cost matrix must contain only finite values (not NaN or INF)");
+    result.resize(n);
+    solve_jv(costs.ptr(), n, result.ptrw());
+    return result;
+}
+
+PackedInt32Array AssignmentSolver::solve_groups(const PackedFloat32Array &costs, const PackedInt32Array &sizes, int auction_min_n) {
+    PackedInt32Array result;
+    int64_t rows = 0;
+    int64_t entries = 0;
+    for (int g = 0; g < sizes.size(); g++) {
+        ERR_FAIL_COND_V_MSG(sizes[g] < 0, result, "Group sizes must not be negative");
+        rows += sizes[g];
+        entries += static_cast<int64_t>(sizes[g]) * sizes[g];
+    }
+    ERR_FAIL_COND_V_MSG(costs.size() != entries, result, "Costs must hold one square matrix per group");
+    ERR_FAIL_COND_V_MSG(!all_finite(costs.ptr(), costs.size()), result,
+            "Cost matrix must contain only finite values (not NaN or INF)");
+
+    result.resize(rows);
+    const float *cost = costs.ptr();
+    int32_t *out = result.ptrw();
+    for (int g = 0; g < sizes.size(); g++) {
+        const int n = sizes[g];
+        if (n == 0) continue;
+        if (auction_min_n > 0 && n >= auction_min_n) {
+            solve_auction(cost, n, out);
+        } else {
+            solve_jv(cost, n, out);
+        }
+        cost += static_cast<size_t>(n) * n;
+        out += n;
+    }
+    return result;
+}
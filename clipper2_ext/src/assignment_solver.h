@@ -0,0 +1,31 @@
+#ifndef ASSIGNMENT_SOLVER_H
+#define ASSIGNMENT_SOLVER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+using namespace godot;
+
+// Linear assignment (square, minimum cost) for unit slot assignment.
+// Cost matrices are row-major n * n blocks of a flat array; the result maps
+// every row to its column.
+class AssignmentSolver : public RefCounted {
+    GDCLASS(AssignmentSolver, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Optimal assignment of one matrix (Jonker-Volgenant shortest
+    // augmenting paths after column reduction)
+    static PackedInt32Array solve(const PackedFloat32Array &costs, int n);
+
+    // Independent matrices back to back, sizes[g] rows each; the result
+    // holds each group's columns (0 .. sizes[g]) at its row offset. Groups
+    // of at least auction_min_n rows (when > 0) use the epsilon-scaling
+    // auction instead, optimal to within 1e-6 of the widest row's cost range.
+    static PackedInt32Array solve_groups(const PackedFloat32Array &costs, const PackedInt32Array &sizes, int auction_min_n = 0);
+};
+
+#endif // ASSIGNMENT_SOLVER_H
@@ -0,0 +1,107 @@
+#include "bounds_grid.h"
+#include "path_convert.h"
+#include <algorithm>
+#include <cmath>
+
+// Cap so a few huge items cannot blow up the cell count
+static const int MAX_GRID_CELLS_PER_AXIS = 1024;
+
+void BoundsGrid::clear() {
+    item_bounds.clear();
+    cell_start.clear();
+    cell_items.clear();
+    cols = 0;
+    rows = 0;
+}
+
+void BoundsGrid::build(const std::vector<Clipper2Lib::RectD> &bounds) {
+    clear();
+    item_bounds = bounds;
+    if (item_bounds.empty()) {
+        return;
+    }
+
+    double left = item_bounds[0].left, top = item_bounds[0].top;
+    double right = item_bounds[0].right, bottom = item_bounds[0].bottom;
+    double size_sum = 0.0;
+    for (const auto &b : item_bounds) {
+        left = std::min(left, b.left);
+        top = std::min(top, b.top);
+        right = std::max(right, b.right);
+        bottom = std::max(bottom, b.bottom);
+        size_sum += std::max(b.right - b.left, b.bottom - b.top);
+    }
+
+    // Cells about the size of an average item keep both cell count and duplicates low
+    cell_size = std::max(size_sum / item_bounds.size(), 1e-6);
+    double extent = std::max(right - left, bottom - top);
+    if (extent / cell_size > MAX_GRID_CELLS_PER_AXIS) {
+        cell_size = extent / MAX_GRID_CELLS_PER_AXIS;
+    }
+    origin_x = left;
+    origin_y = top;
+    cols = std::max(1, static_cast<int>(std::ceil((right - left) / cell_size)) + 1);
+    rows = std::max(1, static_cast<int>(std::ceil((bottom - top) / cell_size)) + 1);
+    cols = std::min(cols, MAX_GRID_CELLS_PER_AXIS + 1);
+    rows = std::min(rows, MAX_GRID_CELLS_PER_AXIS + 1);
+
+    // Counting pass, then fill
+    std::vector<int> counts(static_cast<size_t>(cols) * rows + 1, 0);
+    for (const auto &b : item_bounds) {
+        int x0, y0, x1, y1;
+        cell_range(b, x0, y0, x1, y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                counts[static_cast<size_t>(y) * cols + x + 1]++;
+            }
+        }
+    }
+    for (size_t c = 1; c < counts.size(); c++) {
+        counts[c] += counts[c - 1];
+    }
+    cell_start = counts;
+    cell_items.resize(cell_start.back());
+    for (size_t i = 0; i < item_bounds.size(); i++) {
+        int x0, y0, x1, y1;
+        cell_range(item_bounds[i], x0, y0, x1, y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                cell_items[counts[static_cast<size_t>(y) * cols + x]++] = static_cast<int>(i);
+            }
+        }
+    }
+}
+
+void BoundsGrid::cell_range(const Clipper2Lib::RectD &rect, int &x0, int &y0, int &x1, int &y1) const {
+    auto to_cell = [this](double v, double origin, int count) {
+        int c = static_cast<int>(std::floor((v - origin) / cell_size));
+        return std::clamp(c, 0, count - 1);
+    };
+    x0 = to_cell(rect.left, origin_x, cols);
+    x1 = to_cell(rect.right, origin_x, cols);
+    y0 = to_cell(rect.top, origin_y, rows);
+    y1 = to_cell(rect.bottom, origin_y, rows);
+}
+
+void BoundsGrid::query(const Clipper2Lib::RectD &rect, std::vector<int> &out) const {
+    if (item_bounds.empty()) {
+        return;
+    }
+    size_t first = out.size();
+    int x0, y0, x1, y1;
+    cell_range(rect, x0, y0, x1, y1);
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            size_t c = static_cast<size_t>(y) * cols + x;
+            for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                int item = cell_items[k];
+                if (bounds_overlap(item_bounds[item], rect)) {
+                    out.push_back(item);
+                }
+            }
+        }
+    }
+    // Items spanning several cells show up more than once
+    std::sort(out.begin() + first, out.end());
+    out.erase(std::unique(out.begin() + first, out.end()), out.end());
+}
@@ -0,0 +1,33 @@
+#ifndef BOUNDS_GRID_H
+#define BOUNDS_GRID_H
+
+#include <vector>
+#include "clipper2/clipper.h"
+
+// Uniform grid over a fixed set of bounding boxes (broadphase).
+// Every item is stored in each cell its bounds touch; queries are read-only
+// and safe to run from several threads at once.
+class BoundsGrid {
+public:
+    void build(const std::vector<Clipper2Lib::RectD> &bounds);
+    void clear();
+    bool is_empty() const { return item_bounds.empty(); }
+
+    // Appends the indices whose bounds overlap rect (touching counts), ascending and unique
+    void query(const Clipper2Lib::RectD &rect, std::vector<int> &out) const;
+
+private:
+    void cell_range(const Clipper2Lib::RectD &rect, int &x0, int &y0, int &x1, int &y1) const;
+
+    std::vector<Clipper2Lib::RectD> item_bounds;
+    double origin_x = 0.0;
+    double origin_y = 0.0;
+    double cell_size = 1.0;
+    int cols = 0;
+    int rows = 0;
+    // CSR layout: items of cell c are cell_items[cell_start[c] .. cell_start[c + 1])
+    std::vector<int> cell_start;
+    std::vector<int> cell_items;
+};
+
+#endif // BOUNDS_GRID_H
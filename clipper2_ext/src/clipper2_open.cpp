@@ -2,8 +2,13 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/classes/geometry2d.hpp>
 #include <cmath>
+#include <deque>
+#include <functional>
 #include <vector>
+#include <type_traits>
+#include <utility>
 #include "clipper2/clipper.h"
+#include "path_convert.h"
 
 using namespace godot;
 
@@ -25,6 +30,16 @@ void Clipper2Open::_bind_methods() {
         &Clipper2Open::intersect_polygons_batched
     );
 
+    ClassDB::bind_method(
+        D_METHOD("intersect_polygons_batched_tree", "polygons", "subject_polygon"),
+        &Clipper2Open::intersect_polygons_batched_tree
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("boolean_polygons_tree", "subject_polygons", "clip_polygons", "operation"),
+        &Clipper2Open::boolean_polygons_tree
+    );
+
     ClassDB::bind_method(
         D_METHOD("intersect_many_polylines_with_polygons", "polylines", "polygons"),
         &Clipper2Open::intersect_many_polylines_with_polygons
@@ -39,6 +54,184 @@ void Clipper2Open::_bind_methods() {
         D_METHOD("intersect_many_ringpolylines_with_polygons", "polylines", "polygons"),
         &Clipper2Open::intersect_many_ringpolylines_with_polygons
     );
+
+    ClassDB::bind_method(
+        D_METHOD("register_polygons", "polygons"),
+        &Clipper2Open::register_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("register_obstacles", "obstacles", "keep_rect"),
+        &Clipper2Open::register_obstacles,
+        DEFVAL(Rect2())
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("subtract_registered_obstacles_batched", "polygons", "handle"),
+        &Clipper2Open::subtract_registered_obstacles_batched
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("unregister_polygons", "handle"),
+        &Clipper2Open::unregister_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear_registered_polygons"),
+        &Clipper2Open::clear_registered_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_registered_polygon_count", "handle"),
+        &Clipper2Open::get_registered_polygon_count
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_registered_polygon_bounds", "handle", "index"),
+        &Clipper2Open::get_registered_polygon_bounds
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_registered_polygons_batched", "handle", "indices", "subject_polygon"),
+        &Clipper2Open::intersect_registered_polygons_batched
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_registered_polygons_batched_tree", "handle", "indices", "subject_polygon"),
+        &Clipper2Open::intersect_registered_polygons_batched_tree
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_polygons_with_registered_polygons", "subject_polygons", "handle"),
+        &Clipper2Open::intersect_polygons_with_registered_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_polygons_with_registered_polygons_tree", "subject_polygons", "handle"),
+        &Clipper2Open::intersect_polygons_with_registered_polygons_tree
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_polylines_with_registered_polygons", "polylines", "handle", "indices"),
+        &Clipper2Open::intersect_many_polylines_with_registered_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_ringpolylines_with_registered_polygons", "polylines", "handle", "indices"),
+        &Clipper2Open::intersect_many_ringpolylines_with_registered_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("difference_many_polylines_with_registered_polygons", "polylines", "handle"),
+        &Clipper2Open::difference_many_polylines_with_registered_polygons
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("collect_offset_overlaps", "polygons", "group_ids", "delta", "measure_polygons", "measure_group", "arc_tolerance"),
+        &Clipper2Open::collect_offset_overlaps,
+        DEFVAL(-1),
+        DEFVAL(0.25)
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_parallel", "enabled", "thread_count"),
+        &Clipper2Open::set_parallel,
+        DEFVAL(0)
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("is_parallel"),
+        &Clipper2Open::is_parallel
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_parallel_thread_count"),
+        &Clipper2Open::get_parallel_thread_count
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_fixed_point", "enabled", "scale"),
+        &Clipper2Open::set_fixed_point,
+        DEFVAL(100.0)
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("is_fixed_point"),
+        &Clipper2Open::is_fixed_point
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_fixed_point_scale"),
+        &Clipper2Open::get_fixed_point_scale
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_polyline_with_polygon_deterministic_flat", "points", "ring_offsets", "group_ids", "polygon", "epsilon"),
+        &Clipper2Open::intersect_many_polyline_with_polygon_deterministic_flat,
+        DEFVAL(0.0)
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_polygons_batched_flat", "points", "ring_offsets", "group_ids", "subject_polygon"),
+        &Clipper2Open::intersect_polygons_batched_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_polylines_with_polygons_flat", "line_points", "line_offsets", "polygon_points", "polygon_offsets", "polygon_group_ids"),
+        &Clipper2Open::intersect_many_polylines_with_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_ringpolylines_with_polygons_flat", "line_points", "line_offsets", "polygon_points", "polygon_offsets", "polygon_group_ids"),
+        &Clipper2Open::intersect_many_ringpolylines_with_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("difference_many_polylines_with_polygons_flat", "line_points", "line_offsets", "polygon_points", "polygon_offsets"),
+        &Clipper2Open::difference_many_polylines_with_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_registered_polygons_batched_flat", "handle", "indices", "subject_polygon"),
+        &Clipper2Open::intersect_registered_polygons_batched_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_polygons_with_registered_polygons_flat", "points", "ring_offsets", "group_ids", "handle"),
+        &Clipper2Open::intersect_polygons_with_registered_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_polylines_with_registered_polygons_flat", "line_points", "line_offsets", "handle", "indices"),
+        &Clipper2Open::intersect_many_polylines_with_registered_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("intersect_many_ringpolylines_with_registered_polygons_flat", "line_points", "line_offsets", "handle", "indices"),
+        &Clipper2Open::intersect_many_ringpolylines_with_registered_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("difference_many_polylines_with_registered_polygons_flat", "line_points", "line_offsets", "handle"),
+        &Clipper2Open::difference_many_polylines_with_registered_polygons_flat
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("union_polygons_by_component", "polygons"),
+        &Clipper2Open::union_polygons_by_component
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("offset_polygons_batched", "polygons", "deltas", "join_type", "arc_tolerance", "miter_limit"),
+        &Clipper2Open::offset_polygons_batched,
+        DEFVAL(0), DEFVAL(0.25), DEFVAL(2.0)
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("offset_polylines_batched", "polylines", "deltas", "join_type", "end_type", "arc_tolerance", "miter_limit"),
+        &Clipper2Open::offset_polylines_batched,
+        DEFVAL(0), DEFVAL(3), DEFVAL(0.25), DEFVAL(2.0)
+    );
 }
 
 // Utility: assert no consecutive identical points
@@ -53,6 +246,17 @@ static void assert_no_identical_points(const PackedVector2Array &points, const c
     }
 }
 
+// Utility: run independent jobs on the pool, or inline when parallel mode is off
+static void run_jobs(WorkerPool *pool, size_t job_count, const std::function<void(size_t)> &job) {
+    if (pool != nullptr) {
+        pool->run(job_count, job);
+        return;
+    }
+    for (size_t i = 0; i < job_count; i++) {
+        job(i);
+    }
+}
+
 static bool overlap_segment(const Vector2 &a, const Vector2 &b,
     const Vector2 &c, const Vector2 &d,
     double eps,
@@ -94,76 +298,215 @@ std::swap(out1, out2);
 return true;
 }
 
-// --- Single polyline version ---
-Array Clipper2Open::intersect_polyline_with_polygon_deterministic(
-    const PackedVector2Array &polyline,
-    const PackedVector2Array &polygon,
-    double epsilon) const
-{
-    assert_no_identical_points(polyline, "polyline");
-    assert_no_identical_points(polygon, "polygon");
-
-    Array result;
-    if (polyline.size() < 2 || polygon.size() < 2) {
-        return result;
-    }
+struct OverlapEdge { Vector2 c, d; };
 
-    PackedVector2Array current_chain;
+// Below this many edges a plain scan beats the grid
+static const int EDGE_INDEX_MIN_EDGES = 32;
+// Extra slack on the query box so float rounding in overlap_segment never hides a candidate
+static const double EDGE_INDEX_MARGIN = 1e-3;
 
-    for (int i = 0; i < polyline.size() - 1; i++) {
-        Vector2 a = polyline[i];
-        Vector2 b = polyline[i + 1];
-        bool overlapped = false;
-        Vector2 o1, o2;
+// Polygon edges (including the closing one) with a grid over their bounds, so a
+// polyline segment only visits edges it can overlap. Candidates come back in
+// edge order, which keeps the first-match semantics of the plain scan.
+struct OverlapEdgeIndex {
+    std::vector<OverlapEdge> edges;
+    BoundsGrid grid;
+    bool use_grid = false;
+    double epsilon = 0.0;
 
+    OverlapEdgeIndex(const PackedVector2Array &polygon, double p_epsilon) {
+        epsilon = p_epsilon;
+        edges.reserve(polygon.size());
         for (int j = 0; j < polygon.size(); j++) {
-            Vector2 c = polygon[j];
-            Vector2 d = polygon[(j + 1) % polygon.size()];
+            edges.push_back({polygon[j], polygon[(j + 1) % polygon.size()]});
+        }
+        use_grid = static_cast<int>(edges.size()) >= EDGE_INDEX_MIN_EDGES;
+        if (use_grid) {
+            std::vector<Clipper2Lib::RectD> bounds;
+            bounds.reserve(edges.size());
+            for (const auto &edge : edges) {
+                bounds.push_back(segment_bounds(edge.c, edge.d, 0.0));
+            }
+            grid.build(bounds);
+        }
+    }
+
+    static Clipper2Lib::RectD segment_bounds(const Vector2 &a, const Vector2 &b, double grow) {
+        return Clipper2Lib::RectD(
+            std::min(a.x, b.x) - grow, std::min(a.y, b.y) - grow,
+            std::max(a.x, b.x) + grow, std::max(a.y, b.y) + grow
+        );
+    }
 
-            if (overlap_segment(a, b, c, d, epsilon, o1, o2)) {
-                overlapped = true;
-                break;
+    // First edge (in polygon order) that overlaps a-b, as overlap_segment defines it
+    bool find_overlap(const Vector2 &a, const Vector2 &b, std::vector<int> &scratch, Vector2 &o1, Vector2 &o2) const {
+        if (!use_grid) {
+            for (const auto &edge : edges) {
+                if (overlap_segment(a, b, edge.c, edge.d, epsilon, o1, o2)) {
+                    return true;
+                }
             }
+            return false;
         }
+        // Any overlap lies within epsilon of a-b, so the grown segment box finds every candidate
+        scratch.clear();
+        grid.query(segment_bounds(a, b, epsilon + EDGE_INDEX_MARGIN), scratch);
+        for (int j : scratch) {
+            if (overlap_segment(a, b, edges[j].c, edges[j].d, epsilon, o1, o2)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Helper: snap to the fixed-point grid (snap_scale <= 0 leaves the point as is)
+static Vector2 snap_to_grid(const Vector2 &v, double snap_scale) {
+    if (snap_scale <= 0.0) {
+        return v;
+    }
+    return Vector2(
+        static_cast<float>(std::round(static_cast<double>(v.x) * snap_scale) / snap_scale),
+        static_cast<float>(std::round(static_cast<double>(v.y) * snap_scale) / snap_scale)
+    );
+}
+
+// Collect the chains of polyline pieces that run along polygon edges
+static void collect_overlap_chains(
+    const Vector2 *pts,
+    int point_count,
+    const OverlapEdgeIndex &edge_index,
+    double snap_scale,
+    std::vector<std::vector<Vector2>> &chains)
+{
+    if (point_count < 2) {
+        return;
+    }
+
+    const double epsilon = edge_index.epsilon;
+    // Chains grow at both ends, a deque keeps prepending O(1)
+    std::deque<Vector2> current_chain;
+    std::vector<int> scratch;
+
+    auto flush_chain = [&]() {
+        chains.emplace_back(current_chain.begin(), current_chain.end());
+        current_chain.clear();
+    };
+
+    for (int i = 0; i < point_count - 1; i++) {
+        Vector2 a = pts[i];
+        Vector2 b = pts[i + 1];
+        Vector2 o1, o2;
+        bool overlapped = edge_index.find_overlap(a, b, scratch, o1, o2);
 
         if (overlapped) {
-            if (current_chain.size() == 0) {
-                current_chain.append(o1);
-                current_chain.append(o2);
+            o1 = snap_to_grid(o1, snap_scale);
+            o2 = snap_to_grid(o2, snap_scale);
+            if (current_chain.empty()) {
+                current_chain.push_back(o1);
+                current_chain.push_back(o2);
             } else {
-                Vector2 first = current_chain[0];
-                Vector2 last  = current_chain[current_chain.size() - 1];
+                Vector2 first = current_chain.front();
+                Vector2 last  = current_chain.back();
 
                 if (last.distance_to(o1) <= epsilon) {
-                    current_chain.append(o2);
+                    current_chain.push_back(o2);
                 } else if (last.distance_to(o2) <= epsilon) {
-                    current_chain.append(o1);
+                    current_chain.push_back(o1);
                 } else if (first.distance_to(o1) <= epsilon) {
-                    current_chain.insert(0, o2);
+                    current_chain.push_front(o2);
                 } else if (first.distance_to(o2) <= epsilon) {
-                    current_chain.insert(0, o1);
+                    current_chain.push_front(o1);
                 } else {
-                    result.append(current_chain);
-                    current_chain = PackedVector2Array();
-                    current_chain.append(o1);
-                    current_chain.append(o2);
+                    flush_chain();
+                    current_chain.push_back(o1);
+                    current_chain.push_back(o2);
                 }
             }
         } else {
-            if (current_chain.size() > 0) {
-                result.append(current_chain);
-                current_chain = PackedVector2Array();
+            if (!current_chain.empty()) {
+                flush_chain();
             }
         }
     }
 
-    if (current_chain.size() > 0) {
-        result.append(current_chain);
+    if (!current_chain.empty()) {
+        flush_chain();
     }
+}
 
+// Helper: chains back to Godot polylines
+static Array chains_to_godot(const std::vector<std::vector<Vector2>> &chains) {
+    Array result;
+    for (const auto &chain : chains) {
+        PackedVector2Array packed;
+        packed.resize(chain.size());
+        Vector2 *dst = packed.ptrw();
+        for (size_t i = 0; i < chain.size(); i++) {
+            dst[i] = chain[i];
+        }
+        result.append(packed);
+    }
     return result;
 }
 
+// Helper: chains of every polyline to the flat layout, chains of line k under ids[k]
+static Array chains_to_flat(
+    const std::vector<std::vector<std::vector<Vector2>>> &chains_per_line,
+    const std::vector<int32_t> &ids)
+{
+    int point_count = 0;
+    int ring_count = 0;
+    for (const auto &chains : chains_per_line) {
+        for (const auto &chain : chains) {
+            point_count += static_cast<int>(chain.size());
+            ring_count++;
+        }
+    }
+
+    PackedVector2Array points;
+    PackedInt32Array ring_offsets;
+    PackedInt32Array group_ids;
+    points.resize(point_count);
+    ring_offsets.resize(ring_count + 1);
+    group_ids.resize(ring_count);
+    Vector2 *dst = points.ptrw();
+    int32_t *offsets = ring_offsets.ptrw();
+    int32_t *groups = group_ids.ptrw();
+
+    int p = 0;
+    int r = 0;
+    offsets[0] = 0;
+    for (size_t k = 0; k < chains_per_line.size(); k++) {
+        for (const auto &chain : chains_per_line[k]) {
+            for (const Vector2 &v : chain) {
+                dst[p++] = v;
+            }
+            groups[r] = ids[k];
+            offsets[++r] = p;
+        }
+    }
+    return make_flat_result(points, ring_offsets, group_ids);
+}
+
+// --- Single polyline version ---
+Array Clipper2Open::intersect_polyline_with_polygon_deterministic(
+    const PackedVector2Array &polyline,
+    const PackedVector2Array &polygon,
+    double epsilon) const
+{
+    assert_no_identical_points(polyline, "polyline");
+    assert_no_identical_points(polygon, "polygon");
+
+    if (polyline.size() < 2 || polygon.size() < 2) {
+        return Array();
+    }
+
+    std::vector<std::vector<Vector2>> chains;
+    collect_overlap_chains(polyline.ptr(), polyline.size(), OverlapEdgeIndex(polygon, epsilon), get_snap_scale(), chains);
+    return chains_to_godot(chains);
+}
+
 // --- Batched version ---
 Array Clipper2Open::intersect_many_polyline_with_polygon_deterministic(
     const Array &polylines,
@@ -179,278 +522,554 @@ Array Clipper2Open::intersect_many_polyline_with_polygon_deterministic(
         return results;
     }
 
-    // Precompute polygon edges
-    struct Edge { Vector2 c, d; };
-    std::vector<Edge> edges;
-    edges.reserve(polygon.size());
-    for (int j = 0; j < polygon.size(); j++) {
-        edges.push_back({polygon[j], polygon[(j + 1) % polygon.size()]});
-    }
+    // Index polygon edges once, shared read-only by every polyline
+    OverlapEdgeIndex edge_index(polygon, epsilon);
+    double snap_scale = get_snap_scale();
 
+    // Unpack on the calling thread, workers only read packed data
+    std::vector<PackedVector2Array> lines(polylines.size());
     for (int idx = 0; idx < polylines.size(); idx++) {
-        PackedVector2Array line_in = polylines[idx];
-        Array result;
-        if (line_in.size() < 2) {
-            results[idx] = result;
-            continue;
-        }
-
-        PackedVector2Array current_chain;
-
-        for (int i = 0; i < line_in.size() - 1; i++) {
-            Vector2 a = line_in[i];
-            Vector2 b = line_in[i + 1];
-            bool overlapped = false;
-            Vector2 o1, o2;
-
-            for (const auto &edge : edges) {
-                if (overlap_segment(a, b, edge.c, edge.d, epsilon, o1, o2)) {
-                    overlapped = true;
-                    break;
-                }
-            }
-
-            if (overlapped) {
-                if (current_chain.size() == 0) {
-                    current_chain.append(o1);
-                    current_chain.append(o2);
-                } else {
-                    Vector2 first = current_chain[0];
-                    Vector2 last  = current_chain[current_chain.size() - 1];
-
-                    if (last.distance_to(o1) <= epsilon) {
-                        current_chain.append(o2);
-                    } else if (last.distance_to(o2) <= epsilon) {
-                        current_chain.append(o1);
-                    } else if (first.distance_to(o1) <= epsilon) {
-                        current_chain.insert(0, o2);
-                    } else if (first.distance_to(o2) <= epsilon) {
-                        current_chain.insert(0, o1);
-                    } else {
-                        result.append(current_chain);
-                        current_chain = PackedVector2Array();
-                        current_chain.append(o1);
-                        current_chain.append(o2);
-                    }
-                }
-            } else {
-                if (current_chain.size() > 0) {
-                    result.append(current_chain);
-                    current_chain = PackedVector2Array();
-                }
-            }
-        }
+        lines[idx] = polylines[idx];
+    }
 
-        if (current_chain.size() > 0) {
-            result.append(current_chain);
-        }
+    std::vector<std::vector<std::vector<Vector2>>> chains_per_line(lines.size());
+    run_jobs(get_pool(), lines.size(), [&](size_t idx) {
+        collect_overlap_chains(lines[idx].ptr(), lines[idx].size(), edge_index, snap_scale, chains_per_line[idx]);
+    });
 
-        results[idx] = result;
+    for (size_t idx = 0; idx < lines.size(); idx++) {
+        results[idx] = chains_to_godot(chains_per_line[idx]);
     }
 
     return results;
 }
 
-// --- True batched polygon intersection using Clipper2's native batching ---
-Array Clipper2Open::intersect_polygons_batched(
-    const Array &polygons,
-    const PackedVector2Array &subject_polygon) const
+// --- Batched version, flat layout ---
+Array Clipper2Open::intersect_many_polyline_with_polygon_deterministic_flat(
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids,
+    const PackedVector2Array &polygon,
+    double epsilon) const
 {
-    Array results;
-    results.resize(polygons.size());
-
-    if (subject_polygon.size() < 3) {
-        return results;
+    assert_no_identical_points(polygon, "polygon");
+    if (!is_valid_flat_layout(points, ring_offsets, group_ids)) {
+        return Array();
     }
 
-    // Convert subject polygon to Clipper2 format
-    Clipper2Lib::PathsD subject_paths;
-    Clipper2Lib::PathD subject_path;
-    for (int i = 0; i < subject_polygon.size(); i++) {
-        subject_path.push_back(Clipper2Lib::PointD(
-            static_cast<double>(subject_polygon[i].x),
-            static_cast<double>(subject_polygon[i].y)
-        ));
-    }
-    subject_paths.push_back(subject_path);
-
-    // Process each polygon individually but using Clipper2's optimized engine
-    for (int idx = 0; idx < polygons.size(); idx++) {
-        PackedVector2Array clip_polygon = polygons[idx];
-        Array result;
-        
-        if (clip_polygon.size() < 3) {
-            results[idx] = result;
-            continue;
-        }
+    const int line_count = flat_ring_count(ring_offsets);
+    std::vector<std::vector<std::vector<Vector2>>> chains_per_line(line_count);
+    std::vector<int32_t> ids(line_count);
+    for (int r = 0; r < line_count; r++) {
+        ids[r] = group_ids.is_empty() ? r : group_ids[r];
+    }
 
-        // Convert individual clip polygon
-        Clipper2Lib::PathsD clip_paths;
-        Clipper2Lib::PathD clip_path;
-        for (int i = 0; i < clip_polygon.size(); i++) {
-            clip_path.push_back(Clipper2Lib::PointD(
-                static_cast<double>(clip_polygon[i].x),
-                static_cast<double>(clip_polygon[i].y)
-            ));
-        }
-        clip_paths.push_back(clip_path);
+    if (polygon.size() >= 2) {
+        OverlapEdgeIndex edge_index(polygon, epsilon);
+        double snap_scale = get_snap_scale();
+        const Vector2 *src = points.ptr();
+        const int32_t *offsets = ring_offsets.ptr();
+        run_jobs(get_pool(), line_count, [&](size_t r) {
+            collect_overlap_chains(src + offsets[r], offsets[r + 1] - offsets[r], edge_index, snap_scale, chains_per_line[r]);
+        });
+    }
 
-        // Use Clipper2's native Intersect function with double precision
-        Clipper2Lib::PathsD individual_solution = Clipper2Lib::Intersect(subject_paths, clip_paths, Clipper2Lib::FillRule::NonZero, 2);
+    return chains_to_flat(chains_per_line, ids);
+}
 
-        // Convert result back to Godot format
-        for (const auto& path : individual_solution) {
-            PackedVector2Array result_polygon;
-            for (const auto& point : path) {
-                result_polygon.append(Vector2(
-                    static_cast<float>(point.x),
-                    static_cast<float>(point.y)
-                ));
-            }
-            if (result_polygon.size() >= 3) {
-                result.append(result_polygon);
-            }
-        }
+// --- Clipping mode ---
 
-        results[idx] = result;
+void Clipper2Open::set_fixed_point(bool enabled, double scale) {
+    ERR_FAIL_COND_MSG(!(scale > 0.0), "Fixed-point scale must be positive");
+    fixed_point = enabled;
+    fixed_point_scale = scale;
+    // Registered polygons keep an integer copy at the current scale
+    for (auto &entry : registry) {
+        rescale_registered(entry.second);
     }
+}
 
-    return results;
+bool Clipper2Open::is_fixed_point() const {
+    return fixed_point;
 }
 
-// Helper: convert Godot polyline (open) to Clipper2 PathD with IsOpen flag
-static Clipper2Lib::PathD to_pathd_open(const PackedVector2Array &polyline) {
-    Clipper2Lib::PathD path;
-    path.reserve(polyline.size());
-    for (int i = 0; i < polyline.size(); i++) {
-        path.push_back(Clipper2Lib::PointD(
-            static_cast<double>(polyline[i].x),
-            static_cast<double>(polyline[i].y)
-        ));
-    }
-    return path;
+double Clipper2Open::get_fixed_point_scale() const {
+    return fixed_point_scale;
 }
 
-// Open subject builder that also adds the last->first segment if input is not closed
-static Clipper2Lib::PathD to_pathd_ring_open(const PackedVector2Array &polyline) {
-    Clipper2Lib::PathD path;
-    int n = polyline.size();
-    if (n <= 0) return path;
-    path.reserve(n + 1);
-    for (int i = 0; i < n; i++) {
-        path.push_back(Clipper2Lib::PointD(
-            static_cast<double>(polyline[i].x),
-            static_cast<double>(polyline[i].y)
-        ));
-    }
-    if (!(polyline[0] == polyline[n - 1])) {
-        path.push_back(Clipper2Lib::PointD(
-            static_cast<double>(polyline[0].x),
-            static_cast<double>(polyline[0].y)
-        ));
+// Calls f with the converter of the active mode; f is generic over the path type
+template <typename F>
+auto Clipper2Open::with_active_mode(F &&f) const {
+    if (fixed_point) {
+        return f(PathConv<int64_t>{fixed_point_scale});
     }
-    return path;
+    return f(PathConv<double>{});
 }
 
-static Clipper2Lib::PathD to_pathd_closed(const PackedVector2Array &polygon) {
-    Clipper2Lib::PathD path;
-    path.reserve(polygon.size());
-    for (int i = 0; i < polygon.size(); i++) {
-        path.push_back(Clipper2Lib::PointD(
-            static_cast<double>(polygon[i].x),
-            static_cast<double>(polygon[i].y)
-        ));
+// --- Closed solutions: plain rings or outer/hole structure ---
+
+// Same values as Geometry2D.PolyBooleanOperation
+static bool to_clipper_clip_type(int operation, Clipper2Lib::ClipType &out) {
+    switch (operation) {
+        case 0: out = Clipper2Lib::ClipType::Union; return true;
+        case 1: out = Clipper2Lib::ClipType::Difference; return true;
+        case 2: out = Clipper2Lib::ClipType::Intersection; return true;
+        case 3: out = Clipper2Lib::ClipType::Xor; return true;
     }
-    return path;
+    return false;
 }
 
-// Extract open path solution polylines from Clipper2 open solution
-static Array open_solution_to_godot_flat(const Clipper2Lib::PathsD &solution) {
-    Array out;
-    for (const auto &path : solution) {
-        if (path.size() < 2) continue;
-        PackedVector2Array line;
-        for (const auto &pt : path) {
-            line.append(Vector2(
-                static_cast<float>(pt.x),
-                static_cast<float>(pt.y)
-            ));
-        }
-        out.append(line);
-    }
-    return out;
+// One closed boolean job. Cores are templated on the solution kind, either
+// Paths (rings as Clipper returns them) or RingStructure (PolyTree nesting).
+template <typename T>
+static void execute_closed(Clipper2Lib::ClipType op, const Clipper2Lib::Paths<T> &subjects, const Clipper2Lib::Paths<T> &clips, Clipper2Lib::Paths<T> &out) {
+    typename PathConv<T>::Engine c;
+    c.AddSubject(subjects);
+    c.AddClip(clips);
+    c.Execute(op, Clipper2Lib::FillRule::NonZero, out);
 }
 
-// Intersect MANY open polylines with MANY closed polygons in one run
-Array Clipper2Open::intersect_many_polylines_with_polygons(
-    const Array &polylines,
-    const Array &polygons) const
-{
-    Array grouped_results;
-    grouped_results.resize(polygons.size());
+template <typename T>
+static void execute_closed(Clipper2Lib::ClipType op, const Clipper2Lib::Paths<T> &subjects, const Clipper2Lib::Paths<T> &clips, RingStructure<T> &out) {
+    typename PathConv<T>::Engine c;
+    c.AddSubject(subjects);
+    c.AddClip(clips);
+    typename PathConv<T>::Tree tree;
+    c.Execute(op, Clipper2Lib::FillRule::NonZero, tree);
+    flatten_polytree(tree, -1, out);
+}
 
-    // Pre-convert open subjects once
-    Clipper2Lib::PathsD open_subjects;
-    for (int i = 0; i < polylines.size(); i++) {
-        PackedVector2Array line = polylines[i];
-        if (line.size() < 2) continue;
-        open_subjects.push_back(to_pathd_open(line));
-    }
-    if (open_subjects.empty()) {
-        return grouped_results;
+// Whether a solution has any ring left after dropping degenerate ones
+template <typename T>
+static bool has_closed_rings(const Clipper2Lib::Paths<T> &solution) {
+    for (const auto &path : solution) {
+        if (path.size() >= 3) return true;
     }
+    return false;
+}
 
-    for (int p = 0; p < polygons.size(); p++) {
-        PackedVector2Array poly = polygons[p];
-        Array result;
-        if (poly.size() < 3) {
-            grouped_results[p] = result;
-            continue;
-        }
-        Clipper2Lib::ClipperD c;
-        c.AddOpenSubject(open_subjects);
-        Clipper2Lib::PathsD closed_clip;
-        closed_clip.push_back(to_pathd_closed(poly));
-        c.AddClip(closed_clip);
-        Clipper2Lib::PathsD closed_solution; // unused closed output
-        Clipper2Lib::PathsD open_solution;
-        c.Execute(Clipper2Lib::ClipType::Intersection, Clipper2Lib::FillRule::NonZero, closed_solution, open_solution);
-        grouped_results[p] = open_solution_to_godot_flat(open_solution);
-    }
+template <typename T>
+static bool has_closed_rings(const RingStructure<T> &solution) {
+    return has_closed_rings(solution.outers);
+}
 
-    return grouped_results;
+template <typename T>
+static Variant closed_solution_to_variant(const PathConv<T> &conv, const Clipper2Lib::Paths<T> &solution) {
+    return closed_solution_to_godot(conv, solution);
 }
 
-// Difference (outside) of MANY open polylines with MANY closed polygons in one run
-Array Clipper2Open::difference_many_polylines_with_polygons(
-    const Array &polylines,
-    const Array &polygons) const
+template <typename T>
+static Variant closed_solution_to_variant(const PathConv<T> &conv, const RingStructure<T> &solution) {
+    return ring_structure_to_godot(conv, solution);
+}
+
+// --- Polygon x polygon ---
+
+template <typename T>
+static Clipper2Lib::Paths<T> to_closed_paths(const PathConv<T> &conv, const Array &polygons) {
+    Clipper2Lib::Paths<T> paths;
+    paths.reserve(polygons.size());
+    for (int i = 0; i < polygons.size(); i++) {
+        PackedVector2Array polygon = polygons[i];
+        if (polygon.size() < 3) continue;
+        paths.push_back(to_path_closed(conv, polygon));
+    }
+    return paths;
+}
+
+template <typename T>
+static Array boolean_polygons_tree_impl(
+    const PathConv<T> &conv,
+    const Array &subject_polygons,
+    const Array &clip_polygons,
+    Clipper2Lib::ClipType op)
 {
-    // Difference against union of all polygons; return flat list
-    Clipper2Lib::PathsD open_subjects;
+    RingStructure<T> rings;
+    execute_closed(op, to_closed_paths(conv, subject_polygons), to_closed_paths(conv, clip_polygons), rings);
+    return ring_structure_to_godot(conv, rings);
+}
+
+Array Clipper2Open::boolean_polygons_tree(
+    const Array &subject_polygons,
+    const Array &clip_polygons,
+    int operation) const
+{
+    Clipper2Lib::ClipType op;
+    ERR_FAIL_COND_V_MSG(!to_clipper_clip_type(operation, op), Array(), vformat("Invalid boolean operation %d", operation));
+
+    return with_active_mode([&](const auto &conv) {
+        return boolean_polygons_tree_impl(conv, subject_polygons, clip_polygons, op);
+    });
+}
+
+// Core of intersect_polygons_batched: one solution per clip group, empty groups yield an empty solution
+template <template <typename> class Solution = Clipper2Lib::Paths, typename T>
+static std::vector<Solution<T>> intersect_clip_groups_with_subject(
+    const std::vector<Clipper2Lib::Paths<T>> &clip_groups,
+    const Clipper2Lib::Paths<T> &subject_paths,
+    WorkerPool *pool)
+{
+    std::vector<Solution<T>> solutions(clip_groups.size());
+    run_jobs(pool, clip_groups.size(), [&](size_t idx) {
+        if (clip_groups[idx].empty()) {
+            return;
+        }
+        // Clipper2 engine of the active mode (double: precision 2, fixed point: exact)
+        execute_closed(Clipper2Lib::ClipType::Intersection, subject_paths, clip_groups[idx], solutions[idx]);
+    });
+    return solutions;
+}
+
+// Helper: convert clip polygons, one group each; degenerate (< 3 points) ones stay empty
+template <typename T>
+static std::vector<Clipper2Lib::Paths<T>> to_clip_groups(const PathConv<T> &conv, const Array &polygons) {
+    std::vector<Clipper2Lib::Paths<T>> clip_groups(polygons.size());
+    for (int p = 0; p < polygons.size(); p++) {
+        PackedVector2Array poly = polygons[p];
+        if (poly.size() < 3) continue;
+        clip_groups[p].push_back(to_path_closed(conv, poly));
+    }
+    return clip_groups;
+}
+
+// Helper: per-group solutions to the nested Array layout, on the calling thread in input order
+template <typename T, typename S>
+static Array closed_solutions_to_godot(const PathConv<T> &conv, const std::vector<S> &solutions) {
+    Array results;
+    results.resize(solutions.size());
+    for (size_t idx = 0; idx < solutions.size(); idx++) {
+        results[idx] = closed_solution_to_variant(conv, solutions[idx]);
+    }
+    return results;
+}
+
+template <typename T>
+static Array open_solutions_to_godot(const PathConv<T> &conv, const std::vector<Clipper2Lib::Paths<T>> &solutions) {
+    Array results;
+    results.resize(solutions.size());
+    for (size_t idx = 0; idx < solutions.size(); idx++) {
+        results[idx] = open_solution_to_godot_flat(conv, solutions[idx]);
+    }
+    return results;
+}
+
+template <template <typename> class Solution, typename T>
+static Array intersect_polygons_batched_impl(
+    const PathConv<T> &conv,
+    const Array &polygons,
+    const PackedVector2Array &subject_polygon,
+    WorkerPool *pool)
+{
+    // Convert subject polygon to Clipper2 format
+    Clipper2Lib::Paths<T> subject_paths;
+    subject_paths.push_back(to_path_closed(conv, subject_polygon));
+
+    // Convert clip polygons, degenerate ones produce an empty result
+    return closed_solutions_to_godot(conv, intersect_clip_groups_with_subject<Solution>(to_clip_groups(conv, polygons), subject_paths, pool));
+}
+
+template <typename T>
+static Array intersect_polygons_batched_flat_impl(
+    const PathConv<T> &conv,
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids,
+    const PackedVector2Array &subject_polygon,
+    WorkerPool *pool)
+{
+    FlatGroups<T> clips;
+    if (!flat_to_groups(conv, points, ring_offsets, group_ids, 3, clips)) {
+        return Array();
+    }
+
+    std::vector<Clipper2Lib::Paths<T>> solutions;
+    if (subject_polygon.size() >= 3) {
+        Clipper2Lib::Paths<T> subject_paths;
+        subject_paths.push_back(to_path_closed(conv, subject_polygon));
+        solutions = intersect_clip_groups_with_subject(clips.paths, subject_paths, pool);
+    }
+    return solutions_to_flat(conv, solutions, clips.ids, 3);
+}
+
+// --- True batched polygon intersection using Clipper2's native batching ---
+Array Clipper2Open::intersect_polygons_batched(
+    const Array &polygons,
+    const PackedVector2Array &subject_polygon) const
+{
+    if (subject_polygon.size() < 3) {
+        Array results;
+        results.resize(polygons.size());
+        return results;
+    }
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_polygons_batched_impl<Clipper2Lib::Paths>(conv, polygons, subject_polygon, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_polygons_batched_tree(
+    const Array &polygons,
+    const PackedVector2Array &subject_polygon) const
+{
+    if (subject_polygon.size() < 3) {
+        Array results;
+        results.resize(polygons.size());
+        for (int i = 0; i < polygons.size(); i++) {
+            results[i] = ring_structure_to_godot(PathConv<double>{}, RingStructure<double>{});
+        }
+        return results;
+    }
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_polygons_batched_impl<RingStructure>(conv, polygons, subject_polygon, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_polygons_batched_flat(
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids,
+    const PackedVector2Array &subject_polygon) const
+{
+    return with_active_mode([&](const auto &conv) {
+        return intersect_polygons_batched_flat_impl(conv, points, ring_offsets, group_ids, subject_polygon, get_pool());
+    });
+}
+
+// --- Open polylines x polygons ---
+
+// Helper: convert open polylines, optionally closing each one as a ring
+template <typename T>
+static Clipper2Lib::Paths<T> to_open_subjects(const PathConv<T> &conv, const Array &polylines, bool as_rings) {
+    Clipper2Lib::Paths<T> open_subjects;
+    open_subjects.reserve(polylines.size());
     for (int i = 0; i < polylines.size(); i++) {
         PackedVector2Array line = polylines[i];
         if (line.size() < 2) continue;
-        open_subjects.push_back(to_pathd_open(line));
+        open_subjects.push_back(as_rings ? to_path_ring_open(conv, line) : to_path_open(conv, line));
+    }
+    return open_subjects;
+}
+
+// Helper: bounds of a Clipper2 path or paths in their own units
+template <typename P>
+static Clipper2Lib::RectD native_bounds(const P &paths) {
+    auto r = Clipper2Lib::GetBounds(paths);
+    return Clipper2Lib::RectD(
+        static_cast<double>(r.left), static_cast<double>(r.top),
+        static_cast<double>(r.right), static_cast<double>(r.bottom)
+    );
+}
+
+// Below this many open subjects a plain bounds scan beats the grid
+static const int OPEN_SUBJECT_GRID_MIN_SUBJECTS = 32;
+
+// Bounds of every open subject, so each clip polygon only sweeps the subjects
+// that can reach it. A subject whose bounds miss the polygon has no inside part.
+template <typename T>
+struct OpenSubjectIndex {
+    const Clipper2Lib::Paths<T> &subjects;
+    std::vector<Clipper2Lib::RectD> bounds;
+    BoundsGrid grid;
+    bool use_grid = false;
+
+    explicit OpenSubjectIndex(const Clipper2Lib::Paths<T> &p_subjects) :
+            subjects(p_subjects) {
+        bounds.reserve(subjects.size());
+        for (const auto &path : subjects) {
+            bounds.push_back(native_bounds(path));
+        }
+        use_grid = static_cast<int>(subjects.size()) >= OPEN_SUBJECT_GRID_MIN_SUBJECTS;
+        if (use_grid) {
+            grid.build(bounds);
+        }
+    }
+
+    // Subjects overlapping the clip bounds, in input order
+    void query(const Clipper2Lib::RectD &clip_bounds, std::vector<int> &out) const {
+        out.clear();
+        if (use_grid) {
+            grid.query(clip_bounds, out);
+            return;
+        }
+        for (size_t i = 0; i < bounds.size(); i++) {
+            if (bounds_overlap(bounds[i], clip_bounds)) {
+                out.push_back(static_cast<int>(i));
+            }
+        }
     }
+};
+
+// Core of the grouped open-path intersections: one solution per clip group, empty groups yield an empty solution
+template <typename T>
+static std::vector<Clipper2Lib::Paths<T>> intersect_open_subjects_with_clip_groups(
+    const Clipper2Lib::Paths<T> &open_subjects,
+    const std::vector<Clipper2Lib::Paths<T>> &clip_groups,
+    WorkerPool *pool)
+{
+    std::vector<Clipper2Lib::Paths<T>> open_solutions(clip_groups.size());
     if (open_subjects.empty()) {
-        return Array();
+        return open_solutions;
     }
-    Clipper2Lib::PathsD closed_union;
-    for (int i = 0; i < polygons.size(); i++) {
-        PackedVector2Array poly = polygons[i];
-        if (poly.size() < 3) continue;
-        closed_union.push_back(to_pathd_closed(poly));
+
+    // Every polygon gets its own engine fed only the subjects its bounds can
+    // reach, so the jobs are independent and each sweep stays small
+    OpenSubjectIndex<T> subject_index(open_subjects);
+    run_jobs(pool, clip_groups.size(), [&](size_t p) {
+        if (clip_groups[p].empty()) {
+            return;
+        }
+        std::vector<int> candidates;
+        subject_index.query(native_bounds(clip_groups[p]), candidates);
+        if (candidates.empty()) {
+            return;
+        }
+
+        typename PathConv<T>::Engine c;
+        if (candidates.size() == open_subjects.size()) {
+            c.AddOpenSubject(open_subjects);
+        } else {
+            Clipper2Lib::Paths<T> culled;
+            culled.reserve(candidates.size());
+            for (int i : candidates) {
+                culled.push_back(open_subjects[i]);
+            }
+            c.AddOpenSubject(culled);
+        }
+        c.AddClip(clip_groups[p]);
+        Clipper2Lib::Paths<T> closed_solution; // unused closed output
+        c.Execute(Clipper2Lib::ClipType::Intersection, Clipper2Lib::FillRule::NonZero, closed_solution, open_solutions[p]);
+    });
+
+    return open_solutions;
+}
+
+// Core of the open-path difference: outside parts against the union of all clip paths
+template <typename T>
+static Clipper2Lib::Paths<T> difference_open_subjects_with_clip_paths(
+    const Clipper2Lib::Paths<T> &open_subjects,
+    const Clipper2Lib::Paths<T> &closed_union)
+{
+    Clipper2Lib::Paths<T> open_solution;
+    if (open_subjects.empty()) {
+        return open_solution;
     }
-    Clipper2Lib::ClipperD c;
+    typename PathConv<T>::Engine c;
     c.AddOpenSubject(open_subjects);
     if (!closed_union.empty()) {
         c.AddClip(closed_union);
     }
-    Clipper2Lib::PathsD closed_solution; // unused closed output
-    Clipper2Lib::PathsD open_solution;
+    Clipper2Lib::Paths<T> closed_solution; // unused closed output
     c.Execute(Clipper2Lib::ClipType::Difference, Clipper2Lib::FillRule::NonZero, closed_solution, open_solution);
-    return open_solution_to_godot_flat(open_solution);
+    return open_solution;
+}
+
+template <typename T>
+static Array intersect_many_open_with_polygons_impl(
+    const PathConv<T> &conv,
+    const Array &polylines,
+    const Array &polygons,
+    bool as_rings,
+    WorkerPool *pool)
+{
+    // Pre-convert open subjects once
+    Clipper2Lib::Paths<T> open_subjects = to_open_subjects(conv, polylines, as_rings);
+    if (open_subjects.empty()) {
+        Array grouped_results;
+        grouped_results.resize(polygons.size());
+        return grouped_results;
+    }
+
+    return open_solutions_to_godot(conv, intersect_open_subjects_with_clip_groups(open_subjects, to_clip_groups(conv, polygons), pool));
+}
+
+template <typename T>
+static Array intersect_many_open_with_polygons_flat_impl(
+    const PathConv<T> &conv,
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    const PackedVector2Array &polygon_points,
+    const PackedInt32Array &polygon_offsets,
+    const PackedInt32Array &polygon_group_ids,
+    bool as_rings,
+    WorkerPool *pool)
+{
+    Clipper2Lib::Paths<T> open_subjects;
+    if (!flat_to_open_subjects(conv, line_points, line_offsets, as_rings, open_subjects)) {
+        return Array();
+    }
+    FlatGroups<T> clips;
+    if (!flat_to_groups(conv, polygon_points, polygon_offsets, polygon_group_ids, 3, clips)) {
+        return Array();
+    }
+
+    return solutions_to_flat(conv, intersect_open_subjects_with_clip_groups(open_subjects, clips.paths, pool), clips.ids, 2);
+}
+
+template <typename T>
+static Array difference_many_polylines_with_polygons_impl(
+    const PathConv<T> &conv,
+    const Array &polylines,
+    const Array &polygons)
+{
+    // Difference against union of all polygons; return flat list
+    Clipper2Lib::Paths<T> open_subjects = to_open_subjects(conv, polylines, false);
+    if (open_subjects.empty()) {
+        return Array();
+    }
+    Clipper2Lib::Paths<T> closed_union;
+    for (int i = 0; i < polygons.size(); i++) {
+        PackedVector2Array poly = polygons[i];
+        if (poly.size() < 3) continue;
+        closed_union.push_back(to_path_closed(conv, poly));
+    }
+    return open_solution_to_godot_flat(conv, difference_open_subjects_with_clip_paths(open_subjects, closed_union));
+}
+
+// Every outside piece is reported under group 0, the difference has a single group
+template <typename T>
+static Array difference_many_polylines_with_polygons_flat_impl(
+    const PathConv<T> &conv,
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    const PackedVector2Array &polygon_points,
+    const PackedInt32Array &polygon_offsets)
+{
+    Clipper2Lib::Paths<T> open_subjects;
+    if (!flat_to_open_subjects(conv, line_points, line_offsets, false, open_subjects)) {
+        return Array();
+    }
+    FlatGroups<T> clips;
+    if (!flat_to_groups(conv, polygon_points, polygon_offsets, PackedInt32Array(), 3, clips)) {
+        return Array();
+    }
+
+    Clipper2Lib::Paths<T> closed_union;
+    for (const auto &group : clips.paths) {
+        closed_union.insert(closed_union.end(), group.begin(), group.end());
+    }
+    std::vector<Clipper2Lib::Paths<T>> solutions(1, difference_open_subjects_with_clip_paths(open_subjects, closed_union));
+    return solutions_to_flat(conv, solutions, std::vector<int32_t>(1, 0), 2);
+}
+
+// Intersect MANY open polylines with MANY closed polygons in one run
+Array Clipper2Open::intersect_many_polylines_with_polygons(
+    const Array &polylines,
+    const Array &polygons) const
+{
+    return with_active_mode([&](const auto &conv) {
+        return intersect_many_open_with_polygons_impl(conv, polylines, polygons, false, get_pool());
+    });
+}
+
+// Difference (outside) of MANY open polylines with MANY closed polygons in one run
+Array Clipper2Open::difference_many_polylines_with_polygons(
+    const Array &polylines,
+    const Array &polygons) const
+{
+    return with_active_mode([&](const auto &conv) {
+        return difference_many_polylines_with_polygons_impl(conv, polylines, polygons);
+    });
 }
 
 // Intersect MANY ring-polylines (adds last->first) with MANY polygons
@@ -458,36 +1077,1044 @@ Array Clipper2Open::intersect_many_ringpolylines_with_polygons(
     const Array &polylines,
     const Array &polygons) const
 {
-    Array grouped_results;
-    grouped_results.resize(polygons.size());
+    return with_active_mode([&](const auto &conv) {
+        return intersect_many_open_with_polygons_impl(conv, polylines, polygons, true, get_pool());
+    });
+}
 
-    Clipper2Lib::PathsD open_subjects;
-    for (int i = 0; i < polylines.size(); i++) {
-        PackedVector2Array line = polylines[i];
-        if (line.size() < 2) continue;
-        open_subjects.push_back(to_pathd_ring_open(line));
+Array Clipper2Open::intersect_many_polylines_with_polygons_flat(
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    const PackedVector2Array &polygon_points,
+    const PackedInt32Array &polygon_offsets,
+    const PackedInt32Array &polygon_group_ids) const
+{
+    return with_active_mode([&](const auto &conv) {
+        return intersect_many_open_with_polygons_flat_impl(
+            conv, line_points, line_offsets, polygon_points, polygon_offsets, polygon_group_ids, false, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_many_ringpolylines_with_polygons_flat(
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    const PackedVector2Array &polygon_points,
+    const PackedInt32Array &polygon_offsets,
+    const PackedInt32Array &polygon_group_ids) const
+{
+    return with_active_mode([&](const auto &conv) {
+        return intersect_many_open_with_polygons_flat_impl(
+            conv, line_points, line_offsets, polygon_points, polygon_offsets, polygon_group_ids, true, get_pool());
+    });
+}
+
+Array Clipper2Open::difference_many_polylines_with_polygons_flat(
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    const PackedVector2Array &polygon_points,
+    const PackedInt32Array &polygon_offsets) const
+{
+    return with_active_mode([&](const auto &conv) {
+        return difference_many_polylines_with_polygons_flat_impl(conv, line_points, line_offsets, polygon_points, polygon_offsets);
+    });
+}
+
+// --- Component union ---
+
+// Union-find root with path halving
+static int find_component(std::vector<int> &parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
     }
-    if (open_subjects.empty()) {
-        return grouped_results;
+    return i;
+}
+
+// The component union always runs on integers, so absorption can be decided on
+// the exact paths Clipper worked with; the double mode uses ClipperD's default
+// precision (2 decimals) and gives the same rings ClipperD would.
+static const double COMPONENT_UNION_DOUBLE_SCALE = 100.0;
+
+// Union of one component plus, per input, the outer that swallowed it
+struct ComponentUnion {
+    RingStructure<int64_t> rings;
+    std::vector<int> input_outers;
+    int unmatched = 0;
+};
+
+static bool rect_contains(const Clipper2Lib::RectD &outer, const Clipper2Lib::RectD &inner, double slack) {
+    return inner.left >= outer.left - slack && inner.right <= outer.right + slack &&
+        inner.top >= outer.top - slack && inner.bottom <= outer.bottom + slack;
+}
+
+// The outer with the fewest input vertices strictly outside it. Vertices on
+// the union boundary test IsOn, but a collinear vertex Clipper dropped next to
+// a rounded intersection can land a unit outside, so one stray vertex must
+// not disqualify the right outer. Ties go to the smallest outer, because an
+// island inside a hole is also "inside" the outer around the hole. -1 when
+// every vertex is outside every outer.
+static int absorbing_outer(
+    const Clipper2Lib::Path64 &input,
+    const Clipper2Lib::RectD &input_bounds,
+    const Clipper2Lib::Paths64 &outers,
+    const std::vector<double> &outer_areas,
+    const std::vector<Clipper2Lib::RectD> &outer_bounds)
+{
+    int best = -1;
+    size_t best_outside = input.size();
+    for (size_t o = 0; o < outers.size(); o++) {
+        // An absorbed input lies within its outer, up to the rounding unit
+        if (!rect_contains(outer_bounds[o], input_bounds, 1.0)) {
+            continue;
+        }
+        size_t outside = 0;
+        for (const auto &pt : input) {
+            if (Clipper2Lib::PointInPolygon(pt, outers[o]) == Clipper2Lib::PointInPolygonResult::IsOutside) {
+                outside++;
+                if (outside > best_outside) {
+                    break;
+                }
+            }
+        }
+        if (outside == input.size()) {
+            continue;
+        }
+        if (best < 0 || outside < best_outside || (outside == best_outside && outer_areas[o] < outer_areas[best])) {
+            best = static_cast<int>(o);
+            best_outside = outside;
+        }
     }
+    return best;
+}
 
-    for (int p = 0; p < polygons.size(); p++) {
-        PackedVector2Array poly = polygons[p];
-        Array result;
-        if (poly.size() < 3) {
-            grouped_results[p] = result;
+static Array union_polygons_by_component_impl(const PathConv<int64_t> &conv, const Array &polygons, WorkerPool *pool) {
+    const int count = polygons.size();
+    Clipper2Lib::Paths64 paths(count);
+    std::vector<int> live; // non-degenerate inputs
+    std::vector<Clipper2Lib::RectD> live_bounds;
+    std::vector<Clipper2Lib::RectD> bounds(count);
+    for (int i = 0; i < count; i++) {
+        PackedVector2Array polygon = polygons[i];
+        if (polygon.size() < 3) continue;
+        paths[i] = to_path_closed(conv, polygon);
+        bounds[i] = native_bounds(paths[i]);
+        live.push_back(i);
+        live_bounds.push_back(bounds[i]);
+    }
+
+    // Broadphase: inputs whose bounds touch end up in one component
+    std::vector<int> parent(count);
+    for (int i = 0; i < count; i++) {
+        parent[i] = i;
+    }
+    BoundsGrid grid;
+    grid.build(live_bounds);
+    std::vector<int> candidates;
+    for (size_t l = 0; l < live.size(); l++) {
+        candidates.clear();
+        grid.query(live_bounds[l], candidates);
+        for (int m : candidates) {
+            if (m <= static_cast<int>(l)) continue;
+            int a = find_component(parent, live[l]);
+            int b = find_component(parent, live[m]);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    // Components in order of their first input
+    std::vector<std::vector<int>> components;
+    std::vector<int> component_of_root(count, -1);
+    for (int i : live) {
+        int root = find_component(parent, i);
+        if (component_of_root[root] < 0) {
+            component_of_root[root] = static_cast<int>(components.size());
+            components.emplace_back();
+        }
+        components[component_of_root[root]].push_back(i);
+    }
+
+    std::vector<ComponentUnion> unions(components.size());
+    run_jobs(pool, components.size(), [&](size_t k) {
+        const std::vector<int> &members = components[k];
+        ComponentUnion &result = unions[k];
+        Clipper2Lib::Paths64 subjects;
+        subjects.reserve(members.size());
+        for (int i : members) {
+            subjects.push_back(paths[i]);
+        }
+        Clipper2Lib::Clipper64 c;
+        c.AddSubject(subjects);
+        Clipper2Lib::PolyTree64 tree;
+        c.Execute(Clipper2Lib::ClipType::Union, Clipper2Lib::FillRule::NonZero, tree);
+        flatten_polytree(tree, -1, result.rings);
+
+        const Clipper2Lib::Paths64 &outers = result.rings.outers;
+        result.input_outers.assign(members.size(), -1);
+        if (outers.empty()) {
+            return;
+        }
+        // Every input of a component with a single outer went into it
+        if (outers.size() == 1) {
+            std::fill(result.input_outers.begin(), result.input_outers.end(), 0);
+            return;
+        }
+        std::vector<double> outer_areas;
+        std::vector<Clipper2Lib::RectD> outer_bounds;
+        outer_areas.reserve(outers.size());
+        outer_bounds.reserve(outers.size());
+        for (const auto &outer : outers) {
+            outer_areas.push_back(std::abs(Clipper2Lib::Area(outer)));
+            outer_bounds.push_back(native_bounds(outer));
+        }
+        for (size_t m = 0; m < members.size(); m++) {
+            const int i = members[m];
+            // Zero-area inputs vanish in the union, nothing absorbed them
+            if (Clipper2Lib::Area(paths[i]) == 0.0) continue;
+            result.input_outers[m] = absorbing_outer(paths[i], bounds[i], outers, outer_areas, outer_bounds);
+            if (result.input_outers[m] < 0) {
+                result.unmatched++;
+            }
+        }
+    });
+
+    // Concatenate components, shifting outer indices
+    RingStructure<int64_t> rings;
+    PackedInt32Array input_outers;
+    input_outers.resize(count);
+    input_outers.fill(-1);
+    int32_t *input_dst = input_outers.ptrw();
+    int unmatched = 0;
+    for (size_t k = 0; k < unions.size(); k++) {
+        const int outer_base = static_cast<int>(rings.outers.size());
+        const RingStructure<int64_t> &part = unions[k].rings;
+        rings.outers.insert(rings.outers.end(), part.outers.begin(), part.outers.end());
+        rings.holes.insert(rings.holes.end(), part.holes.begin(), part.holes.end());
+        for (int hole_parent : part.hole_parents) {
+            rings.hole_parents.push_back(hole_parent < 0 ? -1 : hole_parent + outer_base);
+        }
+        for (size_t m = 0; m < components[k].size(); m++) {
+            int outer = unions[k].input_outers[m];
+            input_dst[components[k][m]] = outer < 0 ? -1 : outer + outer_base;
+        }
+        unmatched += unions[k].unmatched;
+    }
+    if (unmatched > 0) {
+        ERR_PRINT(vformat("union_polygons_by_component: %d inputs lie outside every union outer", unmatched));
+    }
+
+    Array result = ring_structure_to_godot(conv, rings);
+    result.append(input_outers);
+    return result;
+}
+
+Array Clipper2Open::union_polygons_by_component(const Array &polygons) const {
+    PathConv<int64_t> conv{fixed_point ? fixed_point_scale : COMPONENT_UNION_DOUBLE_SCALE};
+    return union_polygons_by_component_impl(conv, polygons, get_pool());
+}
+
+// --- Offsetting ---
+
+// ClipperOffset only runs on integers; the double mode uses the precision of
+// Geometry2D.offset_polygon (5 decimals), fixed point its own scale
+static const double OFFSET_DOUBLE_SCALE = 100000.0;
+
+// Same values as Geometry2D.PolyJoinType and Geometry2D.PolyEndType
+static bool to_clipper_join_type(int join_type, Clipper2Lib::JoinType &out) {
+    switch (join_type) {
+        case 0: out = Clipper2Lib::JoinType::Square; return true;
+        case 1: out = Clipper2Lib::JoinType::Round; return true;
+        case 2: out = Clipper2Lib::JoinType::Miter; return true;
+    }
+    return false;
+}
+
+static bool to_clipper_end_type(int end_type, Clipper2Lib::EndType &out) {
+    switch (end_type) {
+        case 0: out = Clipper2Lib::EndType::Polygon; return true;
+        case 1: out = Clipper2Lib::EndType::Joined; return true;
+        case 2: out = Clipper2Lib::EndType::Butt; return true;
+        case 3: out = Clipper2Lib::EndType::Square; return true;
+        case 4: out = Clipper2Lib::EndType::Round; return true;
+    }
+    return false;
+}
+
+// Helper: convert paths for offsetting, ones below min_points stay empty
+static Clipper2Lib::Paths64 to_offset_inputs(const PathConv<int64_t> &conv, const Array &paths, size_t min_points) {
+    Clipper2Lib::Paths64 inputs(paths.size());
+    for (int i = 0; i < paths.size(); i++) {
+        PackedVector2Array path = paths[i];
+        if (static_cast<size_t>(path.size()) < min_points) continue;
+        inputs[i] = to_path_closed(conv, path);
+    }
+    return inputs;
+}
+
+// Core of the batched offsets: one job per (path, delta), result k = path * deltas.size() + delta
+static std::vector<RingStructure<int64_t>> offset_paths_to_rings(
+    const PathConv<int64_t> &conv,
+    const Clipper2Lib::Paths64 &inputs,
+    const std::vector<double> &deltas,
+    Clipper2Lib::JoinType join_type,
+    Clipper2Lib::EndType end_type,
+    double miter_limit,
+    double arc_tolerance,
+    WorkerPool *pool)
+{
+    const size_t delta_count = deltas.size();
+    std::vector<RingStructure<int64_t>> structures(inputs.size() * delta_count);
+    run_jobs(pool, structures.size(), [&](size_t k) {
+        const Clipper2Lib::Path64 &input = inputs[k / delta_count];
+        if (input.empty()) {
+            return;
+        }
+        Clipper2Lib::ClipperOffset offsetter(miter_limit, arc_tolerance * conv.units());
+        offsetter.AddPath(input, join_type, end_type);
+        Clipper2Lib::PolyTree64 tree;
+        offsetter.Execute(deltas[k % delta_count] * conv.units(), tree);
+        flatten_polytree(tree, -1, structures[k]);
+    });
+    return structures;
+}
+
+static Array offset_paths_batched(
+    const PathConv<int64_t> &conv,
+    const Array &paths,
+    size_t min_points,
+    const PackedFloat32Array &deltas,
+    Clipper2Lib::JoinType join_type,
+    Clipper2Lib::EndType end_type,
+    double miter_limit,
+    double arc_tolerance,
+    WorkerPool *pool)
+{
+    std::vector<RingStructure<int64_t>> structures = offset_paths_to_rings(
+        conv, to_offset_inputs(conv, paths, min_points),
+        std::vector<double>(deltas.ptr(), deltas.ptr() + deltas.size()),
+        join_type, end_type, miter_limit, arc_tolerance, pool);
+
+    Array results;
+    results.resize(structures.size());
+    for (size_t k = 0; k < structures.size(); k++) {
+        results[k] = ring_structure_to_godot(conv, structures[k]);
+    }
+    return results;
+}
+
+Array Clipper2Open::offset_polygons_batched(
+    const Array &polygons,
+    const PackedFloat32Array &deltas,
+    int join_type,
+    double arc_tolerance,
+    double miter_limit) const
+{
+    Clipper2Lib::JoinType clipper_join;
+    ERR_FAIL_COND_V_MSG(!to_clipper_join_type(join_type, clipper_join), Array(), vformat("Invalid join type %d", join_type));
+    ERR_FAIL_COND_V_MSG(!(arc_tolerance > 0.0), Array(), "Arc tolerance must be positive");
+
+    PathConv<int64_t> conv{fixed_point ? fixed_point_scale : OFFSET_DOUBLE_SCALE};
+    return offset_paths_batched(conv, polygons, 3, deltas, clipper_join, Clipper2Lib::EndType::Polygon, miter_limit, arc_tolerance, get_pool());
+}
+
+Array Clipper2Open::offset_polylines_batched(
+    const Array &polylines,
+    const PackedFloat32Array &deltas,
+    int join_type,
+    int end_type,
+    double arc_tolerance,
+    double miter_limit) const
+{
+    Clipper2Lib::JoinType clipper_join;
+    ERR_FAIL_COND_V_MSG(!to_clipper_join_type(join_type, clipper_join), Array(), vformat("Invalid join type %d", join_type));
+    Clipper2Lib::EndType clipper_end;
+    ERR_FAIL_COND_V_MSG(!to_clipper_end_type(end_type, clipper_end) || clipper_end == Clipper2Lib::EndType::Polygon, Array(),
+        vformat("Invalid end type %d for polylines", end_type));
+    ERR_FAIL_COND_V_MSG(!(arc_tolerance > 0.0), Array(), "Arc tolerance must be positive");
+
+    PathConv<int64_t> conv{fixed_point ? fixed_point_scale : OFFSET_DOUBLE_SCALE};
+    return offset_paths_batched(conv, polylines, 2, deltas, clipper_join, clipper_end, miter_limit, arc_tolerance, get_pool());
+}
+
+// --- Offset overlaps ---
+
+// Summed length of open paths, in world units
+static double open_paths_length(const PathConv<int64_t> &conv, const Clipper2Lib::Paths64 &paths) {
+    double length = 0.0;
+    for (const auto &path : paths) {
+        for (size_t i = 1; i < path.size(); i++) {
+            length += std::hypot(
+                static_cast<double>(path[i].x - path[i - 1].x),
+                static_cast<double>(path[i].y - path[i - 1].y));
+        }
+    }
+    return length / conv.units();
+}
+
+// Length of the rings inside the measure polygons (every polygon counted on its own)
+static double rings_length_inside(
+    const PathConv<int64_t> &conv,
+    const Clipper2Lib::Paths64 &rings,
+    const std::vector<Clipper2Lib::Paths64> &measure_groups)
+{
+    Clipper2Lib::Paths64 open_rings;
+    open_rings.reserve(rings.size());
+    for (const auto &ring : rings) {
+        if (ring.size() < 3) continue;
+        Clipper2Lib::Path64 closed = ring;
+        closed.push_back(ring.front());
+        open_rings.push_back(std::move(closed));
+    }
+    double length = 0.0;
+    for (const auto &pieces : intersect_open_subjects_with_clip_groups(open_rings, measure_groups, nullptr)) {
+        length += open_paths_length(conv, pieces);
+    }
+    return length;
+}
+
+Array Clipper2Open::collect_offset_overlaps(
+    const Array &polygons,
+    const PackedInt32Array &group_ids,
+    double delta,
+    const Array &measure_polygons,
+    int measure_group,
+    double arc_tolerance) const
+{
+    ERR_FAIL_COND_V_MSG(group_ids.size() != polygons.size(), Array(), "One group id per polygon is required");
+    ERR_FAIL_COND_V_MSG(!(arc_tolerance > 0.0), Array(), "Arc tolerance must be positive");
+
+    PathConv<int64_t> conv{fixed_point ? fixed_point_scale : OFFSET_DOUBLE_SCALE};
+    WorkerPool *worker_pool = get_pool();
+    const int32_t *groups = group_ids.ptr();
+
+    // 1. Offset every polygon once
+    std::vector<RingStructure<int64_t>> offsets = offset_paths_to_rings(
+        conv, to_offset_inputs(conv, polygons, 3), std::vector<double>(1, delta),
+        Clipper2Lib::JoinType::Round, Clipper2Lib::EndType::Polygon, 2.0, arc_tolerance, worker_pool);
+
+    std::vector<Clipper2Lib::Paths64> shapes(offsets.size());
+    std::vector<Clipper2Lib::RectD> shape_bounds(offsets.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        shapes[i] = offsets[i].outers;
+        shapes[i].insert(shapes[i].end(), offsets[i].holes.begin(), offsets[i].holes.end());
+        if (!shapes[i].empty()) {
+            shape_bounds[i] = native_bounds(shapes[i]);
+        }
+    }
+
+    // 2. Broadphase: pairs of different groups whose offset bounds touch
+    BoundsGrid grid;
+    grid.build(shape_bounds);
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<int> candidates;
+    for (size_t i = 0; i < shapes.size(); i++) {
+        if (shapes[i].empty()) continue;
+        candidates.clear();
+        grid.query(shape_bounds[i], candidates);
+        for (int j : candidates) {
+            if (j <= static_cast<int>(i) || shapes[j].empty() || groups[j] == groups[i]) continue;
+            pairs.emplace_back(static_cast<int>(i), j);
+        }
+    }
+
+    // 3. Narrowphase overlap and contact length, one job per candidate pair
+    std::vector<Clipper2Lib::Paths64> measure_groups = to_clip_groups(conv, measure_polygons);
+    std::vector<RingStructure<int64_t>> overlaps(pairs.size());
+    std::vector<double> lengths(pairs.size(), 0.0);
+    run_jobs(worker_pool, pairs.size(), [&](size_t k) {
+        const std::pair<int, int> &pair = pairs[k];
+        execute_closed(Clipper2Lib::ClipType::Intersection, shapes[pair.first], shapes[pair.second], overlaps[k]);
+        if (overlaps[k].outers.empty() || measure_groups.empty()) {
+            return;
+        }
+        if (measure_group >= 0 && groups[pair.first] != measure_group && groups[pair.second] != measure_group) {
+            return;
+        }
+        // Holes of the overlap count negatively
+        lengths[k] = rings_length_inside(conv, overlaps[k].outers, measure_groups) -
+                rings_length_inside(conv, overlaps[k].holes, measure_groups);
+    });
+
+    Array offset_results;
+    offset_results.resize(offsets.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        offset_results[i] = ring_structure_to_godot(conv, offsets[i]);
+    }
+
+    // Sparse output, pairs whose offsets do not actually overlap are dropped
+    PackedInt32Array first_indices;
+    PackedInt32Array second_indices;
+    PackedFloat64Array contact_lengths;
+    Array overlap_results;
+    for (size_t k = 0; k < pairs.size(); k++) {
+        if (!has_closed_rings(overlaps[k])) continue;
+        first_indices.append(pairs[k].first);
+        second_indices.append(pairs[k].second);
+        contact_lengths.append(lengths[k]);
+        overlap_results.append(ring_structure_to_godot(conv, overlaps[k]));
+    }
+
+    Array result;
+    result.append(offset_results);
+    result.append(first_indices);
+    result.append(second_indices);
+    result.append(contact_lengths);
+    result.append(overlap_results);
+    return result;
+}
+
+// --- Parallel mode ---
+
+void Clipper2Open::set_parallel(bool enabled, int thread_count) {
+    if (!enabled) {
+        pool.reset();
+        return;
+    }
+    if (pool && thread_count > 0 && pool->get_thread_count() == thread_count) {
+        return;
+    }
+    pool = std::make_unique<WorkerPool>(thread_count);
+}
+
+bool Clipper2Open::is_parallel() const {
+    return pool != nullptr;
+}
+
+int Clipper2Open::get_parallel_thread_count() const {
+    return pool ? pool->get_thread_count() : 1;
+}
+
+// --- Registry of static polygons ---
+
+void Clipper2Open::rescale_registered(RegisteredPolygons &entry) const {
+    entry.paths64.clear();
+    entry.paths64.reserve(entry.paths.size());
+    for (const auto &path : entry.paths) {
+        Clipper2Lib::Path64 path64;
+        path64.reserve(path.size());
+        for (const auto &pt : path) {
+            path64.push_back(Clipper2Lib::Point64(
+                static_cast<int64_t>(std::llround(pt.x * fixed_point_scale)),
+                static_cast<int64_t>(std::llround(pt.y * fixed_point_scale))
+            ));
+        }
+        entry.paths64.push_back(std::move(path64));
+    }
+}
+
+int Clipper2Open::register_polygons(const Array &polygons) {
+    RegisteredPolygons entry;
+    PathConv<double> conv;
+    entry.paths.reserve(polygons.size());
+    entry.bounds.reserve(polygons.size());
+    for (int i = 0; i < polygons.size(); i++) {
+        PackedVector2Array polygon = polygons[i];
+        // Keep degenerate entries so indices stay aligned with the caller's array
+        entry.paths.push_back(to_path_closed(conv, polygon));
+        entry.bounds.push_back(polygon_bounds(polygon));
+    }
+    rescale_registered(entry);
+    entry.grid.build(entry.bounds);
+    int handle = next_registry_handle++;
+    registry[handle] = std::move(entry);
+    return handle;
+}
+
+int Clipper2Open::register_obstacles(const Array &obstacles, const Rect2 &keep_rect) {
+    // Union once so overlapping obstacles become single rings; holes of the
+    // union are registered too and cancel their outer under NonZero
+    PathConv<double> conv;
+    RegisteredPolygons entry;
+    entry.paths = Clipper2Lib::Union(to_closed_paths(conv, obstacles), Clipper2Lib::FillRule::NonZero);
+    entry.bounds.reserve(entry.paths.size());
+    for (const auto &path : entry.paths) {
+        entry.bounds.push_back(native_bounds(path));
+    }
+    if (keep_rect.has_area()) {
+        entry.has_keep_rect = true;
+        entry.keep_rect = Clipper2Lib::RectD(
+            keep_rect.position.x, keep_rect.position.y,
+            keep_rect.position.x + keep_rect.size.x, keep_rect.position.y + keep_rect.size.y
+        );
+    }
+    rescale_registered(entry);
+    entry.grid.build(entry.bounds);
+    int handle = next_registry_handle++;
+    registry[handle] = std::move(entry);
+    return handle;
+}
+
+void Clipper2Open::unregister_polygons(int handle) {
+    ERR_FAIL_COND_MSG(registry.erase(handle) == 0, vformat("Unknown polygon registry handle %d", handle));
+}
+
+void Clipper2Open::clear_registered_polygons() {
+    registry.clear();
+}
+
+const Clipper2Open::RegisteredPolygons *Clipper2Open::get_registered(int handle) const {
+    auto it = registry.find(handle);
+    if (it == registry.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+int Clipper2Open::get_registered_polygon_count(int handle) const {
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, 0, vformat("Unknown polygon registry handle %d", handle));
+    return static_cast<int>(entry->paths.size());
+}
+
+Rect2 Clipper2Open::get_registered_polygon_bounds(int handle, int index) const {
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Rect2(), vformat("Unknown polygon registry handle %d", handle));
+    ERR_FAIL_INDEX_V(index, static_cast<int>(entry->bounds.size()), Rect2());
+    const Clipper2Lib::RectD &b = entry->bounds[index];
+    return Rect2(b.left, b.top, b.right - b.left, b.bottom - b.top);
+}
+
+// Helper: resolve registry indices to clip groups, invalid or degenerate entries stay empty
+template <typename T>
+static std::vector<Clipper2Lib::Paths<T>> registered_clip_groups(
+    const Clipper2Lib::Paths<T> &paths,
+    const PackedInt32Array &indices)
+{
+    std::vector<Clipper2Lib::Paths<T>> clip_groups(indices.size());
+    const int32_t *idx = indices.ptr();
+    for (int i = 0; i < indices.size(); i++) {
+        if (idx[i] < 0 || idx[i] >= static_cast<int>(paths.size())) {
+            ERR_PRINT(vformat("Registry index %d out of range", idx[i]));
             continue;
         }
-        Clipper2Lib::ClipperD c;
-        c.AddOpenSubject(open_subjects);
-        Clipper2Lib::PathsD closed_clip;
-        closed_clip.push_back(to_pathd_closed(poly));
-        c.AddClip(closed_clip);
-        Clipper2Lib::PathsD closed_solution;
-        Clipper2Lib::PathsD open_solution;
-        c.Execute(Clipper2Lib::ClipType::Intersection, Clipper2Lib::FillRule::NonZero, closed_solution, open_solution);
-        grouped_results[p] = open_solution_to_godot_flat(open_solution);
+        if (paths[idx[i]].size() < 3) continue;
+        clip_groups[i].push_back(paths[idx[i]]);
+    }
+    return clip_groups;
+}
+
+// Helper: registry indices as flat-layout group ids
+static std::vector<int32_t> indices_to_ids(const PackedInt32Array &indices) {
+    return std::vector<int32_t>(indices.ptr(), indices.ptr() + indices.size());
+}
+
+template <template <typename> class Solution = Clipper2Lib::Paths, typename T, typename Entry>
+static std::vector<Solution<T>> intersect_registered_polygons_batched_solutions(
+    const PathConv<T> &conv,
+    const Entry &entry,
+    const PackedInt32Array &indices,
+    const PackedVector2Array &subject_polygon,
+    WorkerPool *pool)
+{
+    if (subject_polygon.size() < 3) {
+        return std::vector<Solution<T>>(indices.size());
+    }
+
+    Clipper2Lib::Paths<T> subject_paths;
+    subject_paths.push_back(to_path_closed(conv, subject_polygon));
+    Clipper2Lib::RectD subject_bounds = polygon_bounds(subject_polygon);
+
+    std::vector<Clipper2Lib::Paths<T>> clip_groups = registered_clip_groups(entry.paths_for(conv), indices);
+    const int32_t *idx = indices.ptr();
+    for (size_t i = 0; i < clip_groups.size(); i++) {
+        if (!clip_groups[i].empty() && !bounds_overlap(entry.bounds[idx[i]], subject_bounds)) {
+            clip_groups[i].clear();
+        }
+    }
+
+    return intersect_clip_groups_with_subject<Solution>(clip_groups, subject_paths, pool);
+}
+
+Array Clipper2Open::intersect_registered_polygons_batched(
+    int handle,
+    const PackedInt32Array &indices,
+    const PackedVector2Array &subject_polygon) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return closed_solutions_to_godot(conv, intersect_registered_polygons_batched_solutions(conv, *entry, indices, subject_polygon, get_pool()));
+    });
+}
+
+Array Clipper2Open::intersect_registered_polygons_batched_tree(
+    int handle,
+    const PackedInt32Array &indices,
+    const PackedVector2Array &subject_polygon) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return closed_solutions_to_godot(conv, intersect_registered_polygons_batched_solutions<RingStructure>(conv, *entry, indices, subject_polygon, get_pool()));
+    });
+}
+
+Array Clipper2Open::intersect_registered_polygons_batched_flat(
+    int handle,
+    const PackedInt32Array &indices,
+    const PackedVector2Array &subject_polygon) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return solutions_to_flat(conv, intersect_registered_polygons_batched_solutions(conv, *entry, indices, subject_polygon, get_pool()), indices_to_ids(indices), 3);
+    });
+}
+
+// Core of the all-pairs registry intersection: grid broadphase over subject
+// bounds, then one independent Intersect per candidate (subject, registered) pair
+template <template <typename> class Solution = Clipper2Lib::Paths, typename T, typename Entry>
+static std::vector<Solution<T>> intersect_subjects_with_registered(
+    const PathConv<T> &conv,
+    const Entry &entry,
+    const std::vector<Clipper2Lib::Paths<T>> &subjects,
+    const std::vector<Clipper2Lib::RectD> &subject_bounds,
+    WorkerPool *pool,
+    std::vector<std::pair<int, int>> &pairs)
+{
+    const Clipper2Lib::Paths<T> &registered = entry.paths_for(conv);
+
+    std::vector<int> candidates;
+    for (size_t i = 0; i < subjects.size(); i++) {
+        if (subjects[i].empty()) continue;
+        candidates.clear();
+        entry.grid.query(subject_bounds[i], candidates);
+        for (int c : candidates) {
+            if (registered[c].size() < 3) continue;
+            pairs.emplace_back(static_cast<int>(i), c);
+        }
+    }
+
+    std::vector<Solution<T>> solutions(pairs.size());
+    run_jobs(pool, pairs.size(), [&](size_t k) {
+        Clipper2Lib::Paths<T> clip(1, registered[pairs[k].second]);
+        execute_closed(Clipper2Lib::ClipType::Intersection, subjects[pairs[k].first], clip, solutions[k]);
+    });
+    return solutions;
+}
+
+template <template <typename> class Solution, typename T, typename Entry>
+static Array intersect_polygons_with_registered_polygons_impl(
+    const PathConv<T> &conv,
+    const Entry &entry,
+    const Array &subject_polygons,
+    WorkerPool *pool)
+{
+    std::vector<Clipper2Lib::Paths<T>> subjects(subject_polygons.size());
+    std::vector<Clipper2Lib::RectD> subject_bounds(subject_polygons.size());
+    for (int i = 0; i < subject_polygons.size(); i++) {
+        PackedVector2Array polygon = subject_polygons[i];
+        if (polygon.size() < 3) continue;
+        subjects[i].push_back(to_path_closed(conv, polygon));
+        subject_bounds[i] = polygon_bounds(polygon);
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<Solution<T>> solutions = intersect_subjects_with_registered<Solution>(conv, entry, subjects, subject_bounds, pool, pairs);
+
+    // Sparse output, pairs whose bounds touched but shapes did not are dropped
+    PackedInt32Array subject_indices;
+    PackedInt32Array registered_indices;
+    Array polygons;
+    for (size_t k = 0; k < pairs.size(); k++) {
+        if (!has_closed_rings(solutions[k])) continue;
+        subject_indices.append(pairs[k].first);
+        registered_indices.append(pairs[k].second);
+        polygons.append(closed_solution_to_variant(conv, solutions[k]));
+    }
+
+    Array result;
+    result.append(subject_indices);
+    result.append(registered_indices);
+    result.append(polygons);
+    return result;
+}
+
+template <typename T, typename Entry>
+static Array intersect_polygons_with_registered_polygons_flat_impl(
+    const PathConv<T> &conv,
+    const Entry &entry,
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids,
+    WorkerPool *pool)
+{
+    FlatGroups<T> subjects;
+    if (!flat_to_groups(conv, points, ring_offsets, group_ids, 3, subjects)) {
+        return Array();
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<Clipper2Lib::Paths<T>> solutions = intersect_subjects_with_registered(conv, entry, subjects.paths, subjects.bounds, pool, pairs);
+
+    // Rings are written under their pair index, then split into subject id and registry index
+    std::vector<int32_t> pair_ids(pairs.size());
+    for (size_t k = 0; k < pairs.size(); k++) {
+        pair_ids[k] = static_cast<int32_t>(k);
+    }
+    PackedVector2Array out_points;
+    PackedInt32Array out_offsets;
+    PackedInt32Array subject_ids;
+    write_flat(conv, solutions, pair_ids, 3, out_points, out_offsets, subject_ids);
+
+    PackedInt32Array registered_indices;
+    registered_indices.resize(subject_ids.size());
+    int32_t *subject_dst = subject_ids.ptrw();
+    int32_t *registered_dst = registered_indices.ptrw();
+    for (int r = 0; r < subject_ids.size(); r++) {
+        const std::pair<int, int> &pair = pairs[subject_dst[r]];
+        subject_dst[r] = subjects.ids[pair.first];
+        registered_dst[r] = pair.second;
+    }
+
+    Array result = make_flat_result(out_points, out_offsets, subject_ids);
+    result.append(registered_indices);
+    return result;
+}
+
+Array Clipper2Open::intersect_polygons_with_registered_polygons(
+    const Array &subject_polygons,
+    int handle) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_polygons_with_registered_polygons_impl<Clipper2Lib::Paths>(conv, *entry, subject_polygons, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_polygons_with_registered_polygons_tree(
+    const Array &subject_polygons,
+    int handle) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_polygons_with_registered_polygons_impl<RingStructure>(conv, *entry, subject_polygons, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_polygons_with_registered_polygons_flat(
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids,
+    int handle) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_polygons_with_registered_polygons_flat_impl(conv, *entry, points, ring_offsets, group_ids, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_many_polylines_with_registered_polygons(
+    const Array &polylines,
+    int handle,
+    const PackedInt32Array &indices) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return open_solutions_to_godot(conv, intersect_open_subjects_with_clip_groups(
+            to_open_subjects(conv, polylines, false),
+            registered_clip_groups(entry->paths_for(conv), indices),
+            get_pool()));
+    });
+}
+
+Array Clipper2Open::intersect_many_ringpolylines_with_registered_polygons(
+    const Array &polylines,
+    int handle,
+    const PackedInt32Array &indices) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return open_solutions_to_godot(conv, intersect_open_subjects_with_clip_groups(
+            to_open_subjects(conv, polylines, true),
+            registered_clip_groups(entry->paths_for(conv), indices),
+            get_pool()));
+    });
+}
+
+template <typename T, typename Entry>
+static Array intersect_many_open_with_registered_polygons_flat_impl(
+    const PathConv<T> &conv,
+    const Entry &entry,
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    const PackedInt32Array &indices,
+    bool as_rings,
+    WorkerPool *pool)
+{
+    Clipper2Lib::Paths<T> open_subjects;
+    if (!flat_to_open_subjects(conv, line_points, line_offsets, as_rings, open_subjects)) {
+        return Array();
+    }
+
+    return solutions_to_flat(conv, intersect_open_subjects_with_clip_groups(
+        open_subjects,
+        registered_clip_groups(entry.paths_for(conv), indices),
+        pool), indices_to_ids(indices), 2);
+}
+
+Array Clipper2Open::intersect_many_polylines_with_registered_polygons_flat(
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    int handle,
+    const PackedInt32Array &indices) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_many_open_with_registered_polygons_flat_impl(conv, *entry, line_points, line_offsets, indices, false, get_pool());
+    });
+}
+
+Array Clipper2Open::intersect_many_ringpolylines_with_registered_polygons_flat(
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    int handle,
+    const PackedInt32Array &indices) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return intersect_many_open_with_registered_polygons_flat_impl(conv, *entry, line_points, line_offsets, indices, true, get_pool());
+    });
+}
+
+// Helper: union of every non-degenerate registered polygon, as difference clip
+template <typename T>
+static Clipper2Lib::Paths<T> registered_closed_union(const Clipper2Lib::Paths<T> &paths) {
+    Clipper2Lib::Paths<T> closed_union;
+    for (const auto &path : paths) {
+        if (path.size() < 3) continue;
+        closed_union.push_back(path);
+    }
+    return closed_union;
+}
+
+Array Clipper2Open::difference_many_polylines_with_registered_polygons(
+    const Array &polylines,
+    int handle) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return open_solution_to_godot_flat(conv, difference_open_subjects_with_clip_paths(
+            to_open_subjects(conv, polylines, false),
+            registered_closed_union(entry->paths_for(conv))));
+    });
+}
+
+Array Clipper2Open::difference_many_polylines_with_registered_polygons_flat(
+    const PackedVector2Array &line_points,
+    const PackedInt32Array &line_offsets,
+    int handle) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        using PathsT = std::decay_t<decltype(entry->paths_for(conv))>;
+        PathsT open_subjects;
+        if (!flat_to_open_subjects(conv, line_points, line_offsets, false, open_subjects)) {
+            return Array();
+        }
+        std::vector<PathsT> solutions(1, difference_open_subjects_with_clip_paths(
+            open_subjects,
+            registered_closed_union(entry->paths_for(conv))));
+        return solutions_to_flat(conv, solutions, std::vector<int32_t>(1, 0), 2);
+    });
+}
+
+// --- Static obstacles ---
+
+// Axis-aligned rectangle ring with Clipper's positive orientation (reversed: negative)
+template <typename T>
+static Clipper2Lib::Path<T> rect_ring(const PathConv<T> &conv, const Clipper2Lib::RectD &r, bool reversed) {
+    Clipper2Lib::Path<T> ring;
+    ring.push_back(conv.to_point(Vector2(r.left, r.top)));
+    ring.push_back(conv.to_point(Vector2(r.right, r.top)));
+    ring.push_back(conv.to_point(Vector2(r.right, r.bottom)));
+    ring.push_back(conv.to_point(Vector2(r.left, r.bottom)));
+    if (Clipper2Lib::IsPositive(ring) == reversed) {
+        std::reverse(ring.begin(), ring.end());
+    }
+    return ring;
+}
+
+template <typename T, typename Entry>
+static Array subtract_registered_obstacles_impl(
+    const PathConv<T> &conv,
+    const Entry &entry,
+    const Array &polygons,
+    WorkerPool *pool)
+{
+    std::vector<Clipper2Lib::Paths<T>> subjects(polygons.size());
+    std::vector<Clipper2Lib::RectD> subject_bounds(polygons.size());
+    for (int i = 0; i < polygons.size(); i++) {
+        PackedVector2Array polygon = polygons[i];
+        if (polygon.size() < 3) continue;
+        subjects[i].push_back(to_path_closed(conv, polygon));
+        subject_bounds[i] = polygon_bounds(polygon);
     }
 
-    return grouped_results;
+    const Clipper2Lib::Paths<T> &registered = entry.paths_for(conv);
+    std::vector<RingStructure<T>> solutions(subjects.size());
+    run_jobs(pool, subjects.size(), [&](size_t i) {
+        if (subjects[i].empty()) {
+            return;
+        }
+        // Only the obstacle rings whose bounds reach the subject take part
+        std::vector<int> candidates;
+        entry.grid.query(subject_bounds[i], candidates);
+        Clipper2Lib::Paths<T> clips;
+        clips.reserve(candidates.size() + 2);
+        for (int c : candidates) {
+            if (registered[c].size() < 3) continue;
+            clips.push_back(registered[c]);
+        }
+
+        // Outside the keep rect: a frame around it, sized to cover the subject
+        const Clipper2Lib::RectD &b = subject_bounds[i];
+        const Clipper2Lib::RectD &k = entry.keep_rect;
+        if (entry.has_keep_rect && (b.left < k.left || b.top < k.top || b.right > k.right || b.bottom > k.bottom)) {
+            Clipper2Lib::RectD frame(
+                std::min(b.left, k.left) - 1.0, std::min(b.top, k.top) - 1.0,
+                std::max(b.right, k.right) + 1.0, std::max(b.bottom, k.bottom) + 1.0
+            );
+            clips.push_back(rect_ring(conv, frame, false));
+            clips.push_back(rect_ring(conv, k, true));
+        }
+
+        execute_closed(Clipper2Lib::ClipType::Difference, subjects[i], clips, solutions[i]);
+    });
+
+    return closed_solutions_to_godot(conv, solutions);
+}
+
+Array Clipper2Open::subtract_registered_obstacles_batched(
+    const Array &polygons,
+    int handle) const
+{
+    const RegisteredPolygons *entry = get_registered(handle);
+    ERR_FAIL_NULL_V_MSG(entry, Array(), vformat("Unknown polygon registry handle %d", handle));
+
+    return with_active_mode([&](const auto &conv) {
+        return subtract_registered_obstacles_impl(conv, *entry, polygons, get_pool());
+    });
 }
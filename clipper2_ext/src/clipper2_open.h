@@ -3,13 +3,63 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "clipper2/clipper.h"
+#include "bounds_grid.h"
+#include "worker_pool.h"
 
 using namespace godot;
 
 class Clipper2Open : public RefCounted {
     GDCLASS(Clipper2Open, RefCounted);
 
+private:
+    // Static polygons converted once and kept natively (see register_polygons)
+    struct RegisteredPolygons {
+        Clipper2Lib::PathsD paths;
+        Clipper2Lib::Paths64 paths64; // paths * fixed_point_scale
+        std::vector<Clipper2Lib::RectD> bounds; // world units
+        BoundsGrid grid; // broadphase over bounds
+        // register_obstacles: everything outside keep_rect counts as obstacle too
+        bool has_keep_rect = false;
+        Clipper2Lib::RectD keep_rect;
+
+        template <typename Conv>
+        const auto &paths_for(const Conv &) const {
+            if constexpr (std::is_same_v<typename Conv::Engine, Clipper2Lib::Clipper64>) {
+                return paths64;
+            } else {
+                return paths;
+            }
+        }
+    };
+    std::unordered_map<int, RegisteredPolygons> registry;
+    int next_registry_handle = 1;
+
+    const RegisteredPolygons *get_registered(int handle) const;
+    void rescale_registered(RegisteredPolygons &entry) const;
+
+    // Fixed-point mode: Clipper64 on coordinates * scale, bit-identical across runs
+    bool fixed_point = false;
+    double fixed_point_scale = 100.0;
+
+    template <typename F>
+    auto with_active_mode(F &&f) const;
+    // Grid used to snap non-Clipper results in fixed-point mode (0 = off)
+    double get_snap_scale() const { return fixed_point ? fixed_point_scale : 0.0; }
+
+    // Set while parallel mode is on; batched jobs are spread over it
+    std::unique_ptr<WorkerPool> pool;
+    WorkerPool *get_pool() const { return pool.get(); }
+
 protected:
     static void _bind_methods();
 
@@ -26,11 +76,44 @@ public:
         const PackedVector2Array &polygon,
         double epsilon = 0.0) const;
 
+    // Flat layout (see path_convert.h): polylines are points[ring_offsets[i] ..
+    // ring_offsets[i + 1]), results come back as [points, ring_offsets, group_ids]
+    // with each chain under the group id of its polyline (ring index if empty)
+    Array intersect_many_polyline_with_polygon_deterministic_flat(
+        const PackedVector2Array &points,
+        const PackedInt32Array &ring_offsets,
+        const PackedInt32Array &group_ids,
+        const PackedVector2Array &polygon,
+        double epsilon = 0.0) const;
+
     // True batched polygon intersection using Clipper2's native batching
     Array intersect_polygons_batched(
         const Array &polygons,
         const PackedVector2Array &subject_polygon) const;
 
+    // Flat layout: rings sharing a group id form one clip shape, result rings
+    // come back under the group id of the clip that produced them
+    Array intersect_polygons_batched_flat(
+        const PackedVector2Array &points,
+        const PackedInt32Array &ring_offsets,
+        const PackedInt32Array &group_ids,
+        const PackedVector2Array &subject_polygon) const;
+
+    // Outer/hole variants of the closed booleans: where the plain call returns
+    // rings, these return [Array outers, Array holes, PackedInt32Array
+    // hole_parents] (hole_parents[i] = index in outers of the polygon hole i
+    // cuts into), taken from Clipper2's PolyTree.
+    Array intersect_polygons_batched_tree(
+        const Array &polygons,
+        const PackedVector2Array &subject_polygon) const;
+
+    // Any boolean of subject_polygons against clip_polygons (NonZero fill),
+    // operation takes Geometry2D.PolyBooleanOperation values
+    Array boolean_polygons_tree(
+        const Array &subject_polygons,
+        const Array &clip_polygons,
+        int operation) const;
+
     Array union_overlap(
         const PackedVector2Array &shared_border,
         const PackedVector2Array &polygon) const;
@@ -51,6 +134,182 @@ public:
     Array difference_many_polylines_with_polygons(
         const Array &polylines,
         const Array &polygons) const;
+
+    // Flat-layout versions of the three calls above. Polylines are given as
+    // points + ring offsets; polygons as points + ring offsets + group ids.
+    // Results are [points, ring_offsets, group_ids], pieces under the group id
+    // of their polygon (difference: everything under group 0).
+    Array intersect_many_polylines_with_polygons_flat(
+        const PackedVector2Array &line_points,
+        const PackedInt32Array &line_offsets,
+        const PackedVector2Array &polygon_points,
+        const PackedInt32Array &polygon_offsets,
+        const PackedInt32Array &polygon_group_ids) const;
+
+    Array intersect_many_ringpolylines_with_polygons_flat(
+        const PackedVector2Array &line_points,
+        const PackedInt32Array &line_offsets,
+        const PackedVector2Array &polygon_points,
+        const PackedInt32Array &polygon_offsets,
+        const PackedInt32Array &polygon_group_ids) const;
+
+    Array difference_many_polylines_with_polygons_flat(
+        const PackedVector2Array &line_points,
+        const PackedInt32Array &line_offsets,
+        const PackedVector2Array &polygon_points,
+        const PackedInt32Array &polygon_offsets) const;
+
+    // Union of many polygons (e.g. all areas of one owner) in one call: inputs
+    // whose bounds touch are unioned together, each such component in one sweep.
+    // Returns [Array outers, Array holes, PackedInt32Array hole_parents,
+    // PackedInt32Array input_outers] where input_outers[i] is the outer that
+    // polygons[i] ended up in (-1 for degenerate inputs, and with an error for
+    // inputs no outer absorbed). Runs on integers in both modes.
+    Array union_polygons_by_component(const Array &polygons) const;
+
+    // Batched offsetting (Clipper2 ClipperOffset): every path at every delta in
+    // one call, result k = path * deltas.size() + delta is
+    // [Array outers, Array holes, PackedInt32Array hole_parents]. join_type and
+    // end_type take Geometry2D.PolyJoinType / PolyEndType values; defaults match
+    // Geometry2D.offset_polygon / offset_polyline. Arc tolerance is in world units.
+    Array offset_polygons_batched(
+        const Array &polygons,
+        const PackedFloat32Array &deltas,
+        int join_type = 0,
+        double arc_tolerance = 0.25,
+        double miter_limit = 2.0) const;
+
+    Array offset_polylines_batched(
+        const Array &polylines,
+        const PackedFloat32Array &deltas,
+        int join_type = 0,
+        int end_type = 3,
+        double arc_tolerance = 0.25,
+        double miter_limit = 2.0) const;
+
+    // Fused contact detection between groups (e.g. owners): offsets every
+    // polygon by delta (round joins), intersects the offsets of every pair from
+    // different groups whose bounds touch, and measures how much of each
+    // overlap's boundary lies inside measure_polygons (holes count negatively;
+    // only pairs with a polygon of measure_group, -1 = all). Returns
+    // [Array offsets, PackedInt32Array first, PackedInt32Array second,
+    // PackedFloat64Array contact_lengths, Array overlaps], offsets and overlaps
+    // as [outers, holes, hole_parents]; only overlapping pairs, first < second.
+    Array collect_offset_overlaps(
+        const Array &polygons,
+        const PackedInt32Array &group_ids,
+        double delta,
+        const Array &measure_polygons,
+        int measure_group = -1,
+        double arc_tolerance = 0.25) const;
+
+    // Parallel mode: spread the independent jobs of the batched calls over a
+    // worker pool (thread_count <= 0 uses every core). Results keep input order.
+    void set_parallel(bool enabled, int thread_count = 0);
+    bool is_parallel() const;
+    int get_parallel_thread_count() const;
+
+    // Fixed-point mode: every clipping call snaps coordinates to a 1/scale grid and
+    // runs Clipper64 on integers, so results are exact and reproducible everywhere.
+    // The default scale matches the precision (2 decimals) of the double path.
+    void set_fixed_point(bool enabled, double scale = 100.0);
+    bool is_fixed_point() const;
+    double get_fixed_point_scale() const;
+
+    // Registry: convert static polygons (e.g. original walkable areas) once and
+    // refer to them by handle afterwards. Index i in queries is polygons[i].
+    int register_polygons(const Array &polygons);
+    void unregister_polygons(int handle);
+    void clear_registered_polygons();
+    int get_registered_polygon_count(int handle) const;
+    Rect2 get_registered_polygon_bounds(int handle, int index) const;
+
+    // Static obstacles: unioned once and registered ring by ring (outers and
+    // the holes of the union). With a keep_rect, the outside of it is an
+    // obstacle as well (the world boundary). Query with
+    // subtract_registered_obstacles_batched.
+    int register_obstacles(const Array &obstacles, const Rect2 &keep_rect = Rect2());
+
+    // Every polygon minus the registered obstacles, one difference per polygon
+    // against only the obstacle rings its bounds reach. One [Array outers,
+    // Array holes, PackedInt32Array hole_parents] per polygon.
+    Array subtract_registered_obstacles_batched(
+        const Array &polygons,
+        int handle) const;
+
+    // Same as intersect_polygons_batched, clip polygons taken from the registry.
+    // One result Array per entry in indices; bounds that miss the subject are skipped.
+    Array intersect_registered_polygons_batched(
+        int handle,
+        const PackedInt32Array &indices,
+        const PackedVector2Array &subject_polygon) const;
+
+    Array intersect_registered_polygons_batched_tree(
+        int handle,
+        const PackedInt32Array &indices,
+        const PackedVector2Array &subject_polygon) const;
+
+    // All subjects x all registered polygons in one call, using the registry's
+    // bounding-box grid as broadphase. Returns only non-empty intersections as
+    // [PackedInt32Array subject_indices, PackedInt32Array registered_indices,
+    // Array polygons_per_pair], ordered by subject, then registered index.
+    Array intersect_polygons_with_registered_polygons(
+        const Array &subject_polygons,
+        int handle) const;
+
+    // Same, polygons_per_pair holding one outer/hole structure per pair
+    Array intersect_polygons_with_registered_polygons_tree(
+        const Array &subject_polygons,
+        int handle) const;
+
+    // Same as intersect_many_polylines_with_polygons, polygons taken from the registry
+    Array intersect_many_polylines_with_registered_polygons(
+        const Array &polylines,
+        int handle,
+        const PackedInt32Array &indices) const;
+
+    // Same as intersect_many_ringpolylines_with_polygons, polygons taken from the registry
+    Array intersect_many_ringpolylines_with_registered_polygons(
+        const Array &polylines,
+        int handle,
+        const PackedInt32Array &indices) const;
+
+    // Same as difference_many_polylines_with_polygons against every registered polygon
+    Array difference_many_polylines_with_registered_polygons(
+        const Array &polylines,
+        int handle) const;
+
+    // Flat-layout versions of the registry queries; group ids of the results
+    // are registry indices
+    Array intersect_registered_polygons_batched_flat(
+        int handle,
+        const PackedInt32Array &indices,
+        const PackedVector2Array &subject_polygon) const;
+
+    // Returns [points, ring_offsets, subject_group_ids, registered_indices], one
+    // entry per result ring in the last two
+    Array intersect_polygons_with_registered_polygons_flat(
+        const PackedVector2Array &points,
+        const PackedInt32Array &ring_offsets,
+        const PackedInt32Array &group_ids,
+        int handle) const;
+
+    Array intersect_many_polylines_with_registered_polygons_flat(
+        const PackedVector2Array &line_points,
+        const PackedInt32Array &line_offsets,
+        int handle,
+        const PackedInt32Array &indices) const;
+
+    Array intersect_many_ringpolylines_with_registered_polygons_flat(
+        const PackedVector2Array &line_points,
+        const PackedInt32Array &line_offsets,
+        int handle,
+        const PackedInt32Array &indices) const;
+
+    Array difference_many_polylines_with_registered_polygons_flat(
+        const PackedVector2Array &line_points,
+        const PackedInt32Array &line_offsets,
+        int handle) const;
 };
 
 #endif // CLIPPER2_OPEN_H
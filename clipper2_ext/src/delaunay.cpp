@@ -0,0 +1,255 @@
+#include "delaunay.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+void Delaunay::init(const std::vector<DPoint> &seeds, double min_x, double min_y, double max_x, double max_y) {
+    seed_count = static_cast<int>(seeds.size());
+    points = seeds;
+    const double span = std::max(max_x - min_x, max_y - min_y) + 1.0;
+    const double margin = span * 10.0;
+    points.push_back({ min_x - margin, min_y - margin });
+    points.push_back({ max_x + margin, min_y - margin });
+    points.push_back({ max_x + margin, max_y + margin });
+    points.push_back({ min_x - margin, max_y + margin });
+    const int g = seed_count;
+    triangles.push_back({ { g, g + 1, g + 2 }, { -1, 1, -1 }, true });
+    triangles.push_back({ { g, g + 2, g + 3 }, { -1, -1, 0 }, true });
+    vertex_triangle.assign(points.size(), -1);
+    vertex_triangle[g] = 0;
+    vertex_triangle[g + 1] = 0;
+    vertex_triangle[g + 2] = 0;
+    vertex_triangle[g + 3] = 1;
+    new_by_start.assign(points.size(), -1);
+}
+
+int Delaunay::add_point(const DPoint &p) {
+    points.push_back(p);
+    vertex_triangle.push_back(-1);
+    new_by_start.push_back(-1);
+    return static_cast<int>(points.size()) - 1;
+}
+
+int Delaunay::locate(const DPoint &p) {
+    int t = last;
+    int rotate = 0;
+    for (size_t steps = 0; steps < triangles.size() * 2 + 16; steps++) {
+        const Triangle &tri = triangles[t];
+        int next = -1;
+        for (int e = 0; e < 3 && next < 0; e++) {
+            int i = (e + rotate) % 3;
+            if (tri.n[i] >= 0 && orient(points[tri.v[(i + 1) % 3]], points[tri.v[(i + 2) % 3]], p) < 0.0) {
+                next = tri.n[i];
+            }
+        }
+        if (next < 0) {
+            return t;
+        }
+        t = next;
+        rotate++;
+    }
+    // The walk cycled on a numerically flat triangle; scan instead
+    for (int i = 0; i < static_cast<int>(triangles.size()); i++) {
+        const Triangle &tri = triangles[i];
+        if (tri.alive
+                && orient(points[tri.v[0]], points[tri.v[1]], p) >= 0.0
+                && orient(points[tri.v[1]], points[tri.v[2]], p) >= 0.0
+                && orient(points[tri.v[2]], points[tri.v[0]], p) >= 0.0) {
+            return i;
+        }
+    }
+    return t;
+}
+
+void Delaunay::add_to_cavity(int t) {
+    cavity_mark[t] = stamp;
+    cavity.push_back(t);
+}
+
+bool Delaunay::insert(int p) {
+    const DPoint &pt = points[p];
+    const int start = locate(pt);
+    for (int k = 0; k < 3; k++) {
+        if (points[triangles[start].v[k]] == pt) {
+            return false;
+        }
+    }
+
+    stamp++;
+    cavity_mark.resize(triangles.size(), 0);
+    cavity.clear();
+    add_to_cavity(start);
+    for (size_t c = 0; c < cavity.size(); c++) {
+        const Triangle &tri = triangles[cavity[c]];
+        for (int i = 0; i < 3; i++) {
+            int nb = tri.n[i];
+            if (nb < 0 || in_cavity(nb)) continue;
+            const Triangle &other = triangles[nb];
+            if (in_circle(points[other.v[0]], points[other.v[1]], points[other.v[2]], pt) > 0.0) {
+                add_to_cavity(nb);
+            }
+        }
+    }
+
+    // The cavity must be star-shaped from p; swallow the neighbours of
+    // boundary edges that rounding left facing away from it
+    bool grown = true;
+    while (grown) {
+        grown = false;
+        boundary.clear();
+        for (int c : cavity) {
+            const Triangle &tri = triangles[c];
+            for (int i = 0; i < 3; i++) {
+                if (in_cavity(tri.n[i])) continue;
+                BoundaryEdge edge = { tri.v[(i + 1) % 3], tri.v[(i + 2) % 3], tri.n[i] };
+                if (edge.outside >= 0 && orient(points[edge.a], points[edge.b], pt) <= 0.0) {
+                    add_to_cavity(edge.outside);
+                    grown = true;
+                    break;
+                }
+                boundary.push_back(edge);
+            }
+            if (grown) break;
+        }
+    }
+
+    // Fan the cavity boundary around p, reusing the cavity slots first
+    std::vector<int> created;
+    created.reserve(boundary.size());
+    for (int c : cavity) {
+        triangles[c].alive = false;
+        free_triangles.push_back(c);
+    }
+    for (const BoundaryEdge &edge : boundary) {
+        int t;
+        if (!free_triangles.empty()) {
+            t = free_triangles.back();
+            free_triangles.pop_back();
+        } else {
+            t = static_cast<int>(triangles.size());
+            triangles.push_back({});
+        }
+        triangles[t] = { { edge.a, edge.b, p }, { -1, -1, edge.outside }, true };
+        if (edge.outside >= 0) {
+            Triangle &outside = triangles[edge.outside];
+            for (int j = 0; j < 3; j++) {
+                if (outside.v[(j + 1) % 3] == edge.b && outside.v[(j + 2) % 3] == edge.a) {
+                    outside.n[j] = t;
+                }
+            }
+        }
+        new_by_start[edge.a] = t;
+        created.push_back(t);
+        if (touched) {
+            touched->push_back(t);
+        }
+    }
+    for (int t : created) {
+        Triangle &tri = triangles[t];
+        int next = new_by_start[tri.v[1]];
+        tri.n[0] = next;
+        triangles[next].n[1] = t;
+    }
+    for (int t : created) {
+        const Triangle &tri = triangles[t];
+        new_by_start[tri.v[0]] = -1;
+        vertex_triangle[tri.v[0]] = t;
+        vertex_triangle[tri.v[1]] = t;
+    }
+    vertex_triangle[p] = created.front();
+    last = created.front();
+    return true;
+}
+
+void Delaunay::flip(int t, int i, std::vector<uint8_t> *edge_flags) {
+    const int u = triangles[t].n[i];
+    int j = 0;
+    while (triangles[u].n[j] != t) {
+        j++;
+    }
+    // Quad p, q, r, s counter-clockwise; t = (p, q, s), u = (r, s, q)
+    const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+    const int p = triangles[t].v[i], q = triangles[t].v[i1], s = triangles[t].v[i2];
+    const int r = triangles[u].v[j];
+    const int across_qr = triangles[u].n[j1];
+    const int across_pq = triangles[t].n[i2];
+    const int across_rs = triangles[u].n[j2];
+    const int across_sp = triangles[t].n[i1];
+    uint8_t flag_qr = 0, flag_pq = 0, flag_rs = 0, flag_sp = 0;
+    if (edge_flags) {
+        flag_qr = (*edge_flags)[3 * u + j1];
+        flag_pq = (*edge_flags)[3 * t + i2];
+        flag_rs = (*edge_flags)[3 * u + j2];
+        flag_sp = (*edge_flags)[3 * t + i1];
+    }
+
+    triangles[t] = { { p, q, r }, { across_qr, u, across_pq }, true };
+    triangles[u] = { { p, r, s }, { across_rs, across_sp, t }, true };
+    if (edge_flags) {
+        uint8_t *f = edge_flags->data();
+        f[3 * t] = flag_qr;
+        f[3 * t + 1] = 0;
+        f[3 * t + 2] = flag_pq;
+        f[3 * u] = flag_rs;
+        f[3 * u + 1] = flag_sp;
+        f[3 * u + 2] = 0;
+    }
+    auto relink = [&](int outside, int from, int to) {
+        if (outside < 0) return;
+        for (int k = 0; k < 3; k++) {
+            if (triangles[outside].n[k] == from) {
+                triangles[outside].n[k] = to;
+            }
+        }
+    };
+    relink(across_qr, u, t);
+    relink(across_sp, t, u);
+    vertex_triangle[p] = t;
+    vertex_triangle[q] = t;
+    vertex_triangle[r] = t;
+    vertex_triangle[s] = u;
+    last = t;
+    if (touched) {
+        touched->push_back(t);
+        touched->push_back(u);
+    }
+}
+
+DPoint Delaunay::circumcenter(const Triangle &tri) const {
+    const DPoint &a = points[tri.v[0]];
+    const DPoint &b = points[tri.v[1]];
+    const DPoint &c = points[tri.v[2]];
+    const double bx = b.x - a.x, by = b.y - a.y;
+    const double cx = c.x - a.x, cy = c.y - a.y;
+    const double d = 2.0 * (bx * cy - by * cx);
+    if (d == 0.0) {
+        return { (a.x + b.x + c.x) / 3.0, (a.y + b.y + c.y) / 3.0 };
+    }
+    const double b2 = bx * bx + by * by;
+    const double c2 = cx * cx + cy * cy;
+    return { a.x + (cy * b2 - by * c2) / d, a.y + (bx * c2 - cx * b2) / d };
+}
+
+std::vector<int> insertion_order(const std::vector<DPoint> &seeds, double min_y, double max_y) {
+    const int count = static_cast<int>(seeds.size());
+    const int bands = std::max(1, static_cast<int>(std::sqrt(count * 0.5)));
+    const double height = std::max(max_y - min_y, 1e-9);
+    std::vector<std::pair<int, int>> keyed(count);
+    for (int i = 0; i < count; i++) {
+        int band = std::clamp(static_cast<int>((seeds[i].y - min_y) / height * bands), 0, bands - 1);
+        keyed[i] = { band, i };
+    }
+    std::sort(keyed.begin(), keyed.end(), [&](const std::pair<int, int> &l, const std::pair<int, int> &r) {
+        if (l.first != r.first) return l.first < r.first;
+        const double lx = seeds[l.second].x;
+        const double rx = seeds[r.second].x;
+        if (lx != rx) return (l.first % 2 == 0) ? lx < rx : lx > rx;
+        return l.second < r.second;
+    });
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++) {
+        order[i] = keyed[i].second;
+    }
+    return order;
+}
@@ -0,0 +1,83 @@
+#ifndef DELAUNAY_H
+#define DELAUNAY_H
+
+#include <cstdint>
+#include <vector>
+
+// Incremental Delaunay triangulation in doubles (Bowyer-Watson with cavity
+// repair), shared by VoronoiDiagram and NavmeshBuilder.
+
+struct DPoint {
+    double x, y;
+    bool operator==(const DPoint &o) const { return x == o.x && y == o.y; }
+};
+
+inline double orient(const DPoint &a, const DPoint &b, const DPoint &c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Positive when d lies inside the circumcircle of the counter-clockwise a, b, c
+inline double in_circle(const DPoint &a, const DPoint &b, const DPoint &c, const DPoint &d) {
+    const double adx = a.x - d.x, ady = a.y - d.y;
+    const double bdx = b.x - d.x, bdy = b.y - d.y;
+    const double cdx = c.x - d.x, cdy = c.y - d.y;
+    return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+        + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+        + (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+}
+
+struct Triangle {
+    int v[3];    // counter-clockwise
+    int n[3];    // neighbour across the edge opposite v[i], -1 on the hull
+    bool alive;
+};
+
+// The seeds are inserted into a square far outside both the seeds and the
+// given bounds, so every seed is interior (closed vertex ring). The square's
+// corners are the points after the seeds.
+struct Delaunay {
+    std::vector<DPoint> points;
+    std::vector<Triangle> triangles;
+    std::vector<int> vertex_triangle;
+    std::vector<int> free_triangles;
+    std::vector<int> cavity_mark;
+    std::vector<int> new_by_start;
+    int stamp = 0;
+    int last = 0;
+    int seed_count = 0;
+
+    // When set, every triangle insert creates and every flip rewrites is
+    // appended, so callers can repair just those
+    std::vector<int> *touched = nullptr;
+
+    // Scratch reused across insertions
+    std::vector<int> cavity;
+    struct BoundaryEdge {
+        int a, b, outside;
+    };
+    std::vector<BoundaryEdge> boundary;
+
+    void init(const std::vector<DPoint> &seeds, double min_x, double min_y, double max_x, double max_y);
+    int locate(const DPoint &p);
+    bool in_cavity(int t) const { return t >= 0 && cavity_mark[t] == stamp; }
+    void add_to_cavity(int t);
+
+    // Appends a point after init, returns its index for insert
+    int add_point(const DPoint &p);
+
+    // False for a seed repeating an earlier one
+    bool insert(int p);
+
+    // Replaces the edge opposite v[i] of triangle t by the other diagonal of
+    // the quad it forms with its neighbour. Afterwards t holds v[i], the next
+    // vertex and the neighbour's far vertex, the neighbour the rest; edge
+    // flags (three per triangle, when sized) move with their edges.
+    void flip(int t, int i, std::vector<uint8_t> *edge_flags = nullptr);
+
+    DPoint circumcenter(const Triangle &tri) const;
+};
+
+// Insertion along a serpentine over row bands keeps the point-location walks short
+std::vector<int> insertion_order(const std::vector<DPoint> &seeds, double min_y, double max_y);
+
+#endif // DELAUNAY_H
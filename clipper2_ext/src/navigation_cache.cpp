@@ -0,0 +1,559 @@
+#include "navigation_cache.h"
+#include "polygon_queries.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+using namespace godot;
+
+void NavigationCache::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("set_end_cell_size", "size"),
+        &NavigationCache::set_end_cell_size
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_obstacles", "outlines"),
+        &NavigationCache::set_obstacles
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("update_area", "key", "version", "polygon"),
+        &NavigationCache::update_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("remove_area", "key"),
+        &NavigationCache::remove_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("has_area", "key"),
+        &NavigationCache::has_area
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear"),
+        &NavigationCache::clear
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("route", "indices", "keys", "from", "to"),
+        &NavigationCache::route
+    );
+}
+
+static double cross(const Vector2 &a, const Vector2 &b) {
+    return static_cast<double>(a.x) * b.y - static_cast<double>(a.y) * b.x;
+}
+
+// Sign of cross(b - a, p - a), zero within a tolerance relative to the lengths
+static int orientation(const Vector2 &a, const Vector2 &b, const Vector2 &p) {
+    const double value = cross(b - a, p - a);
+    const double tolerance = 1e-9 * (static_cast<double>((b - a).length()) * (p - a).length()) + 1e-12;
+    return value > tolerance ? 1 : (value < -tolerance ? -1 : 0);
+}
+
+// p on segment a-b, given it is collinear
+static bool within(const Vector2 &a, const Vector2 &b, const Vector2 &p) {
+    return p.x >= std::min(a.x, b.x) && p.x <= std::max(a.x, b.x)
+            && p.y >= std::min(a.y, b.y) && p.y <= std::max(a.y, b.y);
+}
+
+// ---------------------------------------------------------------------------
+// Area geometry
+// ---------------------------------------------------------------------------
+
+bool NavigationCache::AreaNav::in_domain(const Vector2 &point) const {
+    for (size_t r = 0; r + 1 < ring_start.size(); r++) {
+        const bool inside = polygon_contains_point(points.data() + ring_start[r], ring_start[r + 1] - ring_start[r],
+                ring_min[r], ring_max[r], point);
+        if (inside != (r == 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether leaving ring vertex v along direction stays on the walkable side
+// (interior on the left of both edges; either edge for reflex vertices)
+bool NavigationCache::AreaNav::in_wedge(int vertex, const Vector2 &direction) const {
+    const Vector2 &u = points[vertex];
+    const bool left_of_prev = cross(u - points[prev_vertex[vertex]], direction) >= 0.0;
+    const bool left_of_next = cross(points[next_vertex[vertex]] - u, direction) >= 0.0;
+    return reflex[vertex] ? (left_of_prev || left_of_next) : (left_of_prev && left_of_next);
+}
+
+// Segment from-to stays walkable: no edge crosses it properly, it leaves the
+// ring vertices it starts or ends on (>= 0) on their walkable side, and if it
+// grazes any other vertex or edge its midpoint is walkable. Both ends are
+// assumed walkable.
+bool NavigationCache::AreaNav::visible(const Vector2 &from, const Vector2 &to, int from_vertex, int to_vertex) const {
+    if (from_vertex >= 0 && !in_wedge(from_vertex, to - from)) {
+        return false;
+    }
+    if (to_vertex >= 0 && !in_wedge(to_vertex, from - to)) {
+        return false;
+    }
+
+    if (++stamp == 0) {
+        std::fill(edge_stamp.begin(), edge_stamp.end(), 0);
+        stamp = 1;
+    }
+    auto cell_x = [&](real_t x) { return std::clamp(static_cast<int>((x - grid_origin.x) / cell_size.x), 0, cols - 1); };
+    auto cell_y = [&](real_t y) { return std::clamp(static_cast<int>((y - grid_origin.y) / cell_size.y), 0, rows - 1); };
+    const int y0 = cell_y(std::min(from.y, to.y)), y1 = cell_y(std::max(from.y, to.y));
+    const Vector2 delta = to - from;
+    const Vector2 box_min = from.min(to);
+    const Vector2 box_max = from.max(to);
+
+    // Touching at a vertex end is covered by the wedge test above
+    auto grazes = [&](const Vector2 &p) {
+        return !((from_vertex >= 0 && p == from) || (to_vertex >= 0 && p == to));
+    };
+    bool grazed = false;
+    for (int y = y0; y <= y1; y++) {
+        // Only the cells the segment crosses within this row's band; the
+        // outer rows also hold everything beyond the grid
+        real_t t0 = 0.0f, t1 = 1.0f;
+        if (delta.y != 0.0f) {
+            const real_t lo = y == 0 ? -INFINITY : grid_origin.y + y * cell_size.y;
+            const real_t hi = y == rows - 1 ? INFINITY : grid_origin.y + (y + 1) * cell_size.y;
+            const real_t ta = (lo - from.y) / delta.y;
+            const real_t tb = (hi - from.y) / delta.y;
+            t0 = std::max<real_t>(t0, std::min(ta, tb));
+            t1 = std::min<real_t>(t1, std::max(ta, tb));
+        }
+        const real_t xa = from.x + delta.x * t0;
+        const real_t xb = from.x + delta.x * t1;
+        const real_t pad = 1e-3f * cell_size.x;
+        const int x0 = cell_x(std::min(xa, xb) - pad), x1 = cell_x(std::max(xa, xb) + pad);
+        for (int x = x0; x <= x1; x++) {
+            const int c = y * cols + x;
+            for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                const int e = cell_edges[k];
+                if (edge_stamp[e] == stamp) continue;
+                edge_stamp[e] = stamp;
+
+                // Edges outside the segment's box can neither cross nor touch it
+                const Segment &edge = edges[e];
+                if (std::max(edge.a.x, edge.b.x) < box_min.x || std::min(edge.a.x, edge.b.x) > box_max.x
+                        || std::max(edge.a.y, edge.b.y) < box_min.y || std::min(edge.a.y, edge.b.y) > box_max.y) {
+                    continue;
+                }
+                const int o1 = orientation(from, to, edge.a);
+                const int o2 = orientation(from, to, edge.b);
+                if (o1 * o2 > 0) {
+                    // Both ends strictly on one side: no crossing, and neither
+                    // segment end can lie on the edge
+                    continue;
+                }
+                const int o3 = orientation(edge.a, edge.b, from);
+                const int o4 = orientation(edge.a, edge.b, to);
+                if (o1 * o2 < 0 && o3 * o4 < 0) {
+                    return false;
+                }
+                if (grazed) continue;
+                grazed = (o1 == 0 && within(from, to, edge.a) && grazes(edge.a))
+                        || (o2 == 0 && within(from, to, edge.b) && grazes(edge.b))
+                        || (o3 == 0 && within(edge.a, edge.b, from) && grazes(from))
+                        || (o4 == 0 && within(edge.a, edge.b, to) && grazes(to));
+            }
+        }
+    }
+    return !grazed || in_domain((from + to) * 0.5f);
+}
+
+void NavigationCache::AreaNav::build(const PackedVector2Array &polygon, const std::vector<std::vector<Vector2>> &p_obstacles) {
+    points.clear();
+    ring_start.assign(1, 0);
+    ring_min.clear();
+    ring_max.clear();
+    prev_vertex.clear();
+    next_vertex.clear();
+    reflex.clear();
+    edges.clear();
+    cell_start.clear();
+    cell_edges.clear();
+    corners.clear();
+    corner_visible.clear();
+    end_fields.clear();
+    cols = 0;
+    rows = 0;
+
+    // Consecutive duplicates dropped, oriented so walkable is on the left
+    auto add_ring = [&](const Vector2 *src, int count, bool outer) {
+        std::vector<Vector2> ring;
+        for (int i = 0; i < count; i++) {
+            if (ring.empty() || src[i] != ring.back()) {
+                ring.push_back(src[i]);
+            }
+        }
+        while (ring.size() > 1 && ring.front() == ring.back()) {
+            ring.pop_back();
+        }
+        if (ring.size() < 3) {
+            return false;
+        }
+        double area = 0.0;
+        Vector2 min = ring[0], max = ring[0];
+        for (size_t i = 0; i < ring.size(); i++) {
+            area += cross(ring[i], ring[(i + 1) % ring.size()]);
+            min = min.min(ring[i]);
+            max = max.max(ring[i]);
+        }
+        if (!outer && (max.x < ring_min[0].x || max.y < ring_min[0].y || min.x > ring_max[0].x || min.y > ring_max[0].y)) {
+            return false;
+        }
+        if ((area > 0.0) != outer) {
+            std::reverse(ring.begin(), ring.end());
+        }
+        const int start = static_cast<int>(points.size());
+        const int n = static_cast<int>(ring.size());
+        for (int i = 0; i < n; i++) {
+            points.push_back(ring[i]);
+            prev_vertex.push_back(start + (i + n - 1) % n);
+            next_vertex.push_back(start + (i + 1) % n);
+            edges.push_back({ ring[i], ring[(i + 1) % n] });
+        }
+        ring_start.push_back(static_cast<int>(points.size()));
+        ring_min.push_back(min);
+        ring_max.push_back(max);
+        return true;
+    };
+    if (!add_ring(polygon.ptr(), static_cast<int>(polygon.size()), true)) {
+        return;
+    }
+    for (const std::vector<Vector2> &obstacle : p_obstacles) {
+        add_ring(obstacle.data(), static_cast<int>(obstacle.size()), false);
+    }
+
+    // Edge grid, about one edge per cell
+    Vector2 min = ring_min[0], max = ring_max[0];
+    for (size_t r = 1; r < ring_min.size(); r++) {
+        min = min.min(ring_min[r]);
+        max = max.max(ring_max[r]);
+    }
+    const int side = std::clamp(static_cast<int>(std::sqrt(static_cast<double>(edges.size()))), 1, 64);
+    cols = side;
+    rows = side;
+    grid_origin = min;
+    cell_size = Vector2(std::max<real_t>((max.x - min.x) / cols, 1e-3f), std::max<real_t>((max.y - min.y) / rows, 1e-3f));
+    auto cell_x = [&](real_t x) { return std::clamp(static_cast<int>((x - grid_origin.x) / cell_size.x), 0, cols - 1); };
+    auto cell_y = [&](real_t y) { return std::clamp(static_cast<int>((y - grid_origin.y) / cell_size.y), 0, rows - 1); };
+    cell_start.assign(static_cast<size_t>(cols) * rows + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<int> cursor;
+        if (pass == 1) {
+            for (size_t c = 1; c < cell_start.size(); c++) {
+                cell_start[c] += cell_start[c - 1];
+            }
+            cell_edges.resize(cell_start.back());
+            cursor.assign(cell_start.begin(), cell_start.end() - 1);
+        }
+        for (int e = 0; e < static_cast<int>(edges.size()); e++) {
+            const Segment &edge = edges[e];
+            for (int y = cell_y(std::min(edge.a.y, edge.b.y)); y <= cell_y(std::max(edge.a.y, edge.b.y)); y++) {
+                for (int x = cell_x(std::min(edge.a.x, edge.b.x)); x <= cell_x(std::max(edge.a.x, edge.b.x)); x++) {
+                    const size_t c = static_cast<size_t>(y) * cols + x;
+                    if (pass == 0) {
+                        cell_start[c + 1]++;
+                    } else {
+                        cell_edges[cursor[c]++] = e;
+                    }
+                }
+            }
+        }
+    }
+    edge_stamp.assign(edges.size(), 0);
+    stamp = 0;
+
+    // Reflex corners that are walkable themselves
+    reflex.resize(points.size());
+    for (int v = 0; v < static_cast<int>(points.size()); v++) {
+        const Vector2 &u = points[v];
+        reflex[v] = cross(u - points[prev_vertex[v]], points[next_vertex[v]] - u) < 0.0;
+        if (!reflex[v]) continue;
+        bool walkable = true;
+        for (size_t r = 0; r + 1 < ring_start.size() && walkable; r++) {
+            if (v >= ring_start[r] && v < ring_start[r + 1]) continue;
+            const bool inside = polygon_contains_point(points.data() + ring_start[r], ring_start[r + 1] - ring_start[r],
+                    ring_min[r], ring_max[r], u);
+            walkable = inside == (r == 0);
+        }
+        if (walkable) {
+            corners.push_back(v);
+        }
+    }
+
+    corner_visible.resize(corners.size());
+}
+
+// Whether the line through ring vertex v and point stays on one side of the
+// vertex's two edges; a shortest path can only bend around v along it
+bool NavigationCache::AreaNav::tangent(int vertex, const Vector2 &point) const {
+    const Vector2 &u = points[vertex];
+    return orientation(point, u, points[prev_vertex[vertex]]) * orientation(point, u, points[next_vertex[vertex]]) >= 0;
+}
+
+// Corner pair visibility, tested on first use and kept for both corners.
+// Pairs not tangent at both corners count as blocked: no shortest path uses
+// them (reduced visibility graph).
+bool NavigationCache::AreaNav::corners_see(int a, int b) const {
+    std::vector<uint8_t> &row_a = corner_visible[a];
+    std::vector<uint8_t> &row_b = corner_visible[b];
+    if (row_a.empty()) {
+        row_a.assign(corners.size(), VISIBILITY_UNKNOWN);
+    }
+    if (row_a[b] == VISIBILITY_UNKNOWN) {
+        if (row_b.empty()) {
+            row_b.assign(corners.size(), VISIBILITY_UNKNOWN);
+        }
+        const Vector2 &pa = points[corners[a]];
+        const Vector2 &pb = points[corners[b]];
+        const bool seen = tangent(corners[a], pb) && tangent(corners[b], pa) && visible(pa, pb, corners[a], corners[b]);
+        const uint8_t state = seen ? VISIBILITY_SEEN : VISIBILITY_BLOCKED;
+        row_a[b] = state;
+        row_b[a] = state;
+    }
+    return row_a[b] == VISIBILITY_SEEN;
+}
+
+// Exact point key; -0.0 and 0.0 compare equal, so they hash equal too
+static uint64_t point_key(const Vector2 &v) {
+    float x = v.x == 0.0f ? 0.0f : v.x;
+    float y = v.y == 0.0f ? 0.0f : v.y;
+    uint32_t xb, yb;
+    std::memcpy(&xb, &x, sizeof(xb));
+    std::memcpy(&yb, &y, sizeof(yb));
+    return (static_cast<uint64_t>(xb) << 32) | yb;
+}
+
+// Ends cached per area before the cache starts over
+static constexpr size_t MAX_END_FIELDS = 1024;
+
+NavigationCache::AreaNav::EndField &NavigationCache::AreaNav::end_field(const Vector2 &to, double cell_size) const {
+    uint64_t key;
+    if (cell_size > 0.0) {
+        const int64_t cx = static_cast<int64_t>(std::floor(to.x / cell_size));
+        const int64_t cy = static_cast<int64_t>(std::floor(to.y / cell_size));
+        key = (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    } else {
+        key = point_key(to);
+    }
+    auto it = end_fields.find(key);
+    if (it != end_fields.end()) {
+        return it->second;
+    }
+    if (end_fields.size() >= MAX_END_FIELDS) {
+        end_fields.clear();
+    }
+
+    const int n = static_cast<int>(corners.size());
+    EndField &field = end_fields[key];
+    field.end = to;
+    field.distance.assign(n, std::numeric_limits<float>::infinity());
+    field.next.assign(n, -1);
+    field.exit.assign(n, -1);
+    field.end_tested.assign(n, 0);
+    field.settled.assign(n, 0);
+    field.settled_order.reserve(n);
+    field.key.resize(n);
+    for (int j = 0; j < n; j++) {
+        field.key[j] = points[corners[j]].distance_to(to);
+    }
+    return field;
+}
+
+// Settles one more corner of the field. Until its line of sight to the end is
+// tested, a corner's key is its straight distance to the end, a lower bound
+// of any path from it. Returns false once nothing reachable is left.
+bool NavigationCache::AreaNav::settle_next(EndField &field) const {
+    const int n = static_cast<int>(corners.size());
+    const float inf = std::numeric_limits<float>::infinity();
+    while (!field.exhausted) {
+        int u = -1;
+        float best = inf;
+        for (int j = 0; j < n; j++) {
+            if (field.key[j] < best) {
+                best = field.key[j];
+                u = j;
+            }
+        }
+        if (u < 0) {
+            field.exhausted = true;
+            break;
+        }
+
+        const Vector2 &corner = points[corners[u]];
+        if (!field.end_tested[u]) {
+            field.end_tested[u] = 1;
+            if (visible(corner, field.end, corners[u], -1)) {
+                field.distance[u] = best;
+                field.next[u] = -1;
+                field.exit[u] = u;
+            }
+            field.key[u] = field.distance[u];
+            continue;
+        }
+
+        field.settled[u] = 1;
+        field.key[u] = inf;
+        field.settled_order.push_back(u);
+        field.radius = best;
+        for (int k = 0; k < n; k++) {
+            // A path through u is at least best long; line of sight only
+            // matters when it is shorter
+            if (field.settled[k] || field.distance[k] <= best) continue;
+            const float total = best + corner.distance_to(points[corners[k]]);
+            if (total < field.distance[k] && corners_see(u, k)) {
+                field.distance[k] = total;
+                field.next[k] = u;
+                field.exit[k] = field.exit[u];
+                if (field.end_tested[k]) {
+                    field.key[k] = total;
+                }
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+// Shortest path is direct or enters the corner graph at a corner visible from
+// the start. Settled corners are popped in order of their path length through
+// them; a pop no longer than the field radius beats every unsettled corner, so
+// the first visible one is the best entry. Falls back to the straight line
+// when no route exists (an end outside the area).
+void NavigationCache::AreaNav::route(const Vector2 &from, const Vector2 &to, double cell_size, Vector2 &r_waypoint, float &r_length) const {
+    r_waypoint = to;
+    r_length = from.distance_to(to);
+    if (ring_start.size() < 2 || visible(from, to, -1, -1)) {
+        return;
+    }
+
+    EndField &field = end_field(to, cell_size);
+    auto total = [&](int i) {
+        return std::pair<float, int>(from.distance_to(points[corners[i]]) + field.distance[i], i);
+    };
+    auto later = std::greater<std::pair<float, int>>();
+    order.clear();
+    for (int i : field.settled_order) {
+        order.push_back(total(i));
+    }
+    std::make_heap(order.begin(), order.end(), later);
+
+    int entry = -1;
+    for (;;) {
+        if (order.empty() || (order.front().first > field.radius && !field.exhausted)) {
+            if (!settle_next(field)) {
+                if (order.empty()) break;
+                continue;
+            }
+            order.push_back(total(field.settled_order.back()));
+            std::push_heap(order.begin(), order.end(), later);
+            continue;
+        }
+        std::pop_heap(order.begin(), order.end(), later);
+        const int i = order.back().second;
+        order.pop_back();
+        if (visible(from, points[corners[i]], -1, corners[i])) {
+            entry = i;
+            break;
+        }
+    }
+    if (entry < 0) {
+        return;
+    }
+
+    // The field ends at the cell's first end; swap its last leg for one to
+    // this end
+    const Vector2 &exit = points[corners[field.exit[entry]]];
+    r_length = from.distance_to(points[corners[entry]]) + field.distance[entry]
+            - exit.distance_to(field.end) + exit.distance_to(to);
+
+    int next = entry;
+    // Standing on the entry corner already: head for the one after it
+    if (points[corners[next]].distance_squared_to(from) < 1e-8f) {
+        next = field.next[entry];
+        if (next < 0) {
+            r_waypoint = to;
+            return;
+        }
+    }
+    r_waypoint = points[corners[next]];
+}
+
+// ---------------------------------------------------------------------------
+// Cache
+// ---------------------------------------------------------------------------
+
+void NavigationCache::set_end_cell_size(double size) {
+    end_cell_size = std::max(size, 0.0);
+}
+
+bool NavigationCache::set_obstacles(const Array &outlines) {
+    std::vector<std::vector<Vector2>> next(outlines.size());
+    for (int i = 0; i < outlines.size(); i++) {
+        PackedVector2Array outline = outlines[i];
+        next[i].assign(outline.ptr(), outline.ptr() + outline.size());
+    }
+    if (next == obstacles) {
+        return false;
+    }
+    obstacles = std::move(next);
+    obstacles_version++;
+    return true;
+}
+
+bool NavigationCache::update_area(int64_t key, int64_t version, const PackedVector2Array &polygon) {
+    AreaNav &area = areas[key];
+    if (area.version == version && area.obstacles_version == obstacles_version) {
+        return false;
+    }
+    area.build(polygon, obstacles);
+    area.version = version;
+    area.obstacles_version = obstacles_version;
+    return true;
+}
+
+void NavigationCache::remove_area(int64_t key) {
+    areas.erase(key);
+}
+
+bool NavigationCache::has_area(int64_t key) const {
+    return areas.count(key) != 0;
+}
+
+void NavigationCache::clear() {
+    areas.clear();
+}
+
+Array NavigationCache::route(const PackedInt32Array &indices, const PackedInt64Array &keys,
+        const PackedVector2Array &from, const PackedVector2Array &to) const {
+    Array result;
+    const int64_t n = from.size();
+    ERR_FAIL_COND_V_MSG(keys.size() != n || to.size() != n, result, "Keys, starts and ends must have the same size");
+
+    PackedVector2Array waypoints;
+    PackedFloat32Array lengths;
+    waypoints.resize(n);
+    lengths.resize(n);
+    Vector2 *waypoint = waypoints.ptrw();
+    float *length = lengths.ptrw();
+    std::fill(length, length + n, std::numeric_limits<float>::quiet_NaN());
+
+    for (int k = 0; k < indices.size(); k++) {
+        const int i = indices[k];
+        ERR_CONTINUE_MSG(i < 0 || i >= n, vformat("Route index %d is out of range", i));
+        auto it = areas.find(keys[i]);
+        if (it == areas.end()) continue;
+        it->second.route(from[i], to[i], end_cell_size, waypoint[i], length[i]);
+    }
+    result.push_back(waypoints);
+    result.push_back(lengths);
+    return result;
+}
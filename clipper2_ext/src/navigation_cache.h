@@ -0,0 +1,145 @@
+#ifndef NAVIGATION_CACHE_H
+#define NAVIGATION_CACHE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace godot;
+
+// Per-area shortest paths for UnitLayer agents over the reflex corners of the
+// area polygon minus the obstacles. An area update only rebuilds its rings,
+// edge grid and corner list; a corner pair's visibility is tested the first
+// time a path search could use it and kept until the next update.
+//
+// Ends are bucketed in cells of end_cell_size. The first end routed to in a
+// cell starts a Dijkstra from it over the visibility graph, shared by every
+// end in the cell until the area is updated, and each route only settles it
+// as far as its own path length. The last leg is measured to the actual end,
+// so lengths are exact whenever the path's last corner sees it.
+//
+// Per agent, a route is a line-of-sight test, else corners popped from a heap
+// in order of start distance plus field distance, settling the field further
+// whenever the heap top is past its radius, until one is visible from the
+// start. That is O(settled corners) to build the heap, O(log corners) and
+// usually one visibility test per pop, plus O(corners) arithmetic per corner
+// the route settles first and a visibility test per relaxation that would
+// shorten a path. Over a field's life the work is bounded by a full Dijkstra:
+// O(corners) visibility tests to the end and O(corners^2) arithmetic, with
+// the corner pair tests shared by every field of the area.
+class NavigationCache : public RefCounted {
+    GDCLASS(NavigationCache, RefCounted);
+
+private:
+    struct Segment {
+        Vector2 a;
+        Vector2 b;
+    };
+
+    struct AreaNav {
+        int64_t version = -1;
+        int64_t obstacles_version = -1;
+
+        // Ring 0 is the area (interior on the left), the rest are the
+        // obstacles overlapping it (walkable side on the left).
+        // Ring r is points[ring_start[r] .. ring_start[r + 1]).
+        std::vector<Vector2> points;
+        std::vector<int> ring_start;
+        std::vector<Vector2> ring_min;
+        std::vector<Vector2> ring_max;
+        std::vector<int> prev_vertex;
+        std::vector<int> next_vertex;
+        std::vector<uint8_t> reflex;
+
+        // Edges bucketed in a uniform grid over the bounds, CSR layout
+        std::vector<Segment> edges;
+        Vector2 grid_origin;
+        Vector2 cell_size = Vector2(1, 1);
+        int cols = 0;
+        int rows = 0;
+        std::vector<int> cell_start;
+        std::vector<int> cell_edges;
+        mutable std::vector<uint32_t> edge_stamp;
+        mutable uint32_t stamp = 0;
+
+        // Reflex corners (ring vertex indices) and, per corner, which others
+        // it sees (rows allocated and pairs tested on first use)
+        static constexpr uint8_t VISIBILITY_UNKNOWN = 0;
+        static constexpr uint8_t VISIBILITY_BLOCKED = 1;
+        static constexpr uint8_t VISIBILITY_SEEN = 2;
+        std::vector<int> corners;
+        mutable std::vector<std::vector<uint8_t>> corner_visible;
+
+        // Per end cell, a Dijkstra from the cell's end that routes resume:
+        // path length from each corner to the end (final once settled,
+        // INFINITY when unreachable), the next corner on the path (-1 to head
+        // for the end) and the corner the path leaves the graph at. A corner's
+        // line of sight to the end is tested when it is first extracted.
+        struct EndField {
+            Vector2 end;
+            std::vector<float> distance;
+            std::vector<int> next;
+            std::vector<int> exit;
+            std::vector<uint8_t> end_tested;
+            std::vector<uint8_t> settled;
+            // Extraction key: straight distance to the end until tested, then
+            // the distance; INFINITY once settled or unreachable
+            std::vector<float> key;
+            std::vector<int> settled_order;
+            float radius = 0.0f;
+            bool exhausted = false;
+        };
+        mutable std::unordered_map<uint64_t, EndField> end_fields;
+        mutable std::vector<std::pair<float, int>> order;
+
+        bool tangent(int vertex, const Vector2 &point) const;
+        bool corners_see(int a, int b) const;
+        EndField &end_field(const Vector2 &to, double cell_size) const;
+        bool settle_next(EndField &field) const;
+
+        bool in_domain(const Vector2 &point) const;
+        bool in_wedge(int vertex, const Vector2 &direction) const;
+        bool visible(const Vector2 &from, const Vector2 &to, int from_vertex, int to_vertex) const;
+        void build(const PackedVector2Array &polygon, const std::vector<std::vector<Vector2>> &obstacles);
+        void route(const Vector2 &from, const Vector2 &to, double cell_size, Vector2 &r_waypoint, float &r_length) const;
+    };
+
+    std::unordered_map<int64_t, AreaNav> areas;
+    std::vector<std::vector<Vector2>> obstacles;
+    int64_t obstacles_version = 0;
+    double end_cell_size = 8.0;
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Ends closer than this share a distance field (0 for one field per end
+    // point). Applies to fields built after the call.
+    void set_end_cell_size(double size);
+
+    // Returns true when the outlines differ from the previous call; every
+    // area is rebuilt on its next update_area then
+    bool set_obstacles(const Array &outlines);
+
+    // Rebuilds area key unless it was built from the same version and
+    // obstacles. Returns true when it was rebuilt.
+    bool update_area(int64_t key, int64_t version, const PackedVector2Array &polygon);
+    void remove_area(int64_t key);
+    bool has_area(int64_t key) const;
+    void clear();
+
+    // Routes from[i] -> to[i] inside area keys[i] for the listed indices.
+    // Returns [PackedVector2Array waypoints, PackedFloat32Array lengths],
+    // both from.size() long: the next point to head for and the path length.
+    // Unlisted entries and unknown areas get a NaN length.
+    Array route(const PackedInt32Array &indices, const PackedInt64Array &keys,
+            const PackedVector2Array &from, const PackedVector2Array &to) const;
+};
+
+#endif // NAVIGATION_CACHE_H
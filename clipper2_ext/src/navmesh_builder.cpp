@@ -0,0 +1,575 @@
+#include "navmesh_builder.h"
+#include "delaunay.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "clipper2/clipper.h"
+
+using namespace godot;
+
+void NavmeshBuilder::_bind_methods() {
+    ClassDB::bind_static_method(
+        "NavmeshBuilder",
+        D_METHOD("build", "outline", "obstacles"),
+        &NavmeshBuilder::build
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("update", "key", "outline", "obstacles"),
+        &NavmeshBuilder::update
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("remove", "key"),
+        &NavmeshBuilder::remove
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear"),
+        &NavmeshBuilder::clear
+    );
+}
+
+// ---------------------------------------------------------------------------
+// Constrained Delaunay triangulation
+// ---------------------------------------------------------------------------
+
+struct ConstrainedDelaunay {
+    Delaunay delaunay;
+    // Constraint count per triangle edge (3 * t + i), on both sides
+    std::vector<uint8_t> constraint;
+
+    const DPoint &point(int v) const { return delaunay.points[v]; }
+
+    // Triangle and edge index of the edge a-b, false when it does not exist
+    bool find_edge(int a, int b, int &r_triangle, int &r_edge) const {
+        const int first = delaunay.vertex_triangle[a];
+        int t = first;
+        for (size_t guard = 0; guard < delaunay.triangles.size() && t >= 0; guard++) {
+            const Triangle &tri = delaunay.triangles[t];
+            const int k = tri.v[0] == a ? 0 : (tri.v[1] == a ? 1 : 2);
+            if (tri.v[(k + 1) % 3] == b) {
+                r_triangle = t;
+                r_edge = (k + 2) % 3;
+                return true;
+            }
+            if (tri.v[(k + 2) % 3] == b) {
+                r_triangle = t;
+                r_edge = (k + 1) % 3;
+                return true;
+            }
+            t = tri.n[(k + 2) % 3];
+            if (t == first) break;
+        }
+        return false;
+    }
+
+    void mark(int t, int i) {
+        constraint[3 * t + i]++;
+        const int u = delaunay.triangles[t].n[i];
+        if (u >= 0) {
+            for (int j = 0; j < 3; j++) {
+                if (delaunay.triangles[u].n[j] == t) {
+                    constraint[3 * u + j]++;
+                }
+            }
+        }
+    }
+
+    // Strictly on opposite sides of the line a-b
+    bool separates(int a, int b, int p, int q) const {
+        const double op = orient(point(a), point(b), point(p));
+        const double oq = orient(point(a), point(b), point(q));
+        return (op < 0.0 && oq > 0.0) || (op > 0.0 && oq < 0.0);
+    }
+
+    // Ahead of a on the ray towards b and collinear with it
+    bool on_ray(int a, int b, int v) const {
+        const DPoint &pa = point(a);
+        const DPoint &pb = point(b);
+        const DPoint &pv = point(v);
+        return orient(pa, pb, pv) == 0.0 && (pv.x - pa.x) * (pb.x - pa.x) + (pv.y - pa.y) * (pb.y - pa.y) > 0.0;
+    }
+
+    // Sloan's edge recovery: walk the triangles the segment crosses, then
+    // flip the crossing edges (convex quads only) until none is left.
+    // Vertices on the segment split it.
+    bool insert_constraint(int a, int b, int depth = 0) {
+        ERR_FAIL_COND_V_MSG(depth > 64, false, "Navmesh constraint split too often");
+        int t, i;
+        if (find_edge(a, b, t, i)) {
+            mark(t, i);
+            return true;
+        }
+
+        // First crossing edge, in the fan around a
+        std::deque<std::pair<int, int>> crossing;
+        int current = -1;
+        int left = -1, right = -1;
+        {
+            const int first = delaunay.vertex_triangle[a];
+            int f = first;
+            for (size_t guard = 0; guard < delaunay.triangles.size() && f >= 0; guard++) {
+                const Triangle &tri = delaunay.triangles[f];
+                const int k = tri.v[0] == a ? 0 : (tri.v[1] == a ? 1 : 2);
+                const int v1 = tri.v[(k + 1) % 3];
+                const int v2 = tri.v[(k + 2) % 3];
+                if (on_ray(a, b, v1)) {
+                    return insert_constraint(a, v1, depth + 1) && insert_constraint(v1, b, depth + 1);
+                }
+                if (on_ray(a, b, v2)) {
+                    return insert_constraint(a, v2, depth + 1) && insert_constraint(v2, b, depth + 1);
+                }
+                if (orient(point(a), point(b), point(v1)) < 0.0 && orient(point(a), point(b), point(v2)) > 0.0) {
+                    right = v1;
+                    left = v2;
+                    current = tri.n[k];
+                    break;
+                }
+                f = tri.n[(k + 2) % 3];
+                if (f == first) break;
+            }
+        }
+        ERR_FAIL_COND_V_MSG(current < 0, false, "Navmesh constraint start not found");
+        crossing.push_back({ right, left });
+
+        for (size_t guard = 0; guard <= delaunay.triangles.size(); guard++) {
+            const Triangle &tri = delaunay.triangles[current];
+            int k = 0;
+            while (tri.v[k] == left || tri.v[k] == right) {
+                k++;
+            }
+            const int w = tri.v[k];
+            if (w == b) break;
+            const double side = orient(point(a), point(b), point(w));
+            if (side == 0.0) {
+                return insert_constraint(a, w, depth + 1) && insert_constraint(w, b, depth + 1);
+            }
+            if (side > 0.0) {
+                left = w;
+            } else {
+                right = w;
+            }
+            crossing.push_back({ right, left });
+            // Next triangle across the new crossing edge, opposite the vertex
+            // that was just replaced
+            int next = -1;
+            for (int e = 0; e < 3; e++) {
+                const int x = tri.v[(e + 1) % 3];
+                const int y = tri.v[(e + 2) % 3];
+                if ((x == right && y == left) || (x == left && y == right)) {
+                    next = tri.n[e];
+                }
+            }
+            ERR_FAIL_COND_V_MSG(next < 0, false, "Navmesh constraint left the triangulation");
+            current = next;
+        }
+
+        size_t budget = crossing.size() * crossing.size() * 4 + 64;
+        while (!crossing.empty()) {
+            ERR_FAIL_COND_V_MSG(budget-- == 0, false, "Navmesh constraint recovery did not converge");
+            const std::pair<int, int> edge = crossing.front();
+            crossing.pop_front();
+            if (!find_edge(edge.first, edge.second, t, i)) continue;
+            ERR_FAIL_COND_V_MSG(constraint[3 * t + i] != 0, false, "Navmesh constraints cross");
+            const int u = delaunay.triangles[t].n[i];
+            int j = 0;
+            while (delaunay.triangles[u].n[j] != t) {
+                j++;
+            }
+            const int p = delaunay.triangles[t].v[i];
+            const int r = delaunay.triangles[u].v[j];
+            if (!separates(p, r, edge.first, edge.second)) {
+                crossing.push_back(edge);
+                continue;
+            }
+            delaunay.flip(t, i, &constraint);
+            if (p != a && p != b && r != a && r != b && separates(a, b, p, r)) {
+                crossing.push_back({ p, r });
+            }
+        }
+        ERR_FAIL_COND_V_MSG(!find_edge(a, b, t, i), false, "Navmesh constraint was not recovered");
+        mark(t, i);
+        return true;
+    }
+
+    // Lawson flips of unconstrained edges back to a constrained Delaunay,
+    // starting from the pending triangles and following every flip
+    void restore_delaunay(std::vector<int> pending) {
+        size_t budget = (delaunay.triangles.size() + pending.size() + 8) * 16;
+        while (!pending.empty() && budget-- > 0) {
+            const int t = pending.back();
+            pending.pop_back();
+            for (int i = 0; i < 3; i++) {
+                const Triangle &tri = delaunay.triangles[t];
+                const int u = tri.n[i];
+                if (!tri.alive || u < 0 || constraint[3 * t + i] != 0) continue;
+                int j = 0;
+                while (delaunay.triangles[u].n[j] != t) {
+                    j++;
+                }
+                const int p = tri.v[i], q = tri.v[(i + 1) % 3], s = tri.v[(i + 2) % 3];
+                const int r = delaunay.triangles[u].v[j];
+                if (in_circle(point(p), point(q), point(s), point(r)) <= 0.0) continue;
+                // Nearly cocircular quads can test positive both ways round;
+                // flip only when the new diagonal passes, or they cycle
+                if (in_circle(point(p), point(q), point(r), point(s)) >= 0.0) continue;
+                if (!separates(p, r, q, s)) continue;
+                delaunay.flip(t, i, &constraint);
+                pending.push_back(t);
+                pending.push_back(u);
+                break;
+            }
+        }
+    }
+};
+
+// Consecutive duplicates and closing points dropped, fewer than 3 points dropped
+static void clean_ring(std::vector<DPoint> &ring) {
+    ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+    while (ring.size() > 1 && ring.front() == ring.back()) {
+        ring.pop_back();
+    }
+    if (ring.size() < 3) {
+        ring.clear();
+    }
+}
+
+struct DPointHash {
+    size_t operator()(const DPoint &p) const {
+        uint64_t x, y;
+        std::memcpy(&x, &p.x, sizeof(x));
+        std::memcpy(&y, &p.y, sizeof(y));
+        return static_cast<size_t>(x * 0x9e3779b97f4a7c15ULL ^ (y + 0x632be59bd9b4e019ULL + (x << 6) + (x >> 2)));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Kept triangulation
+// ---------------------------------------------------------------------------
+
+// Triangulation of one set of rings, updated in place when the rings change.
+// Points that leave the rings stay in as unconstrained interior points; once
+// they outnumber the ring points, or a new point lands too close to the
+// outer square, the next update rebuilds from scratch.
+struct NavmeshBuilder::AreaMesh {
+    ConstrainedDelaunay cdt;
+    std::unordered_map<DPoint, int, DPointHash> index_of;
+    // Updates keep new points within these bounds
+    double min_x = 0.0, min_y = 0.0, max_x = 0.0, max_y = 0.0;
+    bool built = false;
+
+    // Ring edges as vertex index pairs, adding the points not seen yet
+    // (appended to r_added). False when one falls outside the bounds.
+    bool collect_edges(std::vector<std::vector<DPoint>> &rings, std::vector<std::pair<int, int>> &r_edges,
+            std::vector<int> &r_added) {
+        for (std::vector<DPoint> &ring : rings) {
+            clean_ring(ring);
+            const size_t start = r_edges.size();
+            for (const DPoint &p : ring) {
+                auto found = index_of.find(p);
+                int v;
+                if (found != index_of.end()) {
+                    v = found->second;
+                } else {
+                    if (p.x < min_x || p.y < min_y || p.x > max_x || p.y > max_y) {
+                        return false;
+                    }
+                    v = cdt.delaunay.add_point(p);
+                    index_of.emplace(p, v);
+                    r_added.push_back(v);
+                }
+                r_edges.push_back({ v, -1 });
+            }
+            for (size_t e = start; e < r_edges.size(); e++) {
+                r_edges[e].second = r_edges[e + 1 < r_edges.size() ? e + 1 : start].first;
+            }
+        }
+        return true;
+    }
+
+    void rebuild(std::vector<std::vector<DPoint>> &rings) {
+        cdt = ConstrainedDelaunay();
+        index_of.clear();
+        built = false;
+
+        std::vector<DPoint> seeds;
+        std::vector<std::pair<int, int>> edges;
+        double lo_x = 0.0, lo_y = 0.0, hi_x = 0.0, hi_y = 0.0;
+        for (std::vector<DPoint> &ring : rings) {
+            clean_ring(ring);
+            const size_t start = edges.size();
+            for (const DPoint &p : ring) {
+                auto inserted = index_of.emplace(p, static_cast<int>(seeds.size()));
+                if (inserted.second) {
+                    lo_x = seeds.empty() ? p.x : std::min(lo_x, p.x);
+                    lo_y = seeds.empty() ? p.y : std::min(lo_y, p.y);
+                    hi_x = seeds.empty() ? p.x : std::max(hi_x, p.x);
+                    hi_y = seeds.empty() ? p.y : std::max(hi_y, p.y);
+                    seeds.push_back(p);
+                }
+                edges.push_back({ inserted.first->second, -1 });
+            }
+            for (size_t e = start; e < edges.size(); e++) {
+                edges[e].second = edges[e + 1 < edges.size() ? e + 1 : start].first;
+            }
+        }
+        if (seeds.size() < 3) {
+            index_of.clear();
+            return;
+        }
+
+        cdt.delaunay.init(seeds, lo_x, lo_y, hi_x, hi_y);
+        for (int i : insertion_order(seeds, lo_y, hi_y)) {
+            cdt.delaunay.insert(i);
+        }
+        cdt.constraint.assign(cdt.delaunay.triangles.size() * 3, 0);
+        for (const std::pair<int, int> &edge : edges) {
+            if (edge.first != edge.second) {
+                cdt.insert_constraint(edge.first, edge.second);
+            }
+        }
+        std::vector<int> pending(cdt.delaunay.triangles.size());
+        for (size_t t = 0; t < pending.size(); t++) {
+            pending[t] = static_cast<int>(t);
+        }
+        cdt.restore_delaunay(std::move(pending));
+
+        // One span of slack keeps the outer square (ten spans out) far away
+        const double span = std::max(hi_x - lo_x, hi_y - lo_y) + 1.0;
+        min_x = lo_x - span;
+        min_y = lo_y - span;
+        max_x = hi_x + span;
+        max_y = hi_y + span;
+        built = true;
+    }
+
+    // False when the rings need a rebuild instead
+    bool update(std::vector<std::vector<DPoint>> &rings) {
+        if (!built) {
+            return false;
+        }
+        std::vector<std::pair<int, int>> edges;
+        std::vector<int> added;
+        if (!collect_edges(rings, edges, added)) {
+            return false;
+        }
+        Delaunay &delaunay = cdt.delaunay;
+        const int vertex_count = static_cast<int>(delaunay.points.size()) - 4;
+        std::vector<uint8_t> live(delaunay.points.size(), 0);
+        int live_count = 0;
+        for (const std::pair<int, int> &edge : edges) {
+            live_count += live[edge.first] == 0;
+            live[edge.first] = 1;
+        }
+        if (vertex_count - live_count > live_count) {
+            return false;
+        }
+
+        // Edges constrained so far; those left unconstrained need checking
+        std::vector<std::pair<int, int>> released;
+        for (size_t t = 0; t < delaunay.triangles.size(); t++) {
+            const Triangle &tri = delaunay.triangles[t];
+            if (!tri.alive) continue;
+            for (int i = 0; i < 3; i++) {
+                const int a = tri.v[(i + 1) % 3];
+                const int b = tri.v[(i + 2) % 3];
+                if (cdt.constraint[3 * t + i] != 0 && a < b) {
+                    released.push_back({ a, b });
+                }
+            }
+        }
+
+        // New points go in unconstrained, then every ring edge is marked
+        // again; edges still in place are found without flips
+        std::vector<int> touched;
+        delaunay.touched = &touched;
+        std::vector<DPoint> added_points;
+        double lo_y = max_y, hi_y = min_y;
+        for (int v : added) {
+            added_points.push_back(delaunay.points[v]);
+            lo_y = std::min(lo_y, delaunay.points[v].y);
+            hi_y = std::max(hi_y, delaunay.points[v].y);
+        }
+        bool ok = true;
+        for (int i : insertion_order(added_points, lo_y, hi_y)) {
+            ok = ok && delaunay.insert(added[i]);
+        }
+        cdt.constraint.assign(delaunay.triangles.size() * 3, 0);
+        for (const std::pair<int, int> &edge : edges) {
+            if (ok && edge.first != edge.second) {
+                ok = cdt.insert_constraint(edge.first, edge.second);
+            }
+        }
+        delaunay.touched = nullptr;
+        if (!ok) {
+            return false;
+        }
+
+        for (const std::pair<int, int> &edge : released) {
+            int t, i;
+            if (cdt.find_edge(edge.first, edge.second, t, i) && cdt.constraint[3 * t + i] == 0) {
+                touched.push_back(t);
+                if (delaunay.triangles[t].n[i] >= 0) {
+                    touched.push_back(delaunay.triangles[t].n[i]);
+                }
+            }
+        }
+        cdt.restore_delaunay(std::move(touched));
+        return true;
+    }
+
+    // Triangles (counter-clockwise) inside an odd number of the rings, over
+    // the points they use
+    void collect(std::vector<DPoint> &r_points, std::vector<std::array<int, 3>> &r_triangles) const {
+        if (!built) {
+            return;
+        }
+        // Inside = odd number of constraint crossings from the outer square
+        const std::vector<Triangle> &triangles = cdt.delaunay.triangles;
+        std::vector<int8_t> parity(triangles.size(), -1);
+        std::vector<int> stack = { cdt.delaunay.vertex_triangle[cdt.delaunay.seed_count] };
+        parity[stack[0]] = 0;
+        while (!stack.empty()) {
+            const int t = stack.back();
+            stack.pop_back();
+            for (int i = 0; i < 3; i++) {
+                const int u = triangles[t].n[i];
+                if (u < 0 || parity[u] >= 0) continue;
+                parity[u] = static_cast<int8_t>(parity[t] ^ (cdt.constraint[3 * t + i] & 1));
+                stack.push_back(u);
+            }
+        }
+        std::vector<int> remap(cdt.delaunay.points.size(), -1);
+        for (size_t t = 0; t < triangles.size(); t++) {
+            if (!triangles[t].alive || parity[t] != 1) continue;
+            std::array<int, 3> out;
+            for (int k = 0; k < 3; k++) {
+                const int v = triangles[t].v[k];
+                if (remap[v] < 0) {
+                    remap[v] = static_cast<int>(r_points.size());
+                    r_points.push_back(cdt.delaunay.points[v]);
+                }
+                out[k] = remap[v];
+            }
+            r_triangles.push_back(out);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------
+
+NavmeshBuilder::NavmeshBuilder() = default;
+
+NavmeshBuilder::~NavmeshBuilder() = default;
+
+// The outline minus the obstacles overlapping it, also resolving any
+// self-touching of the outline that would make ring edges cross
+static std::vector<std::vector<DPoint>> walkable_rings(const PackedVector2Array &outline, const Array &obstacles) {
+    std::vector<std::vector<DPoint>> rings(1);
+    for (int i = 0; i < outline.size(); i++) {
+        rings[0].push_back({ outline[i].x, outline[i].y });
+    }
+    if (outline.size() < 3) {
+        return rings;
+    }
+
+    Clipper2Lib::PathsD clips;
+    Vector2 outline_min = outline[0], outline_max = outline[0];
+    for (int i = 1; i < outline.size(); i++) {
+        outline_min = outline_min.min(outline[i]);
+        outline_max = outline_max.max(outline[i]);
+    }
+    for (int o = 0; o < obstacles.size(); o++) {
+        PackedVector2Array obstacle = obstacles[o];
+        if (obstacle.size() < 3) continue;
+        Vector2 min = obstacle[0], max = obstacle[0];
+        for (int i = 1; i < obstacle.size(); i++) {
+            min = min.min(obstacle[i]);
+            max = max.max(obstacle[i]);
+        }
+        if (max.x <= outline_min.x || max.y <= outline_min.y || min.x >= outline_max.x || min.y >= outline_max.y) continue;
+        Clipper2Lib::PathD path;
+        for (int i = 0; i < obstacle.size(); i++) {
+            path.push_back(Clipper2Lib::PointD(obstacle[i].x, obstacle[i].y));
+        }
+        clips.push_back(path);
+    }
+
+    Clipper2Lib::PathsD subject(1);
+    for (const DPoint &p : rings[0]) {
+        subject[0].push_back(Clipper2Lib::PointD(p.x, p.y));
+    }
+    const Clipper2Lib::PathsD walkable = Clipper2Lib::Difference(subject, clips, Clipper2Lib::FillRule::NonZero);
+    rings.assign(walkable.size(), {});
+    for (size_t r = 0; r < walkable.size(); r++) {
+        for (const Clipper2Lib::PointD &p : walkable[r]) {
+            rings[r].push_back({ p.x, p.y });
+        }
+    }
+    return rings;
+}
+
+Array NavmeshBuilder::mesh_result(const AreaMesh &mesh) {
+    std::vector<DPoint> points;
+    std::vector<std::array<int, 3>> triangles;
+    mesh.collect(points, triangles);
+
+    PackedVector2Array vertices;
+    Array polygons;
+    vertices.resize(points.size());
+    Vector2 *dst = vertices.ptrw();
+    for (size_t i = 0; i < points.size(); i++) {
+        dst[i] = Vector2(static_cast<real_t>(points[i].x), static_cast<real_t>(points[i].y));
+    }
+    for (const std::array<int, 3> &tri : triangles) {
+        // Counter-clockwise in y-up terms, reversed for screen space
+        PackedInt32Array polygon;
+        polygon.push_back(tri[0]);
+        polygon.push_back(tri[2]);
+        polygon.push_back(tri[1]);
+        polygons.push_back(polygon);
+    }
+
+    Array result;
+    result.push_back(vertices);
+    result.push_back(polygons);
+    return result;
+}
+
+Array NavmeshBuilder::build(const PackedVector2Array &outline, const Array &obstacles) {
+    std::vector<std::vector<DPoint>> rings = walkable_rings(outline, obstacles);
+    AreaMesh mesh;
+    mesh.rebuild(rings);
+    return mesh_result(mesh);
+}
+
+Array NavmeshBuilder::update(int64_t key, const PackedVector2Array &outline, const Array &obstacles) {
+    std::vector<std::vector<DPoint>> rings = walkable_rings(outline, obstacles);
+    std::unique_ptr<AreaMesh> &mesh = areas[key];
+    if (!mesh) {
+        mesh = std::make_unique<AreaMesh>();
+    }
+    if (!mesh->update(rings)) {
+        mesh->rebuild(rings);
+    }
+    return mesh_result(*mesh);
+}
+
+void NavmeshBuilder::remove(int64_t key) {
+    areas.erase(key);
+}
+
+void NavmeshBuilder::clear() {
+    areas.clear();
+}
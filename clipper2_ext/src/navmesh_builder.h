@@ -0,0 +1,52 @@
+#ifndef NAVMESH_BUILDER_H
+#define NAVMESH_BUILDER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <memory>
+#include <unordered_map>
+
+using namespace godot;
+
+// Navigation meshes for territory polygons without a bake: the walkable
+// outline minus the obstacles it overlaps is triangulated by a constrained
+// Delaunay triangulation (ring edges recovered by flips, then Lawson flips
+// back to Delaunay), keeping the triangles inside an odd number of rings.
+//
+// update keeps each area's triangulation: new ring points are inserted,
+// ring edges re-marked (existing ones are found, moved ones recovered) and
+// only the triangles that changed are flipped back to Delaunay. Points that
+// left the rings stay in as interior points until a rebuild.
+class NavmeshBuilder : public RefCounted {
+    GDCLASS(NavmeshBuilder, RefCounted);
+
+private:
+    struct AreaMesh;
+
+    std::unordered_map<int64_t, std::unique_ptr<AreaMesh>> areas;
+
+    static Array mesh_result(const AreaMesh &mesh);
+
+protected:
+    static void _bind_methods();
+
+public:
+    NavmeshBuilder();
+    ~NavmeshBuilder();
+
+    // [PackedVector2Array vertices, Array polygons] for
+    // NavigationPolygon.vertices / add_polygon: one PackedInt32Array triangle
+    // per polygon, counter-clockwise on screen (y down). Obstacles whose
+    // bounds miss the outline are left out of the clip.
+    static Array build(const PackedVector2Array &outline, const Array &obstacles);
+
+    // As build, updating the triangulation kept for area key from its
+    // previous call (built from scratch the first time). Covers the same
+    // area, possibly with interior vertices left from earlier outlines.
+    Array update(int64_t key, const PackedVector2Array &outline, const Array &obstacles);
+    void remove(int64_t key);
+    void clear();
+};
+
+#endif // NAVMESH_BUILDER_H
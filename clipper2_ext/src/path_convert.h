@@ -0,0 +1,401 @@
+#ifndef PATH_CONVERT_H
+#define PATH_CONVERT_H
+
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "clipper2/clipper.h"
+
+using namespace godot;
+
+// Coordinate conversion between Godot and the Clipper2 path type of the
+// active clipping mode: PathD (double) or Path64 (fixed point, * scale).
+template <typename T>
+struct PathConv;
+
+template <>
+struct PathConv<double> {
+    using Engine = Clipper2Lib::ClipperD;
+    using Tree = Clipper2Lib::PolyTreeD;
+
+    Clipper2Lib::PointD to_point(const Vector2 &v) const {
+        return Clipper2Lib::PointD(
+            static_cast<double>(v.x),
+            static_cast<double>(v.y)
+        );
+    }
+    Vector2 to_vector(const Clipper2Lib::PointD &p) const {
+        return Vector2(
+            static_cast<float>(p.x),
+            static_cast<float>(p.y)
+        );
+    }
+    // Clipper2 units per world unit, for deltas and areas
+    double units() const { return 1.0; }
+};
+
+template <>
+struct PathConv<int64_t> {
+    using Engine = Clipper2Lib::Clipper64;
+    using Tree = Clipper2Lib::PolyTree64;
+
+    double scale = 1.0;
+
+    Clipper2Lib::Point64 to_point(const Vector2 &v) const {
+        return Clipper2Lib::Point64(
+            static_cast<int64_t>(std::llround(static_cast<double>(v.x) * scale)),
+            static_cast<int64_t>(std::llround(static_cast<double>(v.y) * scale))
+        );
+    }
+    Vector2 to_vector(const Clipper2Lib::Point64 &p) const {
+        return Vector2(
+            static_cast<float>(static_cast<double>(p.x) / scale),
+            static_cast<float>(static_cast<double>(p.y) / scale)
+        );
+    }
+    double units() const { return scale; }
+};
+
+// Closed polygon as given
+template <typename T>
+Clipper2Lib::Path<T> to_path_closed(const PathConv<T> &conv, const PackedVector2Array &polygon) {
+    Clipper2Lib::Path<T> path;
+    path.reserve(polygon.size());
+    const Vector2 *src = polygon.ptr();
+    for (int i = 0; i < polygon.size(); i++) {
+        path.push_back(conv.to_point(src[i]));
+    }
+    return path;
+}
+
+// Open polyline as given (Clipper2 treats it as open when added via AddOpenSubject)
+template <typename T>
+Clipper2Lib::Path<T> to_path_open(const PathConv<T> &conv, const PackedVector2Array &polyline) {
+    return to_path_closed(conv, polyline);
+}
+
+// Open subject builder that also adds the last->first segment if input is not closed
+template <typename T>
+Clipper2Lib::Path<T> to_path_ring_open(const PathConv<T> &conv, const PackedVector2Array &polyline) {
+    Clipper2Lib::Path<T> path;
+    int n = polyline.size();
+    if (n <= 0) return path;
+    path.reserve(n + 1);
+    const Vector2 *src = polyline.ptr();
+    for (int i = 0; i < n; i++) {
+        path.push_back(conv.to_point(src[i]));
+    }
+    if (!(src[0] == src[n - 1])) {
+        path.push_back(conv.to_point(src[0]));
+    }
+    return path;
+}
+
+template <typename T>
+PackedVector2Array to_godot(const PathConv<T> &conv, const Clipper2Lib::Path<T> &path) {
+    PackedVector2Array out;
+    out.resize(path.size());
+    Vector2 *dst = out.ptrw();
+    for (size_t i = 0; i < path.size(); i++) {
+        dst[i] = conv.to_vector(path[i]);
+    }
+    return out;
+}
+
+// Closed solution back to Godot polygons (drops degenerate rings)
+template <typename T>
+Array closed_solution_to_godot(const PathConv<T> &conv, const Clipper2Lib::Paths<T> &solution) {
+    Array out;
+    for (const auto &path : solution) {
+        if (path.size() < 3) continue;
+        out.append(to_godot(conv, path));
+    }
+    return out;
+}
+
+// Open solution back to Godot polylines (drops degenerate pieces)
+template <typename T>
+Array open_solution_to_godot_flat(const PathConv<T> &conv, const Clipper2Lib::Paths<T> &solution) {
+    Array out;
+    for (const auto &path : solution) {
+        if (path.size() < 2) continue;
+        out.append(to_godot(conv, path));
+    }
+    return out;
+}
+
+// World-space bounds of a Godot polygon, independent of the clipping mode
+inline Clipper2Lib::RectD polygon_bounds(const PackedVector2Array &polygon) {
+    if (polygon.size() == 0) {
+        return Clipper2Lib::RectD(0, 0, 0, 0);
+    }
+    const Vector2 *src = polygon.ptr();
+    double left = src[0].x, right = src[0].x, top = src[0].y, bottom = src[0].y;
+    for (int i = 1; i < polygon.size(); i++) {
+        left = std::min(left, static_cast<double>(src[i].x));
+        right = std::max(right, static_cast<double>(src[i].x));
+        top = std::min(top, static_cast<double>(src[i].y));
+        bottom = std::max(bottom, static_cast<double>(src[i].y));
+    }
+    return Clipper2Lib::RectD(left, top, right, bottom);
+}
+
+// Bounds overlap test (touching counts, Clipper decides the rest)
+inline bool bounds_overlap(const Clipper2Lib::RectD &a, const Clipper2Lib::RectD &b) {
+    return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+// --- Outer/hole structure ---
+// Rings of a PolyTree split into outers and holes; hole_parents[i] is the
+// index in outers of the polygon hole i cuts into. Islands inside holes are
+// outers of their own.
+template <typename T>
+struct RingStructure {
+    Clipper2Lib::Paths<T> outers;
+    Clipper2Lib::Paths<T> holes;
+    std::vector<int> hole_parents;
+};
+
+template <typename T, typename Node>
+void flatten_polytree(const Node &node, int parent_outer, RingStructure<T> &out) {
+    for (size_t i = 0; i < node.Count(); i++) {
+        const Node *child = node.Child(i);
+        if (child->IsHole()) {
+            out.holes.push_back(child->Polygon());
+            out.hole_parents.push_back(parent_outer);
+            flatten_polytree(*child, parent_outer, out);
+        } else {
+            int outer_index = static_cast<int>(out.outers.size());
+            out.outers.push_back(child->Polygon());
+            flatten_polytree(*child, outer_index, out);
+        }
+    }
+}
+
+// [Array outers, Array holes, PackedInt32Array hole_parents]
+template <typename T>
+Array ring_structure_to_godot(const PathConv<T> &conv, const RingStructure<T> &rings) {
+    Array outers;
+    for (const auto &path : rings.outers) {
+        outers.append(to_godot(conv, path));
+    }
+    Array holes;
+    for (const auto &path : rings.holes) {
+        holes.append(to_godot(conv, path));
+    }
+    PackedInt32Array hole_parents;
+    hole_parents.resize(rings.hole_parents.size());
+    int32_t *dst = hole_parents.ptrw();
+    for (size_t i = 0; i < rings.hole_parents.size(); i++) {
+        dst[i] = rings.hole_parents[i];
+    }
+    Array result;
+    result.append(outers);
+    result.append(holes);
+    result.append(hole_parents);
+    return result;
+}
+
+// --- Flat layout ---
+// Batched input/output without one Variant per ring: all points in a single
+// PackedVector2Array, ring i is points[ring_offsets[i] .. ring_offsets[i + 1])
+// (ring_count + 1 offsets) and group_ids[i] names the polygon or polyline ring i
+// belongs to. Closed rings sharing a group id form one shape (outer + holes).
+
+// ring_offsets ascending from 0 to points.size(), group_ids empty or one per ring.
+// Prints its own error, so callers just return on false.
+inline bool is_valid_flat_layout(
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids)
+{
+    if (ring_offsets.is_empty()) {
+        ERR_FAIL_COND_V_MSG(!points.is_empty(), false, "Flat layout: points given without ring offsets");
+        ERR_FAIL_COND_V_MSG(!group_ids.is_empty(), false, "Flat layout: group ids given without ring offsets");
+        return true;
+    }
+    const int32_t *offsets = ring_offsets.ptr();
+    const int ring_count = ring_offsets.size() - 1;
+    ERR_FAIL_COND_V_MSG(offsets[0] != 0, false, "Flat layout: first ring offset must be 0");
+    ERR_FAIL_COND_V_MSG(offsets[ring_count] != points.size(), false,
+        vformat("Flat layout: last ring offset %d does not match point count %d", offsets[ring_count], points.size()));
+    for (int i = 0; i < ring_count; i++) {
+        ERR_FAIL_COND_V_MSG(offsets[i + 1] < offsets[i], false, vformat("Flat layout: ring offsets decrease at ring %d", i));
+    }
+    ERR_FAIL_COND_V_MSG(!group_ids.is_empty() && group_ids.size() != ring_count, false,
+        vformat("Flat layout: %d group ids for %d rings", group_ids.size(), ring_count));
+    return true;
+}
+
+inline int flat_ring_count(const PackedInt32Array &ring_offsets) {
+    return ring_offsets.is_empty() ? 0 : ring_offsets.size() - 1;
+}
+
+// Closed shapes read from the flat layout, one entry per distinct group id in
+// order of first appearance. Rings under min_points are dropped, so a group
+// can end up empty. Bounds are in world units, independent of the mode.
+template <typename T>
+struct FlatGroups {
+    std::vector<Clipper2Lib::Paths<T>> paths;
+    std::vector<int32_t> ids;
+    std::vector<Clipper2Lib::RectD> bounds;
+};
+
+// Missing group ids mean every ring is its own group, labelled by ring index
+template <typename T>
+bool flat_to_groups(
+    const PathConv<T> &conv,
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    const PackedInt32Array &group_ids,
+    size_t min_points,
+    FlatGroups<T> &out)
+{
+    if (!is_valid_flat_layout(points, ring_offsets, group_ids)) {
+        return false;
+    }
+    const Vector2 *src = points.ptr();
+    const int32_t *offsets = ring_offsets.ptr();
+    const int ring_count = flat_ring_count(ring_offsets);
+    std::unordered_map<int32_t, size_t> slot_by_id;
+    for (int r = 0; r < ring_count; r++) {
+        int32_t id = group_ids.is_empty() ? r : group_ids[r];
+        auto inserted = slot_by_id.emplace(id, out.ids.size());
+        if (inserted.second) {
+            out.paths.emplace_back();
+            out.ids.push_back(id);
+            out.bounds.push_back(Clipper2Lib::RectD(0, 0, 0, 0));
+        }
+        size_t slot = inserted.first->second;
+        const int begin = offsets[r];
+        const int count = offsets[r + 1] - begin;
+        if (count < static_cast<int>(min_points)) continue;
+
+        Clipper2Lib::Path<T> path;
+        path.reserve(count);
+        Clipper2Lib::RectD &b = out.bounds[slot];
+        bool first_ring = out.paths[slot].empty();
+        for (int i = begin; i < begin + count; i++) {
+            path.push_back(conv.to_point(src[i]));
+            if (first_ring && i == begin) {
+                b = Clipper2Lib::RectD(src[i].x, src[i].y, src[i].x, src[i].y);
+            }
+            b.left = std::min(b.left, static_cast<double>(src[i].x));
+            b.right = std::max(b.right, static_cast<double>(src[i].x));
+            b.top = std::min(b.top, static_cast<double>(src[i].y));
+            b.bottom = std::max(b.bottom, static_cast<double>(src[i].y));
+        }
+        out.paths[slot].push_back(std::move(path));
+    }
+    return true;
+}
+
+// Open polylines from the flat layout, all pooled into one subject set
+// (as_rings adds last->first like to_path_ring_open)
+template <typename T>
+bool flat_to_open_subjects(
+    const PathConv<T> &conv,
+    const PackedVector2Array &points,
+    const PackedInt32Array &ring_offsets,
+    bool as_rings,
+    Clipper2Lib::Paths<T> &out)
+{
+    if (!is_valid_flat_layout(points, ring_offsets, PackedInt32Array())) {
+        return false;
+    }
+    const Vector2 *src = points.ptr();
+    const int32_t *offsets = ring_offsets.ptr();
+    const int ring_count = flat_ring_count(ring_offsets);
+    out.reserve(ring_count);
+    for (int r = 0; r < ring_count; r++) {
+        const int begin = offsets[r];
+        const int count = offsets[r + 1] - begin;
+        if (count < 2) continue;
+        Clipper2Lib::Path<T> path;
+        path.reserve(count + 1);
+        for (int i = begin; i < begin + count; i++) {
+            path.push_back(conv.to_point(src[i]));
+        }
+        if (as_rings && !(src[begin] == src[begin + count - 1])) {
+            path.push_back(conv.to_point(src[begin]));
+        }
+        out.push_back(std::move(path));
+    }
+    return true;
+}
+
+inline Array make_flat_result(const PackedVector2Array &points, const PackedInt32Array &ring_offsets, const PackedInt32Array &group_ids) {
+    Array result;
+    result.append(points);
+    result.append(ring_offsets);
+    result.append(group_ids);
+    return result;
+}
+
+// Solutions to the flat layout; solution k contributes its rings (with at
+// least min_points points) under ids[k]. Sized up front, so every array is
+// allocated once.
+template <typename T>
+void write_flat(
+    const PathConv<T> &conv,
+    const std::vector<Clipper2Lib::Paths<T>> &solutions,
+    const std::vector<int32_t> &ids,
+    size_t min_points,
+    PackedVector2Array &points,
+    PackedInt32Array &ring_offsets,
+    PackedInt32Array &group_ids)
+{
+    int point_count = 0;
+    int ring_count = 0;
+    for (const auto &solution : solutions) {
+        for (const auto &path : solution) {
+            if (path.size() < min_points) continue;
+            point_count += static_cast<int>(path.size());
+            ring_count++;
+        }
+    }
+
+    points.resize(point_count);
+    ring_offsets.resize(ring_count + 1);
+    group_ids.resize(ring_count);
+    Vector2 *dst = points.ptrw();
+    int32_t *offsets = ring_offsets.ptrw();
+    int32_t *groups = group_ids.ptrw();
+
+    int p = 0;
+    int r = 0;
+    offsets[0] = 0;
+    for (size_t k = 0; k < solutions.size(); k++) {
+        for (const auto &path : solutions[k]) {
+            if (path.size() < min_points) continue;
+            for (const auto &pt : path) {
+                dst[p++] = conv.to_vector(pt);
+            }
+            groups[r] = ids[k];
+            offsets[++r] = p;
+        }
+    }
+}
+
+// Same, packed as [points, ring_offsets, group_ids]
+template <typename T>
+Array solutions_to_flat(
+    const PathConv<T> &conv,
+    const std::vector<Clipper2Lib::Paths<T>> &solutions,
+    const std::vector<int32_t> &ids,
+    size_t min_points)
+{
+    PackedVector2Array points;
+    PackedInt32Array ring_offsets;
+    PackedInt32Array group_ids;
+    write_flat(conv, solutions, ids, min_points, points, ring_offsets, group_ids);
+    return make_flat_result(points, ring_offsets, group_ids);
+}
+
+#endif // PATH_CONVERT_H
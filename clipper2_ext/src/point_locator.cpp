@@ -0,0 +1,182 @@
+#include "point_locator.h"
+#include "polygon_queries.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+void PointLocator::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("build", "polygons", "centers", "cell_size"),
+        &PointLocator::build
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear"),
+        &PointLocator::clear
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_polygon_count"),
+        &PointLocator::get_polygon_count
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("locate_points", "points", "mask"),
+        &PointLocator::locate_points,
+        DEFVAL(PackedByteArray())
+    );
+}
+
+void PointLocator::build(const Array &polygons, const PackedVector2Array &p_centers, double p_cell_size) {
+    clear();
+    ERR_FAIL_COND_MSG(!(p_cell_size > 0.0), "Cell size must be positive");
+    ERR_FAIL_COND_MSG(p_centers.size() != polygons.size(), "One center per polygon is required");
+
+    cell_size = p_cell_size;
+    polygon_start.reserve(polygons.size() + 1);
+    polygon_start.push_back(0);
+    bounds.reserve(polygons.size());
+    centers.assign(p_centers.ptr(), p_centers.ptr() + p_centers.size());
+    for (int i = 0; i < polygons.size(); i++) {
+        PackedVector2Array polygon = polygons[i];
+        const Vector2 *src = polygon.ptr();
+        Bounds b = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int j = 0; j < polygon.size(); j++) {
+            if (j == 0) {
+                b = { src[j].x, src[j].y, src[j].x, src[j].y };
+            }
+            b.min_x = std::min(b.min_x, src[j].x);
+            b.min_y = std::min(b.min_y, src[j].y);
+            b.max_x = std::max(b.max_x, src[j].x);
+            b.max_y = std::max(b.max_y, src[j].y);
+            points.push_back(src[j]);
+        }
+        polygon_start.push_back(static_cast<int>(points.size()));
+        bounds.push_back(b);
+    }
+    if (bounds.empty()) {
+        return;
+    }
+
+    // Cell ranges use truncation like MapGenerator.setup_area_spatial_grid
+    auto cell_of = [&](float v) { return static_cast<int>(static_cast<double>(v) / cell_size); };
+    int max_cell_x = 0;
+    int max_cell_y = 0;
+    for (size_t i = 0; i < bounds.size(); i++) {
+        int x0 = cell_of(bounds[i].min_x), y0 = cell_of(bounds[i].min_y);
+        int x1 = cell_of(bounds[i].max_x), y1 = cell_of(bounds[i].max_y);
+        if (i == 0) {
+            min_cell_x = x0;
+            min_cell_y = y0;
+            max_cell_x = x1;
+            max_cell_y = y1;
+        }
+        min_cell_x = std::min(min_cell_x, x0);
+        min_cell_y = std::min(min_cell_y, y0);
+        max_cell_x = std::max(max_cell_x, x1);
+        max_cell_y = std::max(max_cell_y, y1);
+    }
+    cols = max_cell_x - min_cell_x + 1;
+    rows = max_cell_y - min_cell_y + 1;
+
+    // Count, prefix-sum, fill; polygons are visited in order so cells stay ascending
+    cell_start.assign(static_cast<size_t>(cols) * rows + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<int> cursor;
+        if (pass == 1) {
+            for (size_t c = 1; c < cell_start.size(); c++) {
+                cell_start[c] += cell_start[c - 1];
+            }
+            cell_items.resize(cell_start.back());
+            cursor.assign(cell_start.begin(), cell_start.end() - 1);
+        }
+        for (int i = 0; i < polygon_count(); i++) {
+            int x0 = cell_of(bounds[i].min_x) - min_cell_x, y0 = cell_of(bounds[i].min_y) - min_cell_y;
+            int x1 = cell_of(bounds[i].max_x) - min_cell_x, y1 = cell_of(bounds[i].max_y) - min_cell_y;
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    size_t c = static_cast<size_t>(y) * cols + x;
+                    if (pass == 0) {
+                        cell_start[c + 1]++;
+                    } else {
+                        cell_items[cursor[c]++] = i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void PointLocator::clear() {
+    points.clear();
+    polygon_start.clear();
+    bounds.clear();
+    centers.clear();
+    cell_start.clear();
+    cell_items.clear();
+    cols = 0;
+    rows = 0;
+}
+
+int PointLocator::get_polygon_count() const {
+    return polygon_count();
+}
+
+// Geometry2D::is_point_in_polygon on polygon i
+bool PointLocator::contains(int polygon, const Vector2 &point) const {
+    const Bounds &b = bounds[polygon];
+    const Vector2 *p = points.data() + polygon_start[polygon];
+    const int c = polygon_start[polygon + 1] - polygon_start[polygon];
+    return polygon_contains_point(p, c, Vector2(b.min_x, b.min_y), Vector2(b.max_x, b.max_y), point);
+}
+
+int PointLocator::locate(const Vector2 &point, const uint8_t *mask, int mask_size) const {
+    if (cols == 0) {
+        return -1;
+    }
+    // Lookup uses floor like GeometryUtils.points_to_areas_mapping
+    int x = static_cast<int>(std::floor(point.x / cell_size)) - min_cell_x;
+    int y = static_cast<int>(std::floor(point.y / cell_size)) - min_cell_y;
+    if (x < 0 || y < 0 || x >= cols || y >= rows) {
+        return -1;
+    }
+    size_t c = static_cast<size_t>(y) * cols + x;
+    auto allowed = [&](int i) { return mask_size == 0 || (i < mask_size && mask[i] != 0); };
+
+    for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+        int i = cell_items[k];
+        if (allowed(i) && contains(i, point)) {
+            return i;
+        }
+    }
+
+    // Not inside any candidate: closest centre in the cell
+    int closest = -1;
+    real_t min_distance_squared = INFINITY;
+    for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+        int i = cell_items[k];
+        if (!allowed(i)) continue;
+        real_t dist_squared = point.distance_squared_to(centers[i]);
+        if (dist_squared < min_distance_squared) {
+            min_distance_squared = dist_squared;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+PackedInt32Array PointLocator::locate_points(const PackedVector2Array &query_points, const PackedByteArray &mask) const {
+    PackedInt32Array result;
+    ERR_FAIL_COND_V_MSG(!mask.is_empty() && mask.size() != polygon_count(), result,
+        vformat("Mask has %d entries for %d polygons", mask.size(), polygon_count()));
+
+    result.resize(query_points.size());
+    int32_t *dst = result.ptrw();
+    const Vector2 *src = query_points.ptr();
+    for (int i = 0; i < query_points.size(); i++) {
+        dst[i] = locate(src[i], mask.ptr(), mask.size());
+    }
+    return result;
+}
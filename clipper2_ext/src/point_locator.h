@@ -0,0 +1,60 @@
+#ifndef POINT_LOCATOR_H
+#define POINT_LOCATOR_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <vector>
+
+using namespace godot;
+
+// Point location over a fixed set of polygons (the static map areas).
+// Mirrors Global.SpatialGrid: every polygon is listed in the cells its bounds
+// cover, a point takes the first polygon of its cell that contains it (edges
+// count, as in Geometry2D.is_point_in_polygon) and otherwise the polygon of
+// its cell with the closest centre.
+class PointLocator : public RefCounted {
+    GDCLASS(PointLocator, RefCounted);
+
+private:
+    struct Bounds {
+        float min_x, min_y, max_x, max_y;
+    };
+
+    // Polygon i is points[polygon_start[i] .. polygon_start[i + 1])
+    std::vector<Vector2> points;
+    std::vector<int> polygon_start;
+    std::vector<Bounds> bounds;
+    std::vector<Vector2> centers;
+
+    double cell_size = 1.0;
+    int min_cell_x = 0;
+    int min_cell_y = 0;
+    int cols = 0;
+    int rows = 0;
+    // CSR layout: polygons of cell c are cell_items[cell_start[c] .. cell_start[c + 1]), ascending
+    std::vector<int> cell_start;
+    std::vector<int> cell_items;
+
+    int polygon_count() const { return static_cast<int>(bounds.size()); }
+    bool contains(int polygon, const Vector2 &point) const;
+    int locate(const Vector2 &point, const uint8_t *mask, int mask_size) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    // polygons[i] and centers[i] describe area i; cell_size is the grid pitch
+    // (Global.SpatialGrid.grid_cell_size to match its cells)
+    void build(const Array &polygons, const PackedVector2Array &p_centers, double p_cell_size);
+    void clear();
+    int get_polygon_count() const;
+
+    // One area index per point, -1 where no candidate exists. mask (one byte
+    // per area, nonzero = allowed) restricts the candidates; empty allows all.
+    PackedInt32Array locate_points(const PackedVector2Array &query_points, const PackedByteArray &mask = PackedByteArray()) const;
+};
+
+#endif // POINT_LOCATOR_H
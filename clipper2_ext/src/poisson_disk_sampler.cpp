@@ -0,0 +1,169 @@
+#include "poisson_disk_sampler.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+void PoissonDiskSampler::_bind_methods() {
+    ClassDB::bind_static_method(
+        "PoissonDiskSampler",
+        D_METHOD("sample", "rect", "min_distance", "max_points", "seed", "exclusion_mask", "mask_size"),
+        &PoissonDiskSampler::sample,
+        DEFVAL(PackedByteArray()),
+        DEFVAL(Vector2i())
+    );
+}
+
+// PCG32 (XSH-RR), same generator family as RandomNumberGenerator, but
+// independent of the standard library's distribution implementations
+struct Pcg32 {
+    uint64_t state = 0;
+    uint64_t inc = 1;
+
+    Pcg32(uint64_t seed, uint64_t stream) {
+        inc = (stream << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    // [0, 1)
+    double randf() { return next() * (1.0 / 4294967296.0); }
+
+    // [0, bound)
+    uint32_t below(uint32_t bound) { return static_cast<uint32_t>(randf() * bound); }
+};
+
+PackedVector2Array PoissonDiskSampler::sample(const Rect2 &rect, double min_distance, int max_points, int64_t seed,
+        const PackedByteArray &exclusion_mask, const Vector2i &mask_size) {
+    PackedVector2Array result;
+    ERR_FAIL_COND_V_MSG(!(min_distance > 0.0), result, "Minimum distance must be positive");
+    ERR_FAIL_COND_V_MSG(!(rect.size.x > 0.0f && rect.size.y > 0.0f), result, "Rect must have a positive size");
+    const bool masked = !exclusion_mask.is_empty();
+    ERR_FAIL_COND_V_MSG(masked && (mask_size.x <= 0 || mask_size.y <= 0
+            || exclusion_mask.size() != static_cast<int64_t>(mask_size.x) * mask_size.y),
+            result, "Exclusion mask must hold mask_size.x * mask_size.y bytes");
+
+    const int attempts_per_point = 30;
+    const double x0 = rect.position.x;
+    const double y0 = rect.position.y;
+    const double width = rect.size.x;
+    const double height = rect.size.y;
+    const double cell = min_distance / std::sqrt(2.0);
+    const int64_t cols = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(width / cell)));
+    const int64_t rows = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(height / cell)));
+    ERR_FAIL_COND_V_MSG(cols * rows > (int64_t(1) << 28), result, "Minimum distance is too small for the rect");
+
+    // At most one sample per cell (the cell diagonal is min_distance)
+    std::vector<int> grid(static_cast<size_t>(cols * rows), -1);
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<int> active;
+    const double min_distance_sq = min_distance * min_distance;
+    const uint8_t *mask = exclusion_mask.ptr();
+
+    auto cell_of = [&](double x, double y, int64_t &cx, int64_t &cy) {
+        cx = std::min(cols - 1, static_cast<int64_t>((x - x0) / cell));
+        cy = std::min(rows - 1, static_cast<int64_t>((y - y0) / cell));
+    };
+    auto acceptable = [&](double x, double y) {
+        if (x < x0 || y < y0 || x >= x0 + width || y >= y0 + height) {
+            return false;
+        }
+        if (masked) {
+            int64_t mx = std::min<int64_t>(mask_size.x - 1, static_cast<int64_t>((x - x0) / width * mask_size.x));
+            int64_t my = std::min<int64_t>(mask_size.y - 1, static_cast<int64_t>((y - y0) / height * mask_size.y));
+            if (mask[my * mask_size.x + mx] != 0) {
+                return false;
+            }
+        }
+        int64_t cx, cy;
+        cell_of(x, y, cx, cy);
+        for (int64_t gy = std::max<int64_t>(0, cy - 2); gy <= std::min(rows - 1, cy + 2); gy++) {
+            for (int64_t gx = std::max<int64_t>(0, cx - 2); gx <= std::min(cols - 1, cx + 2); gx++) {
+                int other = grid[gy * cols + gx];
+                if (other < 0) continue;
+                double dx = xs[other] - x;
+                double dy = ys[other] - y;
+                if (dx * dx + dy * dy < min_distance_sq) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    auto accept = [&](double x, double y) {
+        int64_t cx, cy;
+        cell_of(x, y, cx, cy);
+        grid[cy * cols + cx] = static_cast<int>(xs.size());
+        active.push_back(static_cast<int>(xs.size()));
+        xs.push_back(x);
+        ys.push_back(y);
+    };
+
+    Pcg32 rng(static_cast<uint64_t>(seed), 0xda3e39cb94b95bdbULL);
+
+    // Start anywhere outside the exclusion, as many tries as the old dart
+    // throwing would have spent on one point
+    for (int tries = 0; tries < attempts_per_point * 10 && xs.empty(); tries++) {
+        double x = x0 + rng.randf() * width;
+        double y = y0 + rng.randf() * height;
+        if (acceptable(x, y)) {
+            accept(x, y);
+        }
+    }
+
+    while (!active.empty()) {
+        const size_t pick = rng.below(static_cast<uint32_t>(active.size()));
+        const int from = active[pick];
+        bool placed = false;
+        for (int k = 0; k < attempts_per_point; k++) {
+            // Uniform over the annulus [min_distance, 2 * min_distance)
+            const double angle = rng.randf() * 6.283185307179586;
+            const double radius = min_distance * std::sqrt(1.0 + 3.0 * rng.randf());
+            const double x = xs[from] + radius * std::cos(angle);
+            const double y = ys[from] + radius * std::sin(angle);
+            if (acceptable(x, y)) {
+                accept(x, y);
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            active[pick] = active.back();
+            active.pop_back();
+        }
+    }
+
+    // Partial Fisher-Yates picks the kept subset
+    const size_t total = xs.size();
+    const size_t keep = max_points > 0 ? std::min(total, static_cast<size_t>(max_points)) : total;
+    std::vector<int> order(total);
+    for (size_t i = 0; i < total; i++) {
+        order[i] = static_cast<int>(i);
+    }
+    if (keep < total) {
+        for (size_t i = 0; i < keep; i++) {
+            size_t j = i + rng.below(static_cast<uint32_t>(total - i));
+            std::swap(order[i], order[j]);
+        }
+    }
+
+    result.resize(keep);
+    Vector2 *dst = result.ptrw();
+    for (size_t i = 0; i < keep; i++) {
+        dst[i] = Vector2(static_cast<real_t>(xs[order[i]]), static_cast<real_t>(ys[order[i]]));
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+#ifndef POISSON_DISK_SAMPLER_H
+#define POISSON_DISK_SAMPLER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+using namespace godot;
+
+// Bridson's Poisson-disk sampling on a background grid of cell size
+// min_distance / sqrt(2), so every candidate checks a constant number of
+// cells. Results depend only on the arguments (own PCG32 stream).
+class PoissonDiskSampler : public RefCounted {
+    GDCLASS(PoissonDiskSampler, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Points in rect no closer than min_distance to each other. max_points > 0
+    // keeps a random subset of the full sampling (still evenly spread) instead
+    // of stopping the growing front early. exclusion_mask is an optional
+    // mask_size.x * mask_size.y row-major grid stretched over rect; points on
+    // nonzero bytes are rejected.
+    static PackedVector2Array sample(const Rect2 &rect, double min_distance, int max_points, int64_t seed,
+            const PackedByteArray &exclusion_mask = PackedByteArray(), const Vector2i &mask_size = Vector2i());
+};
+
+#endif // POISSON_DISK_SAMPLER_H
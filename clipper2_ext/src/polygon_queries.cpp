@@ -0,0 +1,102 @@
+#include "polygon_queries.h"
+#include <godot_cpp/core/math.hpp>
+#include <limits>
+
+using namespace godot;
+
+// Geometry2D::segment_intersects_segment
+static bool segment_intersects_segment(const Vector2 &p_from_a, const Vector2 &p_to_a, const Vector2 &p_from_b, const Vector2 &p_to_b, Vector2 *r_result) {
+    Vector2 B = p_to_a - p_from_a;
+    Vector2 C = p_from_b - p_from_a;
+    Vector2 D = p_to_b - p_from_a;
+
+    real_t ABlen = B.dot(B);
+    if (ABlen <= 0) {
+        return false;
+    }
+    Vector2 Bn = B / ABlen;
+    C = Vector2(C.x * Bn.x + C.y * Bn.y, C.y * Bn.x - C.x * Bn.y);
+    D = Vector2(D.x * Bn.x + D.y * Bn.y, D.y * Bn.x - D.x * Bn.y);
+
+    // Fail if C x B and D x B have the same sign (segments don't intersect)
+    if ((C.y < (real_t)-CMP_EPSILON && D.y < (real_t)-CMP_EPSILON) || (C.y > (real_t)CMP_EPSILON && D.y > (real_t)CMP_EPSILON)) {
+        return false;
+    }
+    // Fail if segments are parallel or colinear
+    if (Math::is_equal_approx(C.y, D.y)) {
+        return false;
+    }
+    real_t ABpos = D.x + (C.x - D.x) * D.y / (D.y - C.y);
+    // Fail if segment C-D crosses line A-B outside of segment A-B
+    if ((ABpos < 0) || (ABpos > 1)) {
+        return false;
+    }
+    if (r_result) {
+        *r_result = p_from_a + B * ABpos;
+    }
+    return true;
+}
+
+bool polygon_contains_point(const Vector2 *ring, int count, const Vector2 &bounds_min, const Vector2 &bounds_max, const Vector2 &point) {
+    if (point.x < bounds_min.x || point.x > bounds_max.x || point.y < bounds_min.y || point.y > bounds_max.y) {
+        return false;
+    }
+    if (count < 3) {
+        return false;
+    }
+
+    // Make point outside that won't intersect with points in segment from point
+    Vector2 further_away = bounds_max;
+    further_away += (bounds_max - bounds_min) * Vector2(1.221313, 1.512312);
+
+    int intersections = 0;
+    for (int i = 0; i < count; i++) {
+        const Vector2 &v1 = ring[i];
+        const Vector2 &v2 = ring[(i + 1) % count];
+        Vector2 res;
+        if (segment_intersects_segment(v1, v2, point, further_away, &res)) {
+            intersections++;
+            if (res.is_equal_approx(point)) {
+                // Point is in one of the polygon edges
+                return true;
+            }
+        }
+    }
+    return (intersections & 1);
+}
+
+Vector2 closest_point_on_segment(const Vector2 &point, const Vector2 &a, const Vector2 &b) {
+    Vector2 p = point - a;
+    Vector2 n = b - a;
+    real_t l2 = n.length_squared();
+    if (l2 < 1e-20f) {
+        return a; // Both points are the same, just give any.
+    }
+    real_t d = n.dot(p) / l2;
+    if (d <= 0.0f) {
+        return a; // Before first point.
+    } else if (d >= 1.0f) {
+        return b; // After first point.
+    }
+    return a + n * d; // Inside.
+}
+
+Vector2 closest_point_on_ring(const Vector2 *ring, int count, const Vector2 &point, real_t *r_distance_squared) {
+    Vector2 closest = point;
+    real_t min_d2 = std::numeric_limits<real_t>::infinity();
+    for (int i = 0; i < count; i++) {
+        const Vector2 &a = ring[i];
+        const Vector2 &b = ring[(i + 1) % count];
+        if (a == b) continue;
+        Vector2 proj = closest_point_on_segment(point, a, b);
+        real_t d2 = point.distance_squared_to(proj);
+        if (d2 < min_d2) {
+            min_d2 = d2;
+            closest = proj;
+        }
+    }
+    if (r_distance_squared) {
+        *r_distance_squared = min_d2;
+    }
+    return closest;
+}
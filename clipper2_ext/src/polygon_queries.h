@@ -0,0 +1,23 @@
+#ifndef POLYGON_QUERIES_H
+#define POLYGON_QUERIES_H
+
+#include <godot_cpp/variant/vector2.hpp>
+
+using namespace godot;
+
+// Point queries on raw polygon rings that must agree with Geometry2D, kept
+// in real_t like the engine.
+
+// Geometry2D::is_point_in_polygon (edges count as inside). bounds_min and
+// bounds_max are the ring's bounds, used for the reject and the ray end.
+bool polygon_contains_point(const Vector2 *ring, int count, const Vector2 &bounds_min, const Vector2 &bounds_max, const Vector2 &point);
+
+// Geometry2D::get_closest_point_to_segment
+Vector2 closest_point_on_segment(const Vector2 &point, const Vector2 &a, const Vector2 &b);
+
+// Closest point on the closed ring's edges (zero-length edges skipped), as
+// GeometryUtils.clamp_point_to_polygon with accept_inside false; the squared
+// distance goes to r_distance_squared. Returns point for rings without edges.
+Vector2 closest_point_on_ring(const Vector2 *ring, int count, const Vector2 &point, real_t *r_distance_squared = nullptr);
+
+#endif // POLYGON_QUERIES_H
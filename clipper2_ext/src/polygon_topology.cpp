@@ -0,0 +1,253 @@
+#include "polygon_topology.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace godot;
+
+void PolygonTopology::_bind_methods() {
+    ClassDB::bind_static_method(
+        "PolygonTopology",
+        D_METHOD("shared_borders", "polygons"),
+        &PolygonTopology::shared_borders
+    );
+
+    ClassDB::bind_static_method(
+        "PolygonTopology",
+        D_METHOD("shared_border", "polygon_a", "polygon_b"),
+        &PolygonTopology::shared_border
+    );
+
+    ClassDB::bind_static_method(
+        "PolygonTopology",
+        D_METHOD("adjacency_graph", "polygons", "snap"),
+        &PolygonTopology::adjacency_graph,
+        DEFVAL(0.0)
+    );
+}
+
+// Exact vertex key; -0.0 and 0.0 compare equal in Godot, so they hash equal too
+static uint64_t vertex_key(const Vector2 &v) {
+    float x = v.x == 0.0f ? 0.0f : v.x;
+    float y = v.y == 0.0f ? 0.0f : v.y;
+    uint32_t xb, yb;
+    std::memcpy(&xb, &x, sizeof(xb));
+    std::memcpy(&yb, &y, sizeof(yb));
+    return (static_cast<uint64_t>(xb) << 32) | yb;
+}
+
+// Vertex key on a grid of pitch snap; points closer than snap usually (not
+// across a grid line) share the key
+static uint64_t snapped_vertex_key(const Vector2 &v, double snap) {
+    const double limit = static_cast<double>(INT32_MAX);
+    const int32_t qx = static_cast<int32_t>(std::clamp(std::round(v.x / snap), -limit, limit));
+    const int32_t qy = static_cast<int32_t>(std::clamp(std::round(v.y / snap), -limit, limit));
+    return (static_cast<uint64_t>(static_cast<uint32_t>(qx)) << 32) | static_cast<uint32_t>(qy);
+}
+
+struct SharedEdgeIndex {
+    // Dense vertex ids, so an undirected edge fits one 64-bit key
+    std::unordered_map<uint64_t, uint32_t> vertex_ids;
+    // Undirected edge -> (polygon, edge index) of every polygon that has it
+    std::unordered_map<uint64_t, std::vector<std::pair<int, int>>> edges;
+    // 0 keys vertices by exact equality
+    double snap = 0.0;
+
+    uint32_t vertex_id(const Vector2 &v) {
+        uint64_t key = snap > 0.0 ? snapped_vertex_key(v, snap) : vertex_key(v);
+        auto it = vertex_ids.emplace(key, static_cast<uint32_t>(vertex_ids.size()));
+        return it.first->second;
+    }
+
+    void add_polygon(int polygon, const PackedVector2Array &points) {
+        const Vector2 *src = points.ptr();
+        const int n = points.size();
+        if (n < 2) return;
+        for (int i = 0; i < n; i++) {
+            uint32_t a = vertex_id(src[i]);
+            uint32_t b = vertex_id(src[(i + 1) % n]);
+            if (a == b) continue;
+            uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            edges[key].emplace_back(polygon, i);
+        }
+    }
+};
+
+// Shared edge indices of `first` per pair (first, second), pairs ascending
+static std::vector<std::pair<std::pair<int, int>, std::vector<int>>> collect_shared_edges(const SharedEdgeIndex &index) {
+    std::vector<std::pair<std::pair<int, int>, int>> hits;
+    for (const auto &entry : index.edges) {
+        const auto &owners = entry.second;
+        for (size_t u = 0; u < owners.size(); u++) {
+            for (size_t w = u + 1; w < owners.size(); w++) {
+                const auto *a = &owners[u];
+                const auto *b = &owners[w];
+                if (a->first == b->first) continue;
+                if (b->first < a->first) std::swap(a, b);
+                hits.push_back({ { a->first, b->first }, a->second });
+            }
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+
+    std::vector<std::pair<std::pair<int, int>, std::vector<int>>> pairs;
+    for (const auto &hit : hits) {
+        if (pairs.empty() || pairs.back().first != hit.first) {
+            pairs.push_back({ hit.first, {} });
+        }
+        std::vector<int> &edge_indices = pairs.back().second;
+        if (edge_indices.empty() || edge_indices.back() != hit.second) {
+            edge_indices.push_back(hit.second);
+        }
+    }
+    return pairs;
+}
+
+// Chains sorted edge indices of a polygon into polylines: an edge continues
+// the chain when it starts where the previous one ended (so zero-length edges
+// in between do not split it). The chain holding the lowest index comes first.
+static void append_runs(const PackedVector2Array &polygon, const std::vector<int> &edge_indices,
+        std::vector<Vector2> &points, std::vector<int32_t> &offsets, size_t max_runs) {
+    const int n = polygon.size();
+    const Vector2 *src = polygon.ptr();
+    const size_t count = edge_indices.size();
+    auto edge_start = [&](size_t k) { return src[edge_indices[k % count]]; };
+    auto edge_end = [&](size_t k) { return src[(edge_indices[k % count] + 1) % n]; };
+
+    // A chain wrapping past the last edge starts further back
+    size_t start = count;
+    for (size_t steps = 0; steps + 1 < count && edge_end(start - 1) == edge_start(start); steps++) {
+        start--;
+    }
+    start %= count;
+
+    size_t runs = 0;
+    size_t k = 0;
+    while (k < count && runs < max_runs) {
+        points.push_back(edge_start(start + k));
+        points.push_back(edge_end(start + k));
+        k++;
+        while (k < count && edge_start(start + k) == points.back()) {
+            points.push_back(edge_end(start + k));
+            k++;
+        }
+        offsets.push_back(static_cast<int32_t>(points.size()));
+        runs++;
+    }
+}
+
+Array PolygonTopology::shared_borders(const Array &polygons) {
+    std::vector<PackedVector2Array> rings(polygons.size());
+    SharedEdgeIndex index;
+    for (int i = 0; i < polygons.size(); i++) {
+        rings[i] = polygons[i];
+        index.add_polygon(i, rings[i]);
+    }
+
+    PackedInt32Array first;
+    PackedInt32Array second;
+    std::vector<Vector2> points;
+    std::vector<int32_t> offsets(1, 0);
+    std::vector<int32_t> border_pairs;
+    for (const auto &pair : collect_shared_edges(index)) {
+        int pair_index = first.size();
+        first.append(pair.first.first);
+        second.append(pair.first.second);
+        size_t borders_before = offsets.size();
+        append_runs(rings[pair.first.first], pair.second, points, offsets, pair.second.size());
+        border_pairs.insert(border_pairs.end(), offsets.size() - borders_before, pair_index);
+    }
+
+    PackedVector2Array out_points;
+    out_points.resize(points.size());
+    std::copy(points.begin(), points.end(), out_points.ptrw());
+    PackedInt32Array out_offsets;
+    out_offsets.resize(offsets.size());
+    std::copy(offsets.begin(), offsets.end(), out_offsets.ptrw());
+    PackedInt32Array out_pairs;
+    out_pairs.resize(border_pairs.size());
+    std::copy(border_pairs.begin(), border_pairs.end(), out_pairs.ptrw());
+
+    Array result;
+    result.append(first);
+    result.append(second);
+    result.append(out_points);
+    result.append(out_offsets);
+    result.append(out_pairs);
+    return result;
+}
+
+PackedVector2Array PolygonTopology::shared_border(const PackedVector2Array &polygon_a, const PackedVector2Array &polygon_b) {
+    SharedEdgeIndex index;
+    index.add_polygon(0, polygon_a);
+    index.add_polygon(1, polygon_b);
+    PackedVector2Array border;
+    auto pairs = collect_shared_edges(index);
+    if (pairs.empty()) {
+        return border;
+    }
+    std::vector<Vector2> points;
+    std::vector<int32_t> offsets(1, 0);
+    append_runs(polygon_a, pairs[0].second, points, offsets, 1);
+    border.resize(points.size());
+    std::copy(points.begin(), points.end(), border.ptrw());
+    return border;
+}
+
+Array PolygonTopology::adjacency_graph(const Array &polygons, double snap) {
+    const int count = polygons.size();
+    SharedEdgeIndex index;
+    index.snap = snap;
+    for (int i = 0; i < count; i++) {
+        PackedVector2Array polygon = polygons[i];
+        // Matches GeometryUtils.are_polygons_adjacent: fewer than three
+        // distinct points is not a polygon
+        int distinct = 0;
+        for (int j = 0; j < polygon.size() && distinct < 3; j++) {
+            if (j == 0 || index.vertex_id(polygon[j]) != index.vertex_id(polygon[j - 1])) {
+                distinct++;
+            }
+        }
+        if (distinct >= 3) {
+            index.add_polygon(i, polygon);
+        }
+    }
+
+    std::vector<std::vector<int32_t>> neighbours(count);
+    for (const auto &entry : index.edges) {
+        const auto &owners = entry.second;
+        for (size_t u = 0; u < owners.size(); u++) {
+            for (size_t w = u + 1; w < owners.size(); w++) {
+                int a = owners[u].first;
+                int b = owners[w].first;
+                if (a == b) continue;
+                neighbours[a].push_back(b);
+                neighbours[b].push_back(a);
+            }
+        }
+    }
+
+    PackedInt32Array offsets;
+    offsets.resize(count + 1);
+    offsets.set(0, 0);
+    PackedInt32Array flat;
+    for (int i = 0; i < count; i++) {
+        std::vector<int32_t> &list = neighbours[i];
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        for (int32_t other : list) {
+            flat.append(other);
+        }
+        offsets.set(i + 1, flat.size());
+    }
+
+    Array result;
+    result.append(offsets);
+    result.append(flat);
+    return result;
+}
@@ -0,0 +1,41 @@
+#ifndef POLYGON_TOPOLOGY_H
+#define POLYGON_TOPOLOGY_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+using namespace godot;
+
+// Topology of polygon sets that share exact vertices (map cells, unions of
+// cells): edges are hashed once, so every query is linear in the vertex count.
+class PolygonTopology : public RefCounted {
+    GDCLASS(PolygonTopology, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Shared borders of every pair of polygons with a common edge (either
+    // direction, exact vertex equality). Each border is a maximal run of
+    // shared edges, in the direction of the earlier polygon of the pair.
+    // Returns [PackedInt32Array first, PackedInt32Array second,
+    // PackedVector2Array points, PackedInt32Array border_offsets,
+    // PackedInt32Array border_pairs]: pair p is (first[p], second[p]) with
+    // first < second, border b is points[border_offsets[b] .. border_offsets[b + 1])
+    // and belongs to pair border_pairs[b]. Pairs ascend, borders of a pair
+    // start from the lowest shared edge of first.
+    static Array shared_borders(const Array &polygons);
+
+    // First border between two polygons (empty if none), as shared_borders
+    static PackedVector2Array shared_border(const PackedVector2Array &polygon_a, const PackedVector2Array &polygon_b);
+
+    // Polygons sharing at least one edge, in CSR form: [PackedInt32Array
+    // offsets, PackedInt32Array neighbours], the neighbours of polygon i being
+    // neighbours[offsets[i] .. offsets[i + 1]), ascending. snap > 0 compares
+    // vertices on a grid of that pitch instead of exactly.
+    static Array adjacency_graph(const Array &polygons, double snap = 0.0);
+};
+
+#endif // POLYGON_TOPOLOGY_H
@@ -1,4 +1,15 @@
+#include "agent_store.h"
+#include "assignment_solver.h"
 #include "clipper2_open.h"
+#include "navigation_cache.h"
+#include "navmesh_builder.h"
+#include "point_locator.h"
+#include "poisson_disk_sampler.h"
+#include "polygon_topology.h"
+#include "terrain_rasterizer.h"
+#include "trail_buffer.h"
+#include "voronoi_diagram.h"
+#include "weighted_visvalingam.h"
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/godot.hpp>
 
@@ -7,6 +18,17 @@ using namespace godot;
 void initialize_clipper2_ext_module(ModuleInitializationLevel p_level) {
     if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
         ClassDB::register_class<Clipper2Open>();
+        ClassDB::register_class<WeightedVisvalingam>();
+        ClassDB::register_class<PointLocator>();
+        ClassDB::register_class<PolygonTopology>();
+        ClassDB::register_class<VoronoiDiagram>();
+        ClassDB::register_class<PoissonDiskSampler>();
+        ClassDB::register_class<AssignmentSolver>();
+        ClassDB::register_class<AgentStore>();
+        ClassDB::register_class<NavigationCache>();
+        ClassDB::register_class<NavmeshBuilder>();
+        ClassDB::register_class<TrailBuffer>();
+        ClassDB::register_class<TerrainRasterizer>();
     }
 }
 
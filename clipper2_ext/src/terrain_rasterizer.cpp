@@ -0,0 +1,720 @@
+#include "terrain_rasterizer.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+using namespace godot;
+
+void TerrainRasterizer::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("set_parallel", "enabled", "thread_count"),
+        &TerrainRasterizer::set_parallel,
+        DEFVAL(0)
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("is_parallel"),
+        &TerrainRasterizer::is_parallel
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("generate_noise", "size", "seeds", "recipe"),
+        &TerrainRasterizer::generate_noise
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("rasterize_mountain", "polygon", "origin", "width", "height", "centroid", "ridge_points", "ridge_levels", "shading", "seed"),
+        &TerrainRasterizer::rasterize_mountain
+    );
+}
+
+void TerrainRasterizer::set_parallel(bool enabled, int thread_count) {
+    if (!enabled) {
+        pool.reset();
+        return;
+    }
+    if (pool && thread_count > 0 && pool->get_thread_count() == thread_count) {
+        return;
+    }
+    pool = std::make_unique<WorkerPool>(thread_count);
+}
+
+bool TerrainRasterizer::is_parallel() const {
+    return pool != nullptr;
+}
+
+// --- Helpers ---
+
+static constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+// Splits [0, count) into contiguous bands, on the pool when there is one
+static void run_bands(WorkerPool *pool, int count, const std::function<void(int, int)> &band) {
+    const int threads = pool != nullptr ? pool->get_thread_count() : 1;
+    const int band_count = std::max(1, std::min(count, threads * 4));
+    const std::function<void(size_t)> job = [&](size_t b) {
+        const int begin = static_cast<int>(static_cast<int64_t>(count) * static_cast<int64_t>(b) / band_count);
+        const int end = static_cast<int>(static_cast<int64_t>(count) * static_cast<int64_t>(b + 1) / band_count);
+        band(begin, end);
+    };
+    if (pool != nullptr) {
+        pool->run(band_count, job);
+        return;
+    }
+    for (int b = 0; b < band_count; b++) {
+        job(b);
+    }
+}
+
+static inline uint32_t hash_u32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+// Jitter angles are drawn from a table of JITTER_STEPS rotations over
+// [-jitter, jitter), indexed by a hash of seed, pixel and channel
+static constexpr int JITTER_BITS = 12;
+static constexpr int JITTER_STEPS = 1 << JITTER_BITS;
+
+static inline int jitter_index(uint32_t seed, int x, int y, uint32_t channel) {
+    const uint32_t h = hash_u32(seed ^ hash_u32(static_cast<uint32_t>(x) * 0x9e3779b1U ^ hash_u32(static_cast<uint32_t>(y) + channel * 0x85ebca77U)));
+    return static_cast<int>(h >> (32 - JITTER_BITS));
+}
+
+static inline uint8_t to_byte(double v) {
+    return static_cast<uint8_t>(std::clamp(v * 255.0, 0.0, 255.0));
+}
+
+// Squared 1D distance transform of sampled f (Felzenszwalb-Huttenlocher):
+// d[q] = min_p (q - p)^2 + f[p]. v and z need n and n + 1 entries.
+static void distance_transform_1d(const double *f, int n, double *d, int *v, double *z) {
+    const double inf = std::numeric_limits<double>::infinity();
+    int k = 0;
+    v[0] = 0;
+    z[0] = -inf;
+    z[1] = inf;
+    for (int q = 1; q < n; q++) {
+        // z[0] is -inf, so k never drops below 0
+        double s = ((f[q] + static_cast<double>(q) * q) - (f[v[k]] + static_cast<double>(v[k]) * v[k])) / (2.0 * (q - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + static_cast<double>(q) * q) - (f[v[k]] + static_cast<double>(v[k]) * v[k])) / (2.0 * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = inf;
+    }
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        const double dq = static_cast<double>(q - v[k]);
+        d[q] = dq * dq + f[v[k]];
+    }
+}
+
+// --- Ridge segment index ---
+
+namespace {
+
+struct RidgeSegment {
+    double ax, ay, bx, by;
+    double scale;
+    int level;
+};
+
+struct RidgeHit {
+    int index = -1;
+    double distance_eff = std::numeric_limits<double>::infinity();
+    double proj_x = 0.0;
+    double proj_y = 0.0;
+};
+
+static inline double segment_distance_squared(const RidgeSegment &s, double px, double py, double &r_qx, double &r_qy) {
+    const double ex = s.bx - s.ax, ey = s.by - s.ay;
+    const double len2 = ex * ex + ey * ey;
+    double t = 0.0;
+    if (len2 > 0.0) {
+        t = std::clamp(((px - s.ax) * ex + (py - s.ay) * ey) / len2, 0.0, 1.0);
+    }
+    r_qx = s.ax + ex * t;
+    r_qy = s.ay + ey * t;
+    return (px - r_qx) * (px - r_qx) + (py - r_qy) * (py - r_qy);
+}
+
+// Candidate lists over a grid of the texture: a cell keeps the segments
+// whose scaled distance from some point of the cell can be the smallest,
+// from bounds around the cell centre. A pixel then tests only its cell's
+// candidates.
+struct RidgeIndex {
+    static constexpr int CELL_PX = 16;
+
+    std::vector<RidgeSegment> segments;
+    double origin_x = 0.0;
+    double origin_y = 0.0;
+    int cols = 0;
+    int rows = 0;
+    // CSR layout: candidates of cell c are cell_segments[cell_start[c] .. cell_start[c + 1])
+    std::vector<int> cell_start;
+    std::vector<int> cell_segments;
+
+    void build(WorkerPool *worker_pool, double p_origin_x, double p_origin_y, int width, int height) {
+        origin_x = p_origin_x;
+        origin_y = p_origin_y;
+        cols = (width + CELL_PX - 1) / CELL_PX;
+        rows = (height + CELL_PX - 1) / CELL_PX;
+        const double half_diagonal = CELL_PX * 0.70710678118654752;
+        std::vector<std::vector<int>> row_candidates(rows);
+        std::vector<std::vector<int>> row_counts(rows);
+        run_bands(worker_pool, rows, [&](int r_begin, int r_end) {
+            std::vector<double> centre_distance(segments.size());
+            for (int r = r_begin; r < r_end; r++) {
+                row_counts[r].assign(cols, 0);
+                const double cy = origin_y + (r + 0.5) * CELL_PX;
+                for (int c = 0; c < cols; c++) {
+                    const double cx = origin_x + (c + 0.5) * CELL_PX;
+                    double bound = std::numeric_limits<double>::infinity();
+                    for (size_t i = 0; i < segments.size(); i++) {
+                        double qx, qy;
+                        centre_distance[i] = std::sqrt(segment_distance_squared(segments[i], cx, cy, qx, qy));
+                        bound = std::min(bound, (centre_distance[i] + half_diagonal) * segments[i].scale);
+                    }
+                    for (size_t i = 0; i < segments.size(); i++) {
+                        if (std::max(centre_distance[i] - half_diagonal, 0.0) * segments[i].scale <= bound) {
+                            row_candidates[r].push_back(static_cast<int>(i));
+                            row_counts[r][c]++;
+                        }
+                    }
+                }
+            }
+        });
+        cell_start.assign(static_cast<size_t>(cols) * rows + 1, 0);
+        cell_segments.clear();
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                cell_start[static_cast<size_t>(r) * cols + c + 1] = cell_start[static_cast<size_t>(r) * cols + c] + row_counts[r][c];
+            }
+            cell_segments.insert(cell_segments.end(), row_candidates[r].begin(), row_candidates[r].end());
+        }
+    }
+
+    // Nearest segment by scaled distance, lowest index on ties, for pixel
+    // (x, y) sampled at (px, py)
+    RidgeHit nearest(int x, int y, double px, double py) const {
+        RidgeHit best;
+        if (segments.empty()) {
+            return best;
+        }
+        const size_t cell = static_cast<size_t>(y / CELL_PX) * cols + x / CELL_PX;
+        double best_squared = std::numeric_limits<double>::infinity();
+        for (int k = cell_start[cell]; k < cell_start[cell + 1]; k++) {
+            const int i = cell_segments[k];
+            const RidgeSegment &s = segments[i];
+            double qx, qy;
+            const double d2 = segment_distance_squared(s, px, py, qx, qy) * (s.scale * s.scale);
+            if (d2 < best_squared) {
+                best_squared = d2;
+                best.index = i;
+                best.proj_x = qx;
+                best.proj_y = qy;
+            }
+        }
+        best.distance_eff = std::sqrt(best_squared);
+        return best;
+    }
+};
+
+} // namespace
+
+// --- Mountains ---
+
+TerrainRasterizer::MountainShading TerrainRasterizer::read_mountain_shading(const Dictionary &shading) {
+    MountainShading s;
+    s.base_color = shading.get("base_color", s.base_color);
+    s.background_color = shading.get("background_color", s.background_color);
+    s.light_dir = shading.get("light_dir", s.light_dir);
+    s.light_z = shading.get("light_z", s.light_z);
+    s.bright_min = shading.get("bright_min", s.bright_min);
+    s.bright_max = shading.get("bright_max", s.bright_max);
+    s.jitter_deg = shading.get("jitter_deg", s.jitter_deg);
+    s.base_slope_deg = shading.get("base_slope_deg", s.base_slope_deg);
+    s.base_edge_exp = shading.get("base_edge_exp", s.base_edge_exp);
+    s.ridge_slope_deg = shading.get("ridge_slope_deg", s.ridge_slope_deg);
+    s.ridge_width_l1 = shading.get("ridge_width_l1", s.ridge_width_l1);
+    s.ridge_width_l2 = shading.get("ridge_width_l2", s.ridge_width_l2);
+    s.ridge_sharpness_pow = shading.get("ridge_sharpness_pow", s.ridge_sharpness_pow);
+    s.min_width_px = shading.get("min_width_px", s.min_width_px);
+    s.ridge_level_width_factor = shading.get("ridge_level_width_factor", s.ridge_level_width_factor);
+    s.ridge_distance_strength = shading.get("ridge_distance_strength", s.ridge_distance_strength);
+    s.ridge_eps = shading.get("ridge_eps", s.ridge_eps);
+    s.ridge_secondary_distance_bias = shading.get("ridge_secondary_distance_bias", s.ridge_secondary_distance_bias);
+    s.subpixel_offset = shading.get("subpixel_offset", s.subpixel_offset);
+    return s;
+}
+
+PackedByteArray TerrainRasterizer::rasterize_mountain(const PackedVector2Array &polygon, const Vector2 &origin,
+        int width, int height, const Vector2 &centroid, const PackedVector2Array &ridge_points,
+        const PackedInt32Array &ridge_levels, const Dictionary &shading, int64_t seed) const {
+    return rasterize_mountain_with(polygon, origin, width, height, centroid, ridge_points, ridge_levels,
+            read_mountain_shading(shading), seed);
+}
+
+PackedByteArray TerrainRasterizer::rasterize_mountain_with(const PackedVector2Array &polygon, const Vector2 &origin,
+        int width, int height, const Vector2 &centroid, const PackedVector2Array &ridge_points,
+        const PackedInt32Array &ridge_levels, const MountainShading &shading, int64_t seed) const {
+    PackedByteArray pixels;
+    ERR_FAIL_COND_V_MSG(width < 1 || height < 1, pixels, "Texture size must be positive");
+    ERR_FAIL_COND_V_MSG(ridge_points.size() != ridge_levels.size() * 2, pixels, "Two ridge points per ridge level are required");
+    ERR_FAIL_COND_V_MSG(!(shading.ridge_secondary_distance_bias > 0.0), pixels, "Ridge distance bias must be positive");
+
+    const int64_t pixel_count = static_cast<int64_t>(width) * height;
+    pixels.resize(pixel_count * 4);
+    uint8_t *out = pixels.ptrw();
+    std::fill(out, out + pixel_count * 4, static_cast<uint8_t>(0));
+
+    const int n = static_cast<int>(polygon.size());
+    if (n < 3) {
+        return pixels;
+    }
+    const Vector2 *poly = polygon.ptr();
+    WorkerPool *worker_pool = pool.get();
+    const double off = shading.subpixel_offset;
+    const double ox = origin.x + off;
+    const double oy = origin.y + off;
+
+    // 1. Scanline fill (even-odd), one crossing list per row
+    std::vector<uint8_t> inside(pixel_count, 0);
+    run_bands(worker_pool, height, [&](int y_begin, int y_end) {
+        std::vector<double> crossings;
+        for (int y = y_begin; y < y_end; y++) {
+            const double yc = oy + y;
+            crossings.clear();
+            for (int i = 0; i < n; i++) {
+                const Vector2 &a = poly[i];
+                const Vector2 &b = poly[i + 1 == n ? 0 : i + 1];
+                if ((static_cast<double>(a.y) > yc) != (static_cast<double>(b.y) > yc)) {
+                    crossings.push_back(a.x + (yc - a.y) * (static_cast<double>(b.x) - a.x) / (static_cast<double>(b.y) - a.y));
+                }
+            }
+            std::sort(crossings.begin(), crossings.end());
+            uint8_t *row = inside.data() + static_cast<int64_t>(y) * width;
+            for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+                // Pixels whose sample x lies in [left, right)
+                const int x0 = std::max(0, static_cast<int>(std::ceil(crossings[k] - ox)));
+                const int x1 = std::min(width, static_cast<int>(std::ceil(crossings[k + 1] - ox)));
+                for (int x = x0; x < x1; x++) {
+                    row[x] = 1;
+                }
+            }
+        }
+    });
+
+    // 2. Exact Euclidean distance transform to the nearest outside sample, on
+    // a grid padded by one outside pixel. Half a pixel is taken off since the
+    // edge lies between the samples.
+    const int pw = width + 2;
+    const int ph = height + 2;
+    // Inside samples start far beyond any real squared distance
+    const double far = 1e20;
+    std::vector<double> field(static_cast<int64_t>(pw) * ph, 0.0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (inside[static_cast<int64_t>(y) * width + x]) {
+                field[static_cast<int64_t>(y + 1) * pw + x + 1] = far;
+            }
+        }
+    }
+    run_bands(worker_pool, pw, [&](int x_begin, int x_end) {
+        std::vector<double> f(ph), d(ph), z(ph + 1);
+        std::vector<int> v(ph);
+        for (int x = x_begin; x < x_end; x++) {
+            for (int y = 0; y < ph; y++) {
+                f[y] = field[static_cast<int64_t>(y) * pw + x];
+            }
+            distance_transform_1d(f.data(), ph, d.data(), v.data(), z.data());
+            for (int y = 0; y < ph; y++) {
+                field[static_cast<int64_t>(y) * pw + x] = d[y];
+            }
+        }
+    });
+    std::vector<float> edge_distance(pixel_count, -1.0f);
+    std::mutex max_mutex;
+    double max_edge_distance = 0.0;
+    run_bands(worker_pool, height, [&](int y_begin, int y_end) {
+        std::vector<double> d(pw), z(pw + 1);
+        std::vector<int> v(pw);
+        double local_max = 0.0;
+        for (int y = y_begin; y < y_end; y++) {
+            const double *f = field.data() + static_cast<int64_t>(y + 1) * pw;
+            distance_transform_1d(f, pw, d.data(), v.data(), z.data());
+            for (int x = 0; x < width; x++) {
+                const int64_t idx = static_cast<int64_t>(y) * width + x;
+                if (inside[idx]) {
+                    const double e = std::max(std::sqrt(d[x + 1]) - 0.5, 0.0);
+                    edge_distance[idx] = static_cast<float>(e);
+                    local_max = std::max(local_max, e);
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(max_mutex);
+        max_edge_distance = std::max(max_edge_distance, local_max);
+    });
+
+    // 3. Ridge segments, farther levels weighted by the secondary bias
+    RidgeIndex ridges;
+    ridges.segments.resize(ridge_levels.size());
+    for (int k = 0; k < static_cast<int>(ridge_levels.size()); k++) {
+        RidgeSegment &s = ridges.segments[k];
+        s.ax = ridge_points[2 * k].x;
+        s.ay = ridge_points[2 * k].y;
+        s.bx = ridge_points[2 * k + 1].x;
+        s.by = ridge_points[2 * k + 1].y;
+        s.level = ridge_levels[k];
+        s.scale = s.level > 1 ? shading.ridge_secondary_distance_bias : 1.0;
+    }
+    ridges.build(worker_pool, ox, oy, width, height);
+
+    // 4. Shading
+    const double jitter_rad = shading.jitter_deg * DEG_TO_RAD;
+    const double light_x = -shading.light_dir.x;
+    const double light_y = -shading.light_dir.y;
+    const double l_len = std::sqrt(light_x * light_x + light_y * light_y + shading.light_z * shading.light_z);
+    const double lx = l_len > 0.0 ? light_x / l_len : 0.0;
+    const double ly = l_len > 0.0 ? light_y / l_len : 0.0;
+    const double lz = l_len > 0.0 ? shading.light_z / l_len : 1.0;
+    const double base_slope = std::tan(shading.base_slope_deg * DEG_TO_RAD);
+    const double ridge_slope = std::tan(shading.ridge_slope_deg * DEG_TO_RAD);
+    const uint32_t seed32 = static_cast<uint32_t>(seed) ^ static_cast<uint32_t>(static_cast<uint64_t>(seed) >> 32);
+    const Color &base = shading.base_color;
+    const Color &bg = shading.background_color;
+
+    std::vector<double> jitter_cos(JITTER_STEPS), jitter_sin(JITTER_STEPS);
+    for (int i = 0; i < JITTER_STEPS; i++) {
+        const double yaw = jitter_rad * ((2.0 * i + 1.0) / JITTER_STEPS - 1.0);
+        jitter_cos[i] = std::cos(yaw);
+        jitter_sin[i] = std::sin(yaw);
+    }
+
+    run_bands(worker_pool, height, [&](int y_begin, int y_end) {
+        for (int y = y_begin; y < y_end; y++) {
+            const double py = oy + y;
+            for (int x = 0; x < width; x++) {
+                const int64_t idx = static_cast<int64_t>(y) * width + x;
+                const double edge_dist = edge_distance[idx];
+                if (edge_dist < 0.0) {
+                    continue;
+                }
+                const double px = ox + x;
+
+                // Facet light from the jittered outward direction
+                const double out_x = px - centroid.x, out_y = py - centroid.y;
+                const double out_len = std::sqrt(out_x * out_x + out_y * out_y);
+                double dir_x = 0.0, dir_y = -1.0;
+                if (out_len > 0.0) {
+                    dir_x = out_x / out_len;
+                    dir_y = out_y / out_len;
+                }
+                const int yaw = jitter_index(seed32, x, y, 0);
+                const double cy = jitter_cos[yaw], sy = jitter_sin[yaw];
+                const double d_l = std::clamp((dir_x * cy - dir_y * sy) * light_x + (dir_x * sy + dir_y * cy) * light_y, -1.0, 1.0);
+                const double f_light = shading.bright_min + (shading.bright_max - shading.bright_min) * (d_l + 1.0) * 0.5;
+
+                // Normal: base mound plus the tilt across the nearest ridge
+                double nx = 0.0, ny = 0.0;
+                if (base_slope != 0.0 && max_edge_distance > 0.0 && out_len > 0.0) {
+                    const double t_edge = 1.0 - std::clamp(edge_dist / max_edge_distance, 0.0, 1.0);
+                    const double m_base = base_slope * std::pow(t_edge, shading.base_edge_exp);
+                    nx += m_base * dir_x;
+                    ny += m_base * dir_y;
+                }
+                double ridge_distance_mul = 1.0;
+                const RidgeHit hit = ridges.nearest(x, y, px, py);
+                if (hit.index >= 0) {
+                    const RidgeSegment &s = ridges.segments[hit.index];
+                    const double ex = s.bx - s.ax, ey = s.by - s.ay;
+                    const double e_len = std::sqrt(ex * ex + ey * ey);
+                    if (e_len > 0.0) {
+                        double level_width = 1.0 / (static_cast<double>(s.level) * shading.ridge_level_width_factor);
+                        if (!(level_width > 0.0)) {
+                            level_width = shading.ridge_eps;
+                        }
+                        const double atten = std::max(hit.distance_eff / level_width, 0.0);
+                        ridge_distance_mul = std::min(std::sqrt(std::sqrt(shading.ridge_distance_strength * atten)), 1.0);
+
+                        const int ridge_yaw = jitter_index(seed32, x, y, 1);
+                        const double rc = jitter_cos[ridge_yaw], rs = jitter_sin[ridge_yaw];
+                        const double perp_x = -ey / e_len, perp_y = ex / e_len;
+                        const double n2_x = perp_x * rc - perp_y * rs;
+                        const double n2_y = perp_x * rs + perp_y * rc;
+                        const double rel_x = px - hit.proj_x, rel_y = py - hit.proj_y;
+                        const double side = rel_x * n2_x + rel_y * n2_y >= 0.0 ? 1.0 : -1.0;
+                        const double cross_distance = std::sqrt(rel_x * rel_x + rel_y * rel_y);
+                        const double ridge_width = std::max(s.level <= 1 ? shading.ridge_width_l1 : shading.ridge_width_l2, shading.min_width_px);
+                        const double u = std::clamp(cross_distance / ridge_width, 0.0, 1.0);
+                        const double m_ridge = u < 1.0 ? ridge_slope * std::pow(1.0 - u, shading.ridge_sharpness_pow) : 0.0;
+                        nx += m_ridge * side * n2_x;
+                        ny += m_ridge * side * n2_y;
+                    }
+                }
+                const double n_len = std::sqrt(nx * nx + ny * ny + 1.0);
+                const double lambert = std::max((nx * lx + ny * ly + lz) / n_len, 0.0);
+                const double ridge_normal_mul = lambert * 0.5 + lambert * lambert * 0.5;
+
+                const double t_norm = max_edge_distance > 0.0 ? edge_dist / max_edge_distance : 0.0;
+                const double eased = std::min(std::sqrt(t_norm), 0.75);
+                const double k = 0.75 * ridge_normal_mul + 0.75 * f_light;
+                const double alpha = std::clamp(base.a * k, 0.0, 1.0);
+                const double inv = 1.0 - ridge_distance_mul;
+                const double prox = std::min(1.0, 0.5 + eased * 0.5 + std::min(1.0, 2.0 * eased * eased * inv * inv * inv));
+
+                uint8_t *p = out + idx * 4;
+                p[0] = to_byte((base.r * k * alpha + bg.r * (1.0 - alpha)) * prox);
+                p[1] = to_byte((base.g * k * alpha + bg.g * (1.0 - alpha)) * prox);
+                p[2] = to_byte((base.b * k * alpha + bg.b * (1.0 - alpha)) * prox);
+                p[3] = 255;
+            }
+        }
+    });
+
+    return pixels;
+}
+
+// --- Noise ---
+
+namespace {
+
+// 2D OpenSimplex2 and value noise with an FBm fractal, following
+// FastNoiseLite (MIT, Jordan Peck), which backs Godot's FastNoiseLite
+// resource; lacunarity 2, gain 0.5 and no weighting as in its defaults.
+struct FractalNoise {
+    enum Type {
+        SIMPLEX,
+        VALUE,
+    };
+
+    static constexpr int32_t PRIME_X = 501125321;
+    static constexpr int32_t PRIME_Y = 1136930381;
+
+    Type type = SIMPLEX;
+    int32_t seed = 0;
+    float frequency = 0.01f;
+    int octaves = 5;
+    float bounding = 1.0f;
+
+    FractalNoise(Type p_type, int32_t p_seed, float p_frequency, int p_octaves) :
+            type(p_type), seed(p_seed), frequency(p_frequency), octaves(std::max(p_octaves, 1)) {
+        float amp = 0.5f;
+        float amp_fractal = 1.0f;
+        for (int i = 1; i < octaves; i++) {
+            amp_fractal += amp;
+            amp *= 0.5f;
+        }
+        bounding = 1.0f / amp_fractal;
+    }
+
+    // 24 directions 15 degrees apart, five times over, then 8 directions
+    // 45 degrees apart (128 gradients)
+    static const float *gradients() {
+        static const std::vector<float> table = [] {
+            std::vector<float> g;
+            g.reserve(256);
+            for (int repeat = 0; repeat < 5; repeat++) {
+                for (int k = 0; k < 24; k++) {
+                    const double angle = (82.5 - 15.0 * k) * DEG_TO_RAD;
+                    g.push_back(static_cast<float>(std::cos(angle)));
+                    g.push_back(static_cast<float>(std::sin(angle)));
+                }
+            }
+            for (int k = 0; k < 8; k++) {
+                const double angle = (67.5 - 45.0 * k) * DEG_TO_RAD;
+                g.push_back(static_cast<float>(std::cos(angle)));
+                g.push_back(static_cast<float>(std::sin(angle)));
+            }
+            return g;
+        }();
+        return table.data();
+    }
+
+    static inline int fast_floor(float f) {
+        return f >= 0 ? static_cast<int>(f) : static_cast<int>(f) - 1;
+    }
+
+    static inline int32_t hash(int32_t s, int32_t x_primed, int32_t y_primed) {
+        return static_cast<int32_t>(static_cast<uint32_t>(s ^ x_primed ^ y_primed) * 0x27d4eb2dU);
+    }
+
+    static inline float grad_coord(const float *g, int32_t s, int32_t x_primed, int32_t y_primed, float xd, float yd) {
+        int32_t h = hash(s, x_primed, y_primed);
+        h ^= h >> 15;
+        h &= 127 << 1;
+        return xd * g[h] + yd * g[h | 1];
+    }
+
+    static inline float val_coord(int32_t s, int32_t x_primed, int32_t y_primed) {
+        uint32_t h = static_cast<uint32_t>(hash(s, x_primed, y_primed));
+        h *= h;
+        h ^= h << 19;
+        return static_cast<float>(static_cast<int32_t>(h)) * (1.0f / 2147483648.0f);
+    }
+
+    static float single_simplex(const float *g, int32_t s, float x, float y) {
+        const float G2 = (3.0f - 1.7320508075688772f) / 6.0f;
+        int i = fast_floor(x);
+        int j = fast_floor(y);
+        const float xi = x - static_cast<float>(i);
+        const float yi = y - static_cast<float>(j);
+        const float t = (xi + yi) * G2;
+        const float x0 = xi - t;
+        const float y0 = yi - t;
+        const int32_t ip = static_cast<int32_t>(static_cast<uint32_t>(i) * static_cast<uint32_t>(PRIME_X));
+        const int32_t jp = static_cast<int32_t>(static_cast<uint32_t>(j) * static_cast<uint32_t>(PRIME_Y));
+        const int32_t ip1 = static_cast<int32_t>(static_cast<uint32_t>(ip) + static_cast<uint32_t>(PRIME_X));
+        const int32_t jp1 = static_cast<int32_t>(static_cast<uint32_t>(jp) + static_cast<uint32_t>(PRIME_Y));
+
+        float n0 = 0.0f, n1 = 0.0f, n2 = 0.0f;
+        const float a = 0.5f - x0 * x0 - y0 * y0;
+        if (a > 0.0f) {
+            n0 = (a * a) * (a * a) * grad_coord(g, s, ip, jp, x0, y0);
+        }
+        const float c = static_cast<float>(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + (static_cast<float>(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
+        if (c > 0.0f) {
+            const float x2 = x0 + (2 * G2 - 1);
+            const float y2 = y0 + (2 * G2 - 1);
+            n2 = (c * c) * (c * c) * grad_coord(g, s, ip1, jp1, x2, y2);
+        }
+        if (y0 > x0) {
+            const float x1 = x0 + G2;
+            const float y1 = y0 + (G2 - 1);
+            const float b = 0.5f - x1 * x1 - y1 * y1;
+            if (b > 0.0f) {
+                n1 = (b * b) * (b * b) * grad_coord(g, s, ip, jp1, x1, y1);
+            }
+        } else {
+            const float x1 = x0 + (G2 - 1);
+            const float y1 = y0 + G2;
+            const float b = 0.5f - x1 * x1 - y1 * y1;
+            if (b > 0.0f) {
+                n1 = (b * b) * (b * b) * grad_coord(g, s, ip1, jp, x1, y1);
+            }
+        }
+        return (n0 + n1 + n2) * 99.83685446303647f;
+    }
+
+    static float single_value(int32_t s, float x, float y) {
+        const int x0 = fast_floor(x);
+        const int y0 = fast_floor(y);
+        const float xf = x - static_cast<float>(x0);
+        const float yf = y - static_cast<float>(y0);
+        const float xs = xf * xf * (3 - 2 * xf);
+        const float ys = yf * yf * (3 - 2 * yf);
+        const int32_t xp0 = static_cast<int32_t>(static_cast<uint32_t>(x0) * static_cast<uint32_t>(PRIME_X));
+        const int32_t yp0 = static_cast<int32_t>(static_cast<uint32_t>(y0) * static_cast<uint32_t>(PRIME_Y));
+        const int32_t xp1 = static_cast<int32_t>(static_cast<uint32_t>(xp0) + static_cast<uint32_t>(PRIME_X));
+        const int32_t yp1 = static_cast<int32_t>(static_cast<uint32_t>(yp0) + static_cast<uint32_t>(PRIME_Y));
+        const float v00 = val_coord(s, xp0, yp0), v10 = val_coord(s, xp1, yp0);
+        const float v01 = val_coord(s, xp0, yp1), v11 = val_coord(s, xp1, yp1);
+        const float xf0 = v00 + xs * (v10 - v00);
+        const float xf1 = v01 + xs * (v11 - v01);
+        return xf0 + ys * (xf1 - xf0);
+    }
+
+    float get(const float *g, float x, float y) const {
+        x *= frequency;
+        y *= frequency;
+        if (type == SIMPLEX) {
+            // OpenSimplex2 samples on a skewed lattice
+            const float F2 = 0.5f * (1.7320508075688772f - 1.0f);
+            const float t = (x + y) * F2;
+            x += t;
+            y += t;
+        }
+        int32_t s = seed;
+        float sum = 0.0f;
+        float amp = bounding;
+        for (int i = 0; i < octaves; i++) {
+            sum += (type == SIMPLEX ? single_simplex(g, s, x, y) : single_value(s, x, y)) * amp;
+            s++;
+            x *= 2.0f;
+            y *= 2.0f;
+            amp *= 0.5f;
+        }
+        return sum;
+    }
+};
+
+} // namespace
+
+PackedByteArray TerrainRasterizer::generate_noise(int size, const PackedInt32Array &seeds, const Dictionary &recipe) const {
+    PackedByteArray pixels;
+    ERR_FAIL_COND_V_MSG(size < 1, pixels, "Texture size must be positive");
+    ERR_FAIL_COND_V_MSG(seeds.size() != 3, pixels, "Three noise seeds are required");
+
+    const float frequency_1 = static_cast<float>(recipe.get("frequency_1", 1.0 / 320.0));
+    const float frequency_2 = static_cast<float>(recipe.get("frequency_2", 1.0 / 160.0));
+    const float frequency_3 = static_cast<float>(recipe.get("frequency_3", 1.0 / 6.0));
+    const int octaves_1 = static_cast<int>(recipe.get("octaves_1", 4));
+    const int octaves_2 = static_cast<int>(recipe.get("octaves_2", 3));
+    const int octaves_3 = static_cast<int>(recipe.get("octaves_3", 5));
+    const float warp_frequency = static_cast<float>(recipe.get("warp_frequency", 1.0 / 1600.0));
+    const float warp_amplitude = static_cast<float>(recipe.get("warp_amplitude", 0.0));
+    const float contrast = static_cast<float>(recipe.get("contrast", 0.0));
+    const float intensity = static_cast<float>(recipe.get("intensity", 0.2));
+
+    const FractalNoise noise_1(FractalNoise::SIMPLEX, seeds[0], frequency_1, octaves_1);
+    const FractalNoise noise_2(FractalNoise::SIMPLEX, seeds[1], frequency_2, octaves_2);
+    const FractalNoise noise_3(FractalNoise::VALUE, seeds[2], frequency_3, octaves_3);
+    const float *g = FractalNoise::gradients();
+
+    pixels.resize(static_cast<int64_t>(size) * size * 4);
+    uint8_t *out = pixels.ptrw();
+
+    // Layer by layer over a row, then one pass combining them
+    run_bands(pool.get(), size, [&](int y_begin, int y_end) {
+        std::vector<float> wx(size), wy(size), n1(size), n2(size), n3(size);
+        for (int y = y_begin; y < y_end; y++) {
+            const float fy = static_cast<float>(y);
+            for (int x = 0; x < size; x++) {
+                wx[x] = static_cast<float>(x);
+                wy[x] = fy;
+            }
+            if (warp_amplitude != 0.0f) {
+                for (int x = 0; x < size; x++) {
+                    const float fx = static_cast<float>(x);
+                    wx[x] += noise_3.get(g, fx * warp_frequency, fy * warp_frequency) * warp_amplitude;
+                    wy[x] += noise_2.get(g, fx * warp_frequency * 1.13f, fy * warp_frequency * 0.91f) * warp_amplitude;
+                }
+            }
+            for (int x = 0; x < size; x++) {
+                n1[x] = noise_1.get(g, wx[x], wy[x]);
+            }
+            for (int x = 0; x < size; x++) {
+                n2[x] = noise_2.get(g, wx[x] * 1.87f, wy[x] * 1.63f);
+            }
+            for (int x = 0; x < size; x++) {
+                n3[x] = noise_3.get(g, wx[x] * 2.11f, wy[x] * 2.39f);
+            }
+            uint8_t *row = out + static_cast<int64_t>(y) * size * 4;
+            for (int x = 0; x < size; x++) {
+                const float v = std::max(0.25f + 0.5f * n1[x] + 0.45f * n2[x] + 0.3f * n3[x], 0.0f);
+                const float contrasted = 0.5f + (v - 0.5f) * (1.0f + contrast);
+                const float mul = std::clamp(1.0f + (contrasted - 0.5f) * 2.0f * intensity, 0.0f, 1.5f);
+                const uint8_t grey = static_cast<uint8_t>(std::min(mul * 255.0f, 255.0f));
+                row[x * 4 + 0] = grey;
+                row[x * 4 + 1] = grey;
+                row[x * 4 + 2] = grey;
+                row[x * 4 + 3] = 255;
+            }
+        }
+    });
+
+    return pixels;
+}
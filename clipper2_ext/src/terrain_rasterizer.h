@@ -0,0 +1,84 @@
+#ifndef TERRAIN_RASTERIZER_H
+#define TERRAIN_RASTERIZER_H
+
+#include "worker_pool.h"
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <memory>
+
+using namespace godot;
+
+// Pixel generators for StaticBackgroundDrawer textures. Results are RGBA8
+// buffers for Image.create_from_data; rows are spread over the worker pool
+// when parallel mode is on.
+class TerrainRasterizer : public RefCounted {
+    GDCLASS(TerrainRasterizer, RefCounted);
+
+public:
+    // Mountain shading recipe, read from the shading Dictionary (keys are the
+    // field names, missing keys keep these defaults)
+    struct MountainShading {
+        Color base_color = Color(0.5, 0.5, 0.5, 1.0);
+        Color background_color = Color(0.35, 0.35, 0.35, 1.0);
+        Vector2 light_dir = Vector2(-0.70710678, -0.70710678);
+        double light_z = 0.9;
+        double bright_min = 0.0;
+        double bright_max = 1.0;
+        double jitter_deg = 48.0;
+        double base_slope_deg = 0.0;
+        double base_edge_exp = 0.9;
+        double ridge_slope_deg = 45.0;
+        double ridge_width_l1 = 168.0;
+        double ridge_width_l2 = 108.0;
+        double ridge_sharpness_pow = 6.0;
+        double min_width_px = 1.0;
+        double ridge_level_width_factor = 2.0;
+        double ridge_distance_strength = 0.05;
+        double ridge_eps = 0.0001;
+        // Distance multiplier for ridges above level 1 when picking the nearest
+        double ridge_secondary_distance_bias = 2.0;
+        double subpixel_offset = 0.5;
+    };
+
+private:
+    std::unique_ptr<WorkerPool> pool;
+
+protected:
+    static void _bind_methods();
+
+public:
+    static MountainShading read_mountain_shading(const Dictionary &shading);
+
+    // Same as rasterize_mountain with the recipe already parsed
+    PackedByteArray rasterize_mountain_with(const PackedVector2Array &polygon, const Vector2 &origin,
+            int width, int height, const Vector2 &centroid, const PackedVector2Array &ridge_points,
+            const PackedInt32Array &ridge_levels, const MountainShading &shading, int64_t seed) const;
+
+    // As Clipper2Open.set_parallel: thread_count <= 0 uses every core
+    void set_parallel(bool enabled, int thread_count = 0);
+    bool is_parallel() const;
+
+    // width x height RGBA8 pixels of the polygon's mountain texture, pixel
+    // (x, y) sampled at origin + (x, y) + subpixel_offset; transparent
+    // outside the polygon (even-odd). The edge distance comes from a
+    // Euclidean distance transform of the filled mask, the ridge shading from
+    // the nearest of the ridge segments (ridge_points[2k] .. [2k + 1], level
+    // ridge_levels[k]). seed drives the per-pixel normal jitter.
+    PackedByteArray rasterize_mountain(const PackedVector2Array &polygon, const Vector2 &origin,
+            int width, int height, const Vector2 &centroid, const PackedVector2Array &ridge_points,
+            const PackedInt32Array &ridge_levels, const Dictionary &shading, int64_t seed) const;
+
+    // size x size RGBA8 grey mottling: 0.25 + 0.5 n1 + 0.45 n2 + 0.3 n3 of
+    // two OpenSimplex2 FBm layers and one value FBm layer (seeds[0..2]), with
+    // contrast and intensity applied and the result clamped to [0, 1.5]
+    // before packing. Matches the FastNoiseLite setup the GDScript used.
+    // recipe keys: frequency_1..3, octaves_1..3, warp_frequency,
+    // warp_amplitude, contrast, intensity.
+    PackedByteArray generate_noise(int size, const PackedInt32Array &seeds, const Dictionary &recipe) const;
+};
+
+#endif // TERRAIN_RASTERIZER_H
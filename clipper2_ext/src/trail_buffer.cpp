@@ -0,0 +1,171 @@
+#include "trail_buffer.h"
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+void TrailBuffer::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("configure", "capacity"),
+        &TrailBuffer::configure
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("clear"),
+        &TrailBuffer::clear
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("add_segment", "from", "to", "color", "lifetime"),
+        &TrailBuffer::add_segment
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("advance", "delta"),
+        &TrailBuffer::advance
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("get_count"),
+        &TrailBuffer::get_count
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("build_lines", "max_alpha"),
+        &TrailBuffer::build_lines
+    );
+}
+
+void TrailBuffer::configure(int capacity) {
+    ERR_FAIL_COND_MSG(capacity < 1, "Trail capacity must be positive");
+    starts.assign(capacity, Vector2());
+    ends.assign(capacity, Vector2());
+    colors.assign(capacity, Color());
+    life_left.assign(capacity, 0.0f);
+    life_max.assign(capacity, 1.0f);
+    clear();
+}
+
+void TrailBuffer::clear() {
+    head = 0;
+    size = 0;
+    alive = 0;
+}
+
+void TrailBuffer::add_segment(const Vector2 &from, const Vector2 &to, const Color &color, double lifetime) {
+    const int capacity = static_cast<int>(starts.size());
+    ERR_FAIL_COND_MSG(capacity == 0, "TrailBuffer.configure must be called first");
+    if (!(lifetime > 0.0)) {
+        return;
+    }
+
+    if (size == capacity && alive < size) {
+        // Expired segments still hold slots; reclaim them before evicting a
+        // live one
+        compact();
+    }
+
+    int slot;
+    if (size == capacity) {
+        // Overwrite the oldest
+        slot = head;
+        head = head + 1 == capacity ? 0 : head + 1;
+        if (life_left[slot] > 0.0f) {
+            alive--;
+        }
+    } else {
+        slot = head + size;
+        if (slot >= capacity) {
+            slot -= capacity;
+        }
+        size++;
+    }
+
+    starts[slot] = from;
+    ends[slot] = to;
+    colors[slot] = color;
+    life_left[slot] = static_cast<float>(lifetime);
+    life_max[slot] = static_cast<float>(lifetime);
+    alive++;
+}
+
+void TrailBuffer::compact() {
+    const int capacity = static_cast<int>(starts.size());
+    int read = head;
+    int write = head;
+    for (int k = 0; k < size; k++) {
+        if (life_left[read] > 0.0f) {
+            if (write != read) {
+                starts[write] = starts[read];
+                ends[write] = ends[read];
+                colors[write] = colors[read];
+                life_left[write] = life_left[read];
+                life_max[write] = life_max[read];
+            }
+            write = write + 1 == capacity ? 0 : write + 1;
+        }
+        read = read + 1 == capacity ? 0 : read + 1;
+    }
+    size = alive;
+    if (size == 0) {
+        head = 0;
+    }
+}
+
+void TrailBuffer::advance(double delta) {
+    const int capacity = static_cast<int>(starts.size());
+    const float step = static_cast<float>(delta);
+    int slot = head;
+    for (int k = 0; k < size; k++) {
+        float &life = life_left[slot];
+        if (life > 0.0f) {
+            life -= step;
+            if (life <= 0.0f) {
+                alive--;
+            }
+        }
+        slot = slot + 1 == capacity ? 0 : slot + 1;
+    }
+
+    while (size > 0 && life_left[head] <= 0.0f) {
+        head = head + 1 == capacity ? 0 : head + 1;
+        size--;
+    }
+    if (size == 0) {
+        head = 0;
+    }
+}
+
+int TrailBuffer::get_count() const {
+    return alive;
+}
+
+Array TrailBuffer::build_lines(double max_alpha) const {
+    PackedVector2Array points;
+    PackedColorArray line_colors;
+    points.resize(alive * 2);
+    line_colors.resize(alive);
+    Vector2 *point_write = points.ptrw();
+    Color *color_write = line_colors.ptrw();
+
+    const int capacity = static_cast<int>(starts.size());
+    int slot = head;
+    int out = 0;
+    for (int k = 0; k < size; k++) {
+        if (life_left[slot] > 0.0f) {
+            const float t = life_left[slot] / life_max[slot];
+            const float alpha = t * t;
+            const float shade = 1.0f - 0.5f * (1.0f - alpha);
+            const Color &base = colors[slot];
+            point_write[out * 2] = starts[slot];
+            point_write[out * 2 + 1] = ends[slot];
+            color_write[out] = Color(base.r * shade, base.g * shade, base.b * shade, alpha * static_cast<float>(max_alpha));
+            out++;
+        }
+        slot = slot + 1 == capacity ? 0 : slot + 1;
+    }
+
+    Array result;
+    result.push_back(points);
+    result.push_back(line_colors);
+    return result;
+}
@@ -0,0 +1,55 @@
+#ifndef TRAIL_BUFFER_H
+#define TRAIL_BUFFER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <vector>
+
+using namespace godot;
+
+// Fixed-capacity ring of fading line segments for TrailManager. Segments are
+// aged together each frame and handed out as one draw_multiline_colors batch;
+// when the ring is full the expired segments are squeezed out first, and only
+// a ring full of live segments overwrites the oldest.
+class TrailBuffer : public RefCounted {
+    GDCLASS(TrailBuffer, RefCounted);
+
+private:
+    std::vector<Vector2> starts;
+    std::vector<Vector2> ends;
+    std::vector<Color> colors;
+    std::vector<float> life_left;
+    std::vector<float> life_max;
+    // Live range is slots head .. head + size (mod capacity), oldest first.
+    // Segments expiring out of order stay in the range, at zero life, until
+    // everything older than them has expired too.
+    int head = 0;
+    int size = 0;
+    int alive = 0;
+
+    // Moves the live segments together, oldest first, from head
+    void compact();
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Drops every segment
+    void configure(int capacity);
+    void clear();
+
+    void add_segment(const Vector2 &from, const Vector2 &to, const Color &color, double lifetime);
+    void advance(double delta);
+    int get_count() const;
+
+    // [PackedVector2Array points, PackedColorArray colors] for
+    // draw_multiline_colors: two points and one color per live segment, the
+    // color faded by the squared remaining life (alpha times max_alpha, and
+    // darkened by half the faded part).
+    Array build_lines(double max_alpha) const;
+};
+
+#endif // TRAIL_BUFFER_H
@@ -0,0 +1,245 @@
+#include "voronoi_diagram.h"
+#include "delaunay.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+void VoronoiDiagram::_bind_methods() {
+    ClassDB::bind_static_method(
+        "VoronoiDiagram",
+        D_METHOD("build_cells", "seeds", "bounds", "snap_to_integer"),
+        &VoronoiDiagram::build_cells,
+        DEFVAL(false)
+    );
+
+    ClassDB::bind_static_method(
+        "VoronoiDiagram",
+        D_METHOD("relax_seeds", "seeds", "bounds", "iterations"),
+        &VoronoiDiagram::relax_seeds
+    );
+}
+
+// ---------------------------------------------------------------------------
+// Cells
+// ---------------------------------------------------------------------------
+
+// Sutherland-Hodgman against one side of the bounds. The crossing of an edge
+// is computed from its endpoints in a fixed order, so the two cells sharing
+// the edge get bitwise equal vertices.
+template <bool AlongX, bool KeepAbove>
+static void clip_side(const std::vector<DPoint> &in, std::vector<DPoint> &out, double limit) {
+    out.clear();
+    const size_t n = in.size();
+    auto coord = [](const DPoint &p) { return AlongX ? p.x : p.y; };
+    auto inside = [&](const DPoint &p) { return KeepAbove ? coord(p) >= limit : coord(p) <= limit; };
+    auto crossing = [&](DPoint p, DPoint q) {
+        if (q.x < p.x || (q.x == p.x && q.y < p.y)) std::swap(p, q);
+        const double t = (limit - coord(p)) / (coord(q) - coord(p));
+        return AlongX ? DPoint{ limit, p.y + t * (q.y - p.y) } : DPoint{ p.x + t * (q.x - p.x), limit };
+    };
+    for (size_t i = 0; i < n; i++) {
+        const DPoint &cur = in[i];
+        const DPoint &next = in[(i + 1) % n];
+        const bool cur_in = inside(cur);
+        const bool next_in = inside(next);
+        if (cur_in) out.push_back(cur);
+        if (cur_in != next_in) out.push_back(crossing(cur, next));
+    }
+}
+
+static int64_t truncate_to_int(double v) {
+    return static_cast<int64_t>(v);
+}
+
+// Same as MapGenerator._safe_round
+static Vector2 safe_round(const Vector2 &p) {
+    const double eps = 0.01;
+    return Vector2(
+        static_cast<real_t>(std::max(truncate_to_int(p.x), truncate_to_int(p.x + eps))),
+        static_cast<real_t>(std::max(truncate_to_int(p.y), truncate_to_int(p.y + eps)))
+    );
+}
+
+struct CellSet {
+    std::vector<std::vector<Vector2>> cells;
+    // Delaunay neighbours among the seeds, per seed
+    std::vector<std::vector<int>> neighbours;
+};
+
+static CellSet compute_cells(const PackedVector2Array &seeds, const Rect2 &bounds, bool snap_to_integer) {
+    CellSet result;
+    const int count = seeds.size();
+    result.cells.resize(count);
+    result.neighbours.resize(count);
+    if (count == 0) {
+        return result;
+    }
+
+    const double x0 = bounds.position.x;
+    const double y0 = bounds.position.y;
+    const double x1 = bounds.position.x + bounds.size.x;
+    const double y1 = bounds.position.y + bounds.size.y;
+
+    std::vector<DPoint> points(count);
+    double min_x = x0, min_y = y0, max_x = x1, max_y = y1;
+    const Vector2 *src = seeds.ptr();
+    for (int i = 0; i < count; i++) {
+        points[i] = { src[i].x, src[i].y };
+        min_x = std::min(min_x, points[i].x);
+        min_y = std::min(min_y, points[i].y);
+        max_x = std::max(max_x, points[i].x);
+        max_y = std::max(max_y, points[i].y);
+    }
+
+    Delaunay delaunay;
+    delaunay.init(points, min_x, min_y, max_x, max_y);
+    std::vector<uint8_t> inserted(count, 0);
+    for (int i : insertion_order(points, min_y, max_y)) {
+        inserted[i] = delaunay.insert(i) ? 1 : 0;
+    }
+
+    std::vector<DPoint> centres(delaunay.triangles.size());
+    for (size_t t = 0; t < delaunay.triangles.size(); t++) {
+        if (delaunay.triangles[t].alive) {
+            centres[t] = delaunay.circumcenter(delaunay.triangles[t]);
+        }
+    }
+
+    std::vector<DPoint> ring;
+    std::vector<DPoint> clipped;
+    for (int s = 0; s < count; s++) {
+        if (!inserted[s]) continue;
+
+        // Counter-clockwise around the seed: the next triangle shares the
+        // edge to the vertex after the seed's successor
+        ring.clear();
+        const int first = delaunay.vertex_triangle[s];
+        int t = first;
+        bool closed = false;
+        for (size_t guard = 0; guard < delaunay.triangles.size(); guard++) {
+            const Triangle &tri = delaunay.triangles[t];
+            int k = tri.v[0] == s ? 0 : (tri.v[1] == s ? 1 : 2);
+            ring.push_back(centres[t]);
+            int neighbour = tri.v[(k + 1) % 3];
+            if (neighbour < count) {
+                result.neighbours[s].push_back(neighbour);
+            }
+            t = tri.n[(k + 1) % 3];
+            if (t < 0) break;
+            if (t == first) {
+                closed = true;
+                break;
+            }
+        }
+        ERR_CONTINUE_MSG(!closed, "Voronoi cell of an interior seed did not close");
+
+        clip_side<true, true>(ring, clipped, x0);
+        clip_side<true, false>(clipped, ring, x1);
+        clip_side<false, true>(ring, clipped, y0);
+        clip_side<false, false>(clipped, ring, y1);
+
+        std::vector<Vector2> &cell = result.cells[s];
+        for (const DPoint &p : ring) {
+            Vector2 v(static_cast<real_t>(p.x), static_cast<real_t>(p.y));
+            if (snap_to_integer) {
+                v = safe_round(v);
+            }
+            if (cell.empty() || cell.back() != v) {
+                cell.push_back(v);
+            }
+        }
+        while (cell.size() > 1 && cell.front() == cell.back()) {
+            cell.pop_back();
+        }
+        if (cell.size() < 3) {
+            cell.clear();
+        }
+    }
+    return result;
+}
+
+// Any common edge in either direction, as GeometryUtils.are_polygons_adjacent
+static bool share_edge(const std::vector<Vector2> &a, const std::vector<Vector2> &b) {
+    const size_t na = a.size();
+    const size_t nb = b.size();
+    for (size_t i = 0; i < na; i++) {
+        const Vector2 &a1 = a[i];
+        const Vector2 &a2 = a[(i + 1) % na];
+        for (size_t j = 0; j < nb; j++) {
+            const Vector2 &b1 = b[j];
+            const Vector2 &b2 = b[(j + 1) % nb];
+            if ((a1 == b1 && a2 == b2) || (a1 == b2 && a2 == b1)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Array VoronoiDiagram::build_cells(const PackedVector2Array &seeds, const Rect2 &bounds, bool snap_to_integer) {
+    Array result;
+    ERR_FAIL_COND_V_MSG(!(bounds.size.x > 0.0f && bounds.size.y > 0.0f), result, "Bounds must have a positive size");
+
+    CellSet set = compute_cells(seeds, bounds, snap_to_integer);
+    const int count = seeds.size();
+
+    Array cells;
+    cells.resize(count);
+    PackedInt32Array offsets;
+    offsets.resize(count + 1);
+    PackedInt32Array adjacency;
+    std::vector<std::vector<int>> adjacent(count);
+    for (int s = 0; s < count; s++) {
+        for (int other : set.neighbours[s]) {
+            if (other > s && !set.cells[s].empty() && !set.cells[other].empty()
+                    && share_edge(set.cells[s], set.cells[other])) {
+                adjacent[s].push_back(other);
+                adjacent[other].push_back(s);
+            }
+        }
+    }
+    offsets.set(0, 0);
+    for (int s = 0; s < count; s++) {
+        PackedVector2Array cell;
+        cell.resize(set.cells[s].size());
+        std::copy(set.cells[s].begin(), set.cells[s].end(), cell.ptrw());
+        cells[s] = cell;
+
+        std::sort(adjacent[s].begin(), adjacent[s].end());
+        adjacent[s].erase(std::unique(adjacent[s].begin(), adjacent[s].end()), adjacent[s].end());
+        for (int other : adjacent[s]) {
+            adjacency.append(other);
+        }
+        offsets.set(s + 1, adjacency.size());
+    }
+
+    result.append(cells);
+    result.append(offsets);
+    result.append(adjacency);
+    return result;
+}
+
+PackedVector2Array VoronoiDiagram::relax_seeds(const PackedVector2Array &seeds, const Rect2 &bounds, int iterations) {
+    ERR_FAIL_COND_V_MSG(!(bounds.size.x > 0.0f && bounds.size.y > 0.0f), seeds, "Bounds must have a positive size");
+
+    PackedVector2Array points = seeds;
+    for (int it = 0; it < iterations; it++) {
+        CellSet set = compute_cells(points, bounds, false);
+        PackedVector2Array moved;
+        for (const std::vector<Vector2> &cell : set.cells) {
+            if (cell.empty()) continue;
+            Vector2 mean;
+            for (const Vector2 &v : cell) {
+                mean += v;
+            }
+            moved.append(mean / static_cast<real_t>(cell.size()));
+        }
+        points = moved;
+    }
+    return points;
+}
@@ -0,0 +1,37 @@
+#ifndef VORONOI_DIAGRAM_H
+#define VORONOI_DIAGRAM_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+
+using namespace godot;
+
+// Voronoi cells of map seed points, read off an incremental (Bowyer-Watson)
+// Delaunay triangulation. Cells neighbouring each other are built from the
+// same circumcentres and bound crossings, so their shared edges have exactly
+// equal vertices and survive integer snapping as common edges.
+class VoronoiDiagram : public RefCounted {
+    GDCLASS(VoronoiDiagram, RefCounted);
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Cell of every seed clipped to bounds (positive signed area, no repeated
+    // vertices), optionally snapped like MapGenerator._safe_round.
+    // Returns [Array cells, PackedInt32Array adjacency_offsets,
+    // PackedInt32Array adjacency]: cells[i] belongs to seeds[i] and is empty
+    // for repeated seeds or cells collapsed by snapping; the cells sharing an
+    // edge with cell i are adjacency[adjacency_offsets[i] .. adjacency_offsets[i + 1]),
+    // ascending.
+    static Array build_cells(const PackedVector2Array &seeds, const Rect2 &bounds, bool snap_to_integer = false);
+
+    // Lloyd relaxation as MapGenerator did it: every iteration moves each
+    // seed to the mean of its (unsnapped) cell vertices and drops seeds
+    // without a cell.
+    static PackedVector2Array relax_seeds(const PackedVector2Array &seeds, const Rect2 &bounds, int iterations);
+};
+
+#endif // VORONOI_DIAGRAM_H
@@ -0,0 +1,322 @@
+#include "weighted_visvalingam.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <cmath>
+#include <cstring>
+
+using namespace godot;
+
+// Pinned vertices are removed at this fraction of their rate
+static const double PINNED_RATE_FACTOR = 0.01;
+// Significance boost where the rate is zero (nothing can expand there)
+static const double ZERO_RATE_SIG_FACTOR = 16.0;
+
+void WeightedVisvalingam::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("set_rates", "min_rate", "max_rate", "locked_rate"),
+        &WeightedVisvalingam::set_rates
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_area_rates", "area_rates"),
+        &WeightedVisvalingam::set_area_rates
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_pinned_points", "points"),
+        &WeightedVisvalingam::set_pinned_points
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("find_pinned_vertices", "polygon"),
+        &WeightedVisvalingam::find_pinned_vertices
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("simplify", "polygon", "tolerance", "vertex_area_indices", "vertex_strength_multipliers", "pinned_vertices", "rate_scale", "area_locked"),
+        &WeightedVisvalingam::simplify
+    );
+}
+
+void WeightedVisvalingam::set_rates(double p_min_rate, double p_max_rate, double p_locked_rate) {
+    ERR_FAIL_COND_MSG(p_min_rate > p_max_rate, "Minimum rate must not exceed maximum rate");
+    min_rate = p_min_rate;
+    max_rate = p_max_rate;
+    locked_rate = p_locked_rate;
+}
+
+void WeightedVisvalingam::set_area_rates(const PackedFloat64Array &p_area_rates) {
+    area_rates.assign(p_area_rates.ptr(), p_area_rates.ptr() + p_area_rates.size());
+}
+
+// Exact point key; -0.0 and 0.0 compare equal in Godot, so they hash equal too
+static uint64_t point_key(const Vector2 &v) {
+    float x = v.x == 0.0f ? 0.0f : v.x;
+    float y = v.y == 0.0f ? 0.0f : v.y;
+    uint32_t xb, yb;
+    std::memcpy(&xb, &x, sizeof(xb));
+    std::memcpy(&yb, &y, sizeof(yb));
+    return (static_cast<uint64_t>(xb) << 32) | yb;
+}
+
+void WeightedVisvalingam::set_pinned_points(const PackedVector2Array &points) {
+    pinned_points.clear();
+    pinned_points.reserve(points.size());
+    const Vector2 *src = points.ptr();
+    for (int i = 0; i < points.size(); i++) {
+        pinned_points.insert(point_key(src[i]));
+    }
+}
+
+PackedInt32Array WeightedVisvalingam::find_pinned_vertices(const PackedVector2Array &polygon) const {
+    PackedInt32Array result;
+    if (pinned_points.empty()) {
+        return result;
+    }
+    const Vector2 *src = polygon.ptr();
+    for (int i = 0; i < polygon.size(); i++) {
+        if (pinned_points.count(point_key(src[i])) != 0) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+// Triangle area at curr divided by rate^1.5. Never infinite, otherwise almost
+// colinear points could not be simplified.
+double WeightedVisvalingam::significance(const Inputs &in, int curr) const {
+    const Vector2 &a = in.points[prev_idx[curr]];
+    const Vector2 &b = in.points[curr];
+    const Vector2 &c = in.points[next_idx[curr]];
+    double s = std::abs(
+        (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+        (static_cast<double>(c.x) - a.x) * (static_cast<double>(b.y) - a.y)
+    ) * 0.5;
+
+    int area_index = in.vertex_area_indices[curr];
+    bool has_area = area_index >= 0 && area_index < static_cast<int>(area_rates.size());
+    double rate = has_area ? area_rates[area_index] * in.rate_scale : 0.0;
+    rate *= in.vertex_strength_multipliers[curr];
+    if (rate < min_rate) {
+        rate = min_rate;
+    }
+    if (rate > max_rate) {
+        rate = max_rate;
+    }
+    if (has_area && in.area_locked != nullptr && in.area_locked[area_index]) {
+        rate = locked_rate;
+    }
+
+    // Magic number 2/3...
+    rate = std::pow(rate, 1.5);
+
+    // Keep vertices aligned with original walkable area vertices
+    if (in.vertex_pinned[curr] && s != 0.0) {
+        rate *= PINNED_RATE_FACTOR;
+    }
+
+    if (rate == 0.0) {
+        return s * ZERO_RATE_SIG_FACTOR;
+    }
+    return s / rate;
+}
+
+// --- Min-heap of vertex indices keyed by sig ---
+
+void WeightedVisvalingam::heap_swap(int idx_a, int idx_b) {
+    std::swap(heap[idx_a], heap[idx_b]);
+    pos_in_heap[heap[idx_a]] = idx_a;
+    pos_in_heap[heap[idx_b]] = idx_b;
+}
+
+void WeightedVisvalingam::heap_sift_up(int start_idx) {
+    int child = start_idx;
+    while (child > 0) {
+        int parent = (child - 1) / 2;
+        if (sig[heap[child]] < sig[heap[parent]]) {
+            heap_swap(child, parent);
+            child = parent;
+        } else {
+            break;
+        }
+    }
+}
+
+void WeightedVisvalingam::heap_sift_down(int start_idx) {
+    int size = static_cast<int>(heap.size());
+    int idx = start_idx;
+    while (true) {
+        int smallest = idx;
+        int left = 2 * idx + 1;
+        int right = 2 * idx + 2;
+        if (left < size && sig[heap[left]] < sig[heap[smallest]]) {
+            smallest = left;
+        }
+        if (right < size && sig[heap[right]] < sig[heap[smallest]]) {
+            smallest = right;
+        }
+        if (smallest == idx) {
+            break;
+        }
+        heap_swap(idx, smallest);
+        idx = smallest;
+    }
+}
+
+void WeightedVisvalingam::heap_push(int vertex) {
+    pos_in_heap[vertex] = static_cast<int>(heap.size());
+    heap.push_back(vertex);
+    heap_sift_up(static_cast<int>(heap.size()) - 1);
+}
+
+int WeightedVisvalingam::heap_pop() {
+    int root = heap[0];
+    pos_in_heap[root] = -1;
+    if (heap.size() == 1) {
+        heap.pop_back();
+        return root;
+    }
+    heap[0] = heap.back();
+    heap.pop_back();
+    pos_in_heap[heap[0]] = 0;
+    heap_sift_down(0);
+    return root;
+}
+
+void WeightedVisvalingam::heap_update(int vertex) {
+    int h_idx = pos_in_heap[vertex];
+    if (h_idx == -1) {
+        heap_push(vertex);
+        return;
+    }
+    // choose direction based on new significance
+    heap_sift_up(h_idx);
+    heap_sift_down(pos_in_heap[vertex]);
+}
+
+// Shoelace area, positive for polygons Geometry2D.is_polygon_clockwise rejects
+static double signed_area(const Vector2 *points, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        const Vector2 &a = points[i];
+        const Vector2 &b = points[(i + 1) % count];
+        sum += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+    }
+    return sum * 0.5;
+}
+
+static Array simplify_result(const PackedVector2Array &polygon, double signed_area_delta) {
+    Array result;
+    result.append(polygon);
+    result.append(signed_area_delta);
+    return result;
+}
+
+Array WeightedVisvalingam::simplify(
+    const PackedVector2Array &polygon,
+    double tolerance,
+    const PackedInt32Array &vertex_area_indices,
+    const PackedFloat64Array &vertex_strength_multipliers,
+    const PackedInt32Array &pinned_vertices,
+    double rate_scale,
+    const PackedByteArray &area_locked)
+{
+    const int count = polygon.size();
+    ERR_FAIL_COND_V_MSG(vertex_area_indices.size() != count || vertex_strength_multipliers.size() != count,
+        simplify_result(polygon, 0.0), "Per-vertex arrays must match the polygon size");
+    ERR_FAIL_COND_V_MSG(!area_locked.is_empty() && area_locked.size() != static_cast<int>(area_rates.size()),
+        simplify_result(polygon, 0.0), "Area lock table must be empty or match the area rates");
+
+    if (count <= 3) {
+        return simplify_result(polygon, 0.0);
+    }
+
+    pinned.assign(count, 0);
+    const int32_t *pinned_src = pinned_vertices.ptr();
+    for (int i = 0; i < pinned_vertices.size(); i++) {
+        ERR_FAIL_INDEX_V_MSG(pinned_src[i], count, simplify_result(polygon, 0.0), "Pinned vertex index out of range");
+        pinned[pinned_src[i]] = 1;
+    }
+
+    Inputs in;
+    in.points = polygon.ptr();
+    in.vertex_area_indices = vertex_area_indices.ptr();
+    in.vertex_strength_multipliers = vertex_strength_multipliers.ptr();
+    in.vertex_pinned = pinned.data();
+    in.rate_scale = rate_scale;
+    in.area_locked = area_locked.is_empty() ? nullptr : area_locked.ptr();
+
+    prev_idx.resize(count);
+    next_idx.resize(count);
+    pos_in_heap.assign(count, -1);
+    sig.resize(count);
+    active.assign(count, 1);
+    heap.clear();
+    heap.reserve(count);
+    for (int i = 0; i < count; i++) {
+        next_idx[i] = (i + 1) % count;
+        prev_idx[i] = (i + count - 1) % count;
+    }
+
+    for (int i = 0; i < count; i++) {
+        sig[i] = static_cast<float>(significance(in, i));
+        heap_push(i);
+    }
+
+    // ---------- main loop ----------
+    float max_sig = 0.0f;
+    int remaining = count;
+    while (!heap.empty()) {
+        int idx = heap_pop();
+
+        if (!active[idx]) {
+            continue; // already removed by neighbour collapse
+        }
+
+        float s = sig[idx];
+        if (s < max_sig) {
+            s = max_sig;
+        } else {
+            max_sig = s;
+        }
+
+        if (s > tolerance) {
+            break;
+        }
+
+        // remove vertex
+        active[idx] = 0;
+        remaining--;
+        int p = prev_idx[idx];
+        int n = next_idx[idx];
+        prev_idx[n] = p;
+        next_idx[p] = n;
+
+        // update neighbours
+        if (active[p]) {
+            sig[p] = static_cast<float>(significance(in, p));
+            heap_update(p);
+        }
+        if (active[n]) {
+            sig[n] = static_cast<float>(significance(in, n));
+            heap_update(n);
+        }
+    }
+
+    // ---------- build result ----------
+    if (remaining < 3) {
+        return simplify_result(polygon, 0.0);
+    }
+
+    PackedVector2Array result;
+    result.resize(remaining);
+    Vector2 *dst = result.ptrw();
+    int k = 0;
+    for (int i = 0; i < count; i++) {
+        if (active[i]) {
+            dst[k++] = in.points[i];
+        }
+    }
+
+    double signed_area_delta = signed_area(dst, remaining) - signed_area(in.points, count);
+    return simplify_result(result, signed_area_delta);
+}
@@ -0,0 +1,93 @@
+#ifndef WEIGHTED_VISVALINGAM_H
+#define WEIGHTED_VISVALINGAM_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+using namespace godot;
+
+// Visvalingam-Whyatt simplification where a vertex's triangle area is divided
+// by the expansion rate at that vertex (rate^1.5), so fast fronts keep detail
+// and slow ones collapse. Same rules as VisvalingamSimplifier, with the per
+// vertex lookups passed in as parallel arrays.
+class WeightedVisvalingam : public RefCounted {
+    GDCLASS(WeightedVisvalingam, RefCounted);
+
+private:
+    double min_rate = 0.0;
+    double max_rate = 1.0;
+    double locked_rate = 1.0;
+    // Static tables from set_area_rates / set_pinned_points
+    std::vector<double> area_rates;
+    std::unordered_set<uint64_t> pinned_points;
+
+    // Scratch reused between calls, grows to the largest polygon seen
+    std::vector<int> prev_idx;
+    std::vector<int> next_idx;
+    std::vector<int> heap;
+    std::vector<int> pos_in_heap;
+    std::vector<float> sig;
+    std::vector<uint8_t> active;
+    std::vector<uint8_t> pinned;
+
+    struct Inputs {
+        const Vector2 *points;
+        const int32_t *vertex_area_indices;
+        const double *vertex_strength_multipliers;
+        const uint8_t *vertex_pinned;
+        double rate_scale;
+        // Null when no area is locked
+        const uint8_t *area_locked;
+    };
+
+    double significance(const Inputs &in, int curr) const;
+
+    void heap_swap(int idx_a, int idx_b);
+    void heap_sift_up(int start_idx);
+    void heap_sift_down(int start_idx);
+    void heap_push(int vertex);
+    int heap_pop();
+    void heap_update(int vertex);
+
+protected:
+    static void _bind_methods();
+
+public:
+    // Clamp for the multiplied rate, and the rate used instead in locked areas
+    void set_rates(double p_min_rate, double p_max_rate, double p_locked_rate);
+
+    // Expansion rate of each area at unit strength (vertex_area_indices index
+    // this table); simplify scales it by the polygon's strength
+    void set_area_rates(const PackedFloat64Array &p_area_rates);
+
+    // Vertices exactly equal to one of these (the original walkable area
+    // vertices) are pinned, see find_pinned_vertices
+    void set_pinned_points(const PackedVector2Array &points);
+
+    // Ascending indices of the polygon vertices that are pinned points
+    PackedInt32Array find_pinned_vertices(const PackedVector2Array &polygon) const;
+
+    // vertex_* arrays are parallel to polygon: index into the area rate table
+    // (-1: none, rate 0) and strength multiplier. Pinned vertices are only
+    // removed at 1/100 of their rate. area_locked is empty or one flag per
+    // area rate; locked areas use the locked rate. Returns
+    // [PackedVector2Array simplified, float signed_area_delta]; the delta is
+    // shoelace area after minus before, positive when simplification gained area.
+    Array simplify(
+        const PackedVector2Array &polygon,
+        double tolerance,
+        const PackedInt32Array &vertex_area_indices,
+        const PackedFloat64Array &vertex_strength_multipliers,
+        const PackedInt32Array &pinned_vertices,
+        double rate_scale,
+        const PackedByteArray &area_locked);
+};
+
+#endif // WEIGHTED_VISVALINGAM_H
@@ -0,0 +1,84 @@
+#include "worker_pool.h"
+
+WorkerPool::WorkerPool(int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (thread_count < 1) {
+        thread_count = 1;
+    }
+    // The caller of run() is the remaining worker
+    for (int i = 0; i < thread_count - 1; i++) {
+        workers.emplace_back(&WorkerPool::worker_loop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::drain() {
+    const std::function<void(size_t)> &job = *current_job;
+    for (size_t i = next_index.fetch_add(1); i < current_count; i = next_index.fetch_add(1)) {
+        job(i);
+    }
+}
+
+void WorkerPool::run(size_t job_count, const std::function<void(size_t)> &job) {
+    if (job_count == 0) {
+        return;
+    }
+    if (workers.empty() || job_count == 1) {
+        for (size_t i = 0; i < job_count; i++) {
+            job(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current_job = &job;
+        current_count = job_count;
+        next_index.store(0);
+        active_workers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    drain();
+
+    // Wait until every worker has left this generation before the job goes out of scope
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return active_workers == 0; });
+    current_job = nullptr;
+}
+
+void WorkerPool::worker_loop() {
+    unsigned seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+        }
+
+        drain();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active_workers--;
+        }
+        done.notify_one();
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small persistent pool for independent batch jobs.
+// run(n, job) calls job(i) for every i in [0, n) and returns when all are done;
+// the calling thread takes part, so a pool of size 1 runs everything inline.
+class WorkerPool {
+public:
+    explicit WorkerPool(int thread_count = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    int get_thread_count() const { return static_cast<int>(workers.size()) + 1; }
+
+    void run(size_t job_count, const std::function<void(size_t)> &job);
+
+private:
+    void worker_loop();
+    void drain();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::mutex run_mutex; // serialises concurrent run() callers
+
+    const std::function<void(size_t)> *current_job = nullptr;
+    size_t current_count = 0;
+    std::atomic<size_t> next_index{0};
+    size_t active_workers = 0;
+    unsigned generation = 0;
+    bool stopping = false;
+};
+
+#endif // WORKER_POOL_H
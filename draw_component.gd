@@ -79,6 +79,7 @@ const DARKEN_UNCLICKED_ALPHA: float = 0.25
 var fog_mask_vp      : SubViewport     # new
 var fog_shape_root   : Node2D          # holds Polygon2D children
 var fog_rect : ColorRect             # keep reference if you want to fade
+var fog_clip : Clipper2Open = Clipper2Open.new()   # batched ring offsets
 const RINGS := [       
 	Vector2(8, 1.0),
 	#Vector2(48, 0.25),
@@ -235,32 +236,46 @@ func _update_fog_mask() -> void:
 		areas = get_parent().game_simulation_component.areas
 	else:
 		areas = get_parent().areas
+	var fog_areas: Array[Area] = []
+	var fog_polygons: Array[PackedVector2Array] = []
 	for area: Area in areas:
 		if area.owner_id < 0:
 			continue
 		if area.polygon.size() < 3:
 			continue
+		fog_areas.append(area)
+		fog_polygons.append(area.polygon)
+
+	# every area at every ring delta in one call, area-major
+	var ring_deltas := PackedFloat32Array()
+	for r in RINGS:
+		ring_deltas.append(r.x)
+	var ring_offsets: Array = []
+	if not fog_areas.is_empty():
+		ring_offsets = fog_clip.offset_polygons_batched(fog_polygons, ring_deltas, Geometry2D.JOIN_ROUND)
+
+	for i in fog_areas.size():
 		var p := Polygon2D.new()
-		p.polygon = area.polygon           # world coords already
+		p.polygon = fog_areas[i].polygon           # world coords already
 		p.color   = Color.WHITE
 		fog_shape_root.add_child(p)
 
-		for r in RINGS:
-			for ring in Geometry2D.offset_polygon(
-				area.polygon,
-				 r.x,
-				Geometry2D.JOIN_ROUND
-			):
+		for ri in RINGS.size():
+			var r: Vector2 = RINGS[ri]
+			var offset_rings: Array = ring_offsets[i * RINGS.size() + ri]
+			for ring in offset_rings[0]:
 				var halo := Polygon2D.new()
 				halo.polygon = ring
-				# Use subtract blend mode for clockwise polygons (holes)
-				if Geometry2D.is_polygon_clockwise(ring):
-					halo.color = Color.WHITE
-					var material := CanvasItemMaterial.new()
-					material.blend_mode = CanvasItemMaterial.BLEND_MODE_SUB
-					halo.material = material
-				else:
-					halo.color = Color(1,1,1, clamp(r.y*2, 0, 1))
+				halo.color = Color(1,1,1, clamp(r.y*2, 0, 1))
+				fog_shape_root.add_child(halo)
+			# Holes use subtract blend mode, drawn after the outers they cut into
+			for ring in offset_rings[1]:
+				var halo := Polygon2D.new()
+				halo.polygon = ring
+				halo.color = Color.WHITE
+				var material := CanvasItemMaterial.new()
+				material.blend_mode = CanvasItemMaterial.BLEND_MODE_SUB
+				halo.material = material
 				fog_shape_root.add_child(halo)
 
 	# 3. ask the VP to redraw (UPDATE_ALWAYS already, but OK)
@@ -109,15 +109,106 @@ const ARTILLERY_TRAIL_FADE_MAX: float = 1.0
 const ARTILLERY_MIN_PIECE_AREA: float = 5.0
 const ARTILLERY_MIN_TARGET_INTERSECTION_AREA: float = 10.0
 
+# Spread the batched Clipper2Open calls over all cores (results keep their order)
+const USE_PARALLEL_CLIPPING: bool = true
+# Clip on integers (coordinates * scale) so results are bit-identical across runs and machines
+const USE_FIXED_POINT_CLIPPING: bool = true
+const FIXED_POINT_CLIPPING_SCALE: float = 100.0
+
 var gd_extension_clip: Clipper2Open
+# Registry handle for the static walkable areas, indices match map.original_walkable_areas
+var original_walkable_areas_handle: int = -1
+# Union of the static obstacles (owner -2) with the world boundary (owner -3) as keep rect,
+# see clip_obstacles
+var static_obstacles_handle: int = -1
+# Per-tick area simplification (see _simplify_area_polygon)
+var simplifier: WeightedVisvalingam
+# 1 per map.original_walkable_areas entry not clicked yet, refreshed once per tick
+# for the click-locked owners
+var simplifier_unclicked_areas: PackedByteArray = PackedByteArray()
+# Point location over map.original_walkable_areas + map.original_obstacles (same order
+# as the spatial grid), walkable_areas_mask restricts lookups to the walkable ones
+var point_locator: PointLocator
+var walkable_areas_mask: PackedByteArray
 
 func _ready() -> void:
 	gd_extension_clip = Clipper2Open.new()
+	gd_extension_clip.set_parallel(USE_PARALLEL_CLIPPING)
+	gd_extension_clip.set_fixed_point(USE_FIXED_POINT_CLIPPING, FIXED_POINT_CLIPPING_SCALE)
+	simplifier = WeightedVisvalingam.new()
+	simplifier.set_rates(MIN_EXPANSION_SPEED, MAX_EXPANSION_SPEED, EXPANSION_SPEED)
+	_configure_simplifier()
+	_register_static_polygons()
 	collect_end_of_tick()
 	# To see debug stuff
 	z_index = 100
 
 
+# Static simplifier tables: terrain expansion rate per original walkable area at
+# unit strength (Global.get_expansion_speed is linear in the strength) and the
+# pinned original walkable area vertices
+func _configure_simplifier() -> void:
+	var area_rates: PackedFloat64Array = PackedFloat64Array()
+	area_rates.resize(map.original_walkable_areas.size())
+	for i: int in map.original_walkable_areas.size():
+		area_rates[i] = Global.get_expansion_speed(
+			EXPANSION_SPEED,
+			1.0,
+			map,
+			map.original_walkable_areas[i],
+			false,
+		)
+	simplifier.set_area_rates(area_rates)
+	simplifier.set_pinned_points(PackedVector2Array(map.original_walkable_areas_verices.keys()))
+	simplifier_unclicked_areas.resize(map.original_walkable_areas.size())
+
+func _refresh_simplifier_unclicked_areas() -> void:
+	for i: int in map.original_walkable_areas.size():
+		var polygon_id: int = map.original_walkable_areas[i].polygon_id
+		simplifier_unclicked_areas[i] = 0 if clicked_original_walkable_areas.has(polygon_id) else 1
+
+func _register_static_polygons() -> void:
+	var walkable_polygons: Array[PackedVector2Array] = []
+	for original_area: Area in map.original_walkable_areas:
+		walkable_polygons.append(original_area.polygon)
+	original_walkable_areas_handle = gd_extension_clip.register_polygons(walkable_polygons)
+
+	var obstacle_polygons: Array[PackedVector2Array] = []
+	for obstacle: Area in map.original_obstacles:
+		obstacle_polygons.append(obstacle.polygon)
+
+	var static_obstacle_polygons: Array[PackedVector2Array] = []
+	var world_rect: Rect2 = Rect2()
+	for obstacle: Area in areas:
+		if obstacle.owner_id == -2:
+			static_obstacle_polygons.append(obstacle.polygon)
+		elif obstacle.owner_id == -3:
+			world_rect = GeometryUtils.calculate_bounding_box(obstacle.polygon)
+	static_obstacles_handle = gd_extension_clip.register_obstacles(static_obstacle_polygons, world_rect)
+
+	var located_areas: Array[Area] = map.original_walkable_areas + map.original_obstacles
+	var located_polygons: Array[PackedVector2Array] = walkable_polygons + obstacle_polygons
+	var located_centers: PackedVector2Array = PackedVector2Array()
+	for located_area: Area in located_areas:
+		located_centers.append(located_area.center)
+	point_locator = PointLocator.new()
+	point_locator.build(
+		located_polygons,
+		located_centers,
+		map.original_walkable_areas_and_obstacles_spatial_grid.grid_cell_size,
+	)
+	walkable_areas_mask = PackedByteArray()
+	walkable_areas_mask.resize(located_areas.size())
+	walkable_areas_mask.fill(0)
+	for i: int in map.original_walkable_areas.size():
+		walkable_areas_mask[i] = 1
+
+
+# Original walkable area index per point (-1 where none), see GeometryUtils.points_to_areas_mapping
+func locate_walkable_areas(points: PackedVector2Array) -> PackedInt32Array:
+	return point_locator.locate_points(points, walkable_areas_mask)
+
+
 func _init(
 	p_areas: Array[Area],
 	p_map: Global.Map
@@ -202,7 +293,11 @@ func polygon_to_numbers(polygon: PackedVector2Array) -> float:
 	)
 	if Geometry2D.is_polygon_clockwise(polygon):
 		sign = -1
-	return sign*UnitLayer.MAX_UNITS*UnitLayer.NUMBER_PER_UNIT*area_of_intersected_part/(Global.world_size.x*Global.world_size.y)
+	return area_to_numbers(sign*area_of_intersected_part)
+
+# Signed area to numbers, same scale as polygon_to_numbers
+func area_to_numbers(signed_area: float) -> float:
+	return UnitLayer.MAX_UNITS*UnitLayer.NUMBER_PER_UNIT*signed_area/(Global.world_size.x*Global.world_size.y)
 
 
 func deployed_fraction(owner_id: int) -> float:	
@@ -240,17 +335,10 @@ func get_simulation_date_string() -> String:
 	return "%04d/%02d/%02d %02d:%02d" % [year, month, day, hour, minute]
 		
 func _get_original_area_at_point(p: Vector2) -> Area:
-	var clicked_areas: Dictionary[Vector2, Area] = GeometryUtils.points_to_areas_mapping([
-		p
-	], map, map.original_walkable_areas)
-	if clicked_areas.has(p):
-		var a: Area = clicked_areas[p]
-		if a == null:
-			return null
-		else:
-			return a
-	else:
+	var area_index: int = locate_walkable_areas(PackedVector2Array([p]))[0]
+	if area_index < 0:
 		return null
+	return map.original_walkable_areas[area_index]
 
 func _toggle_original_area(target_area: Area, at_position: Vector2) -> void:
 	if target_area == null:
@@ -262,62 +350,32 @@ func _toggle_original_area(target_area: Area, at_position: Vector2) -> void:
 	get_parent().draw_component.spawn_click_ripple(target_area, at_position, map)
 	get_parent().cursor_manager.start_animation()
 	
-func _clip_obstacle_polygon(
-	points: PackedVector2Array,
-	obstacle_points: PackedVector2Array,
-) -> Array:
-	var clipped_polygons: Array[PackedVector2Array] = []
-	if (
-		Geometry2D.is_polygon_clockwise(obstacle_points) and 
-		not Geometry2D.is_polygon_clockwise(points)
-	):
-		clipped_polygons = Geometry2D.intersect_polygons(points, obstacle_points)
-	else:
-		clipped_polygons = Geometry2D.clip_polygons(points, obstacle_points)
-	return GeometryUtils.split_into_inner_outer_polygons(clipped_polygons)
-
 func process_encircled_holes(holes: Array[PackedVector2Array]) -> Array:
 	var processed_holes: Array = []
 	for hole: PackedVector2Array in holes:
 		hole.reverse()
-		processed_holes += clip_obstacles(hole, areas)
+		processed_holes += clip_obstacles(hole)
 	return processed_holes
 
-func clip_obstacles(
-		polygon: PackedVector2Array,
-		all_areas: Array[Area],
-) -> Array:				# returns Array[[outer, holes]]
-	var pairs: Array = []
-	pairs.append([polygon, []])		# start with the full shape
-
-	for obstacle: Area in all_areas:
-		# keep only map obstacles
-		if obstacle.owner_id != -2 and obstacle.owner_id != -3:
-			continue
-
-		var obstacle_points: PackedVector2Array = obstacle.polygon
-		var next_pairs: Array = []
-
-		for pair in pairs:
-			var outer_poly: PackedVector2Array = pair[0]
-			var accumulated_holes: Array = pair[1]
-
-			var split_result: Array = _clip_obstacle_polygon(
-				outer_poly,
-				obstacle_points
-			)
-
-			var outers: Array = split_result[0]
-			var holes: Array = split_result[1]
-
-			for new_outer in outers:
-				var new_holes: Array = []
-				new_holes.append_array(accumulated_holes)
-				new_holes.append_array(holes)
-				next_pairs.append([new_outer, new_holes])
-		pairs = next_pairs				# continue with refined set
-
-	return pairs # [[PackedVector2Array, Array[PackedVector2Array]], …]
+func clip_obstacles(polygon: PackedVector2Array) -> Array:	# returns Array[[outer, holes]]
+	return clip_obstacles_batched([polygon])[0]
+
+# clip_obstacles for many polygons in one native call, one Array[[outer, holes]] each
+func clip_obstacles_batched(polygons: Array) -> Array:
+	var results: Array = gd_extension_clip.subtract_registered_obstacles_batched(polygons, static_obstacles_handle)
+	var pairs_per_polygon: Array = []
+	for rings: Array in results:
+		var outers: Array = rings[0]
+		var holes: Array = rings[1]
+		var hole_parents: PackedInt32Array = rings[2]
+		var pairs: Array = []
+		for outer: PackedVector2Array in outers:
+			pairs.append([outer, []])
+		for h: int in holes.size():
+			if hole_parents[h] >= 0:
+				pairs[hole_parents[h]][1].append(holes[h])
+		pairs_per_polygon.append(pairs)
+	return pairs_per_polygon # [[[PackedVector2Array, Array[PackedVector2Array]], …], …]
 
 func _apply_clip_result_to_area(
 		target_area: Area,
@@ -359,117 +417,73 @@ func _apply_clip_result_to_area(
 			extra_areas.append(spawned)		# holes discarded for now
 
 
-func merge_overlapping_areas_brute_force() -> void:
+func merge_overlapping_areas_same_owner() -> void:
 	# First group areas by owner
-	var areas_by_owner = {}
-	for area in areas:
+	var areas_by_owner: Dictionary[int, Array] = {}
+	for area: Area in areas:
 		if area.owner_id in [-3, -2]:
 			continue
 		if not areas_by_owner.has(area.owner_id):
 			areas_by_owner[area.owner_id] = []
 		areas_by_owner[area.owner_id].append(area)
-	
-	# Only merge areas owned by the same player
-	for owner_id in areas_by_owner.keys():
-		var owner_areas = areas_by_owner[owner_id]
-		var merges_occurred = true
-		
-		# Keep merging until no more changes occur
-		while merges_occurred:
-			merges_occurred = false
-			var i = 0
-			while i < owner_areas.size():
-				var area = owner_areas[i]
-				var initial_areas_count = owner_areas.size()
-				_merge_overlapping_area_same_owner(
-					area,
-					owner_areas,
-				)
-				# If areas were merged, the count would be different
-				if owner_areas.size() < initial_areas_count:
-					merges_occurred = true
-					break  # Start over as the array has been modified
-				i += 1
 
-func _merge_overlapping_area_same_owner(
-	area: Area,
-	potential_merge_areas: Array,
-) -> void:
-	# Use an iterative approach instead of recursion
-	var areas_to_check = [area]  # Stack of areas to process
-	var processed_areas = {}  # Track already processed pairs to avoid redundant checks
-	
-	while areas_to_check.size() > 0:
-		var current_area = areas_to_check.pop_back()
-		
-		# Check against all potential merge areas
-		var i = 0
-		while i < potential_merge_areas.size():
-			var other_area = potential_merge_areas[i]
-			
-			# Skip if it's the same area or different owner
-			if other_area == current_area or other_area.owner_id != current_area.owner_id:
-				i += 1
+	# Only merge areas owned by the same player, one native union per owner
+	for owner_id: int in areas_by_owner.keys():
+		var owner_areas: Array = areas_by_owner[owner_id]
+		if owner_areas.size() < 2:
+			continue
+		var owner_polygons: Array[PackedVector2Array] = []
+		for area: Area in owner_areas:
+			owner_polygons.append(area.polygon)
+		# [outers, holes, hole_parents, input_outers]
+		var merged: Array = gd_extension_clip.union_polygons_by_component(owner_polygons)
+		var outers: Array = merged[0]
+		var holes: Array = merged[1]
+		var hole_parents: PackedInt32Array = merged[2]
+		var input_outers: PackedInt32Array = merged[3]
+
+		var absorbed_by_outer: Dictionary[int, Array] = {}
+		for i: int in owner_areas.size():
+			# Degenerate polygon; inputs no outer absorbed are reported natively
+			if input_outers[i] < 0:
 				continue
-			
-			# Create a unique key for this area pair to avoid redundant checks
-			var pair_key = str(min(current_area.get_instance_id(), other_area.get_instance_id())) + "_" + str(max(current_area.get_instance_id(), other_area.get_instance_id()))
-			if processed_areas.has(pair_key):
-				i += 1
+			if not absorbed_by_outer.has(input_outers[i]):
+				absorbed_by_outer[input_outers[i]] = []
+			absorbed_by_outer[input_outers[i]].append(owner_areas[i])
+
+		for outer_index: int in absorbed_by_outer.keys():
+			var absorbed: Array = absorbed_by_outer[outer_index]
+			if absorbed.size() < 2:
 				continue
-			
-			processed_areas[pair_key] = true
-			
-			var merge: Array[PackedVector2Array] = Geometry2D.merge_polygons(current_area.polygon, other_area.polygon)
-			var result = GeometryUtils.split_into_inner_outer_polygons(merge)					
-			# There should be exactly one outer polygon
-			#assert(result[0].size() == 1)
-			if result[0].size() == 1:
-				var new_outer_polygon: PackedVector2Array = GeometryUtils.find_largest_polygon(result[0])
-				
-				# Determine which area is larger to transfer merged polygon to the largest area
-				var current_area_size: float = GeometryUtils.calculate_polygon_area(current_area.polygon)
-				var other_area_size: float = GeometryUtils.calculate_polygon_area(other_area.polygon)
-				
-				var larger_area: Area
-				var smaller_area: Area
-				var smaller_area_index: int
-				
-				if current_area_size >= other_area_size:
-					larger_area = current_area
-					smaller_area = other_area
-					smaller_area_index = i
-				else:
-					larger_area = other_area
-					smaller_area = current_area
-					# Find current_area's index in potential_merge_areas
-					smaller_area_index = potential_merge_areas.find(current_area)
-				
-				if result[1].size() > 0:
-					if not newly_encircled_areas.has(larger_area):
-						newly_encircled_areas[larger_area] = []
-					var hole_pairs: Array = process_encircled_holes(result[1])
-					newly_encircled_areas[larger_area].append_array(hole_pairs)
-					
-					var total_manpower_consumed: float = 0.0
-					for pair: Array in hole_pairs:
-						for hole: PackedVector2Array in [pair[0]]+pair[1]:
-							total_manpower_consumed += polygon_to_numbers(hole)
-					map.total_manpower[larger_area.owner_id] -= total_manpower_consumed
-				
-				# Update the larger area with the merged polygon
-				larger_area.polygon = new_outer_polygon
-				# Remove the smaller area and add the larger area back to the check list
-				areas.erase(smaller_area)
-				if smaller_area_index != -1:
-					potential_merge_areas.remove_at(smaller_area_index)
-				# Add the larger area back to the stack to check for more merges
-				areas_to_check.push_back(larger_area)
-				break  # Break to process the modified area
-			else:
-				#if not (result[0].size() == 2 and result[1].size() == 0):
-					#print(1)
-				i += 1
+			# The largest area keeps its identity and takes the merged polygon
+			var larger_area: Area = absorbed[0]
+			var larger_area_size: float = GeometryUtils.calculate_polygon_area(larger_area.polygon)
+			for absorbed_area: Area in absorbed:
+				var absorbed_area_size: float = GeometryUtils.calculate_polygon_area(absorbed_area.polygon)
+				if absorbed_area_size > larger_area_size:
+					larger_area = absorbed_area
+					larger_area_size = absorbed_area_size
+
+			var merge_holes: Array[PackedVector2Array] = []
+			for h: int in holes.size():
+				if hole_parents[h] == outer_index:
+					merge_holes.append(holes[h])
+			if merge_holes.size() > 0:
+				if not newly_encircled_areas.has(larger_area):
+					newly_encircled_areas[larger_area] = []
+				var hole_pairs: Array = process_encircled_holes(merge_holes)
+				newly_encircled_areas[larger_area].append_array(hole_pairs)
+
+				var total_manpower_consumed: float = 0.0
+				for pair: Array in hole_pairs:
+					for hole: PackedVector2Array in [pair[0]]+pair[1]:
+						total_manpower_consumed += polygon_to_numbers(hole)
+				map.total_manpower[larger_area.owner_id] -= total_manpower_consumed
+
+			larger_area.polygon = outers[outer_index]
+			for absorbed_area: Area in absorbed:
+				if absorbed_area != larger_area:
+					areas.erase(absorbed_area)
 
 
 func build_area_source_polygons_set() -> Dictionary[Area, Dictionary]:
@@ -890,7 +904,7 @@ func _create_expanded_areas(
 
 func should_expand_subarea(area: Area, walkable_area: Area) -> bool:
 	if (
-		not walkable_areas_covered()[area][walkable_area] and
+		not walkable_areas_covered()[area].get(walkable_area, false) and
 		(
 			not Global.only_expand_on_click(area.owner_id) or
 			clicked_walkable_areas().has(walkable_area.polygon_id)
@@ -1000,7 +1014,7 @@ func _collect_holding_lines() -> void:
 				not Global.only_expand_on_click(area.owner_id) or
 				clicked_walkable_areas().has(walkable_area.polygon_id)
 			) or (
-				walkable_areas_covered()[area][walkable_area]
+				walkable_areas_covered()[area].get(walkable_area, false)
 			):
 				continue
 
@@ -1071,6 +1085,28 @@ func _collect_holding_lines() -> void:
 										"weight":	stored_weight
 									})
 
+# Native weighted Visvalingam pass; returns [simplified polygon, signed area delta].
+# Expects simplifier_unclicked_areas refreshed for this tick.
+func _simplify_area_polygon(
+	area: Area,
+	vertex_area_indices: PackedInt32Array,
+	vertex_strength_multipliers: PackedFloat64Array,
+) -> Array:
+	var polygon: PackedVector2Array = area.polygon
+	var area_locked: PackedByteArray = PackedByteArray()
+	if Global.only_expand_on_click(area.owner_id):
+		area_locked = simplifier_unclicked_areas
+
+	return simplifier.simplify(
+		polygon,
+		SIMPLIFICATION_TOLERANCE,
+		vertex_area_indices,
+		vertex_strength_multipliers,
+		simplifier.find_pinned_vertices(polygon),
+		get_strength_density(area),
+		area_locked,
+	)
+
 func get_strength_density(area: Area) -> float:
 	if adjusted_strength_cache.has(area):
 		return adjusted_strength_cache[area]
@@ -1137,15 +1173,21 @@ func _precalculate_point_strength_multipliers(
 	polygon: PackedVector2Array,
 	area: Area,
 	all_area_strengths_raw: Dictionary[Area, float],
-	point_to_walkable_areas_map: Dictionary[Vector2, Area],
-) -> Dictionary[Vector2, float]:
-	var point_multipliers: Dictionary[Vector2, float] = {}
+	vertex_area_indices: PackedInt32Array,
+) -> PackedFloat64Array:
+	var point_multipliers: PackedFloat64Array = PackedFloat64Array()
+	point_multipliers.resize(polygon.size())
 	var area_strength: float = all_area_strengths_raw[area]
 	
-	for point: Vector2 in polygon:
+	for i: int in polygon.size():
+		var point: Vector2 = polygon[i]
 		var highest_multiplier: float = -INF  # Default when not in enemy territory
 		
-		var walkable_area: Area = point_to_walkable_areas_map[point]
+		# Vertices outside every walkable area keep the neutral multiplier
+		if vertex_area_indices[i] < 0:
+			point_multipliers[i] = 1.0
+			continue
+		var walkable_area: Area = map.original_walkable_areas[vertex_area_indices[i]]
 
 		# 1. Multiplier from strength diff
 		for enemy_area: Area in areas:
@@ -1177,7 +1219,7 @@ func _precalculate_point_strength_multipliers(
 			var air_layer: AirLayer = get_parent().draw_component.air_layer
 			var air_slowdown: float = air_layer.get_air_slowdown_multiplier(walkable_area)
 			highest_multiplier *= air_slowdown		
-		point_multipliers[point] = highest_multiplier
+		point_multipliers[i] = highest_multiplier
 	
 	return point_multipliers
 
@@ -2006,10 +2048,7 @@ func _process_expansions_and_holes(
 #  with the existing map – works for both Train and Tank instances.
 # ------------------------------------------------------------------
 func _spawn_area_for_vehicle(vehicle: Vehicle) -> void:
-	var collision_pairs: Array = clip_obstacles(
-		vehicle.collision_polygon(),
-		areas,
-	)
+	var collision_pairs: Array = clip_obstacles(vehicle.collision_polygon())
 	#collision_polygon = clip_obstacles(collision_polygon, areas)
 	var collision_polygon: PackedVector2Array = PackedVector2Array()
 	var collision_area: float = -1.0
@@ -2067,14 +2106,15 @@ func _spawn_area_for_vehicle(vehicle: Vehicle) -> void:
 				#map.total_casualties[enemy_area.owner_id] += deployed_fraction(enemy_area.owner_id)*new_casualties
 				take_casualty_from_area_loss(enemy_area.owner_id, new_casualties)
 			
-			var clipped: Array[PackedVector2Array] = Geometry2D.clip_polygons(
-				enemy_area.polygon, collision_polygon
+			var clipped: Array = boolean_polygons_tree(
+				enemy_area.polygon, collision_polygon, Geometry2D.OPERATION_DIFFERENCE
 			)
-			if clipped.is_empty():
+			var outers: Array[PackedVector2Array] = []
+			outers.assign(clipped[0])
+			if outers.is_empty():
 				enemy_area.polygon = PackedVector2Array()
 				continue
 
-			var outers: Array[PackedVector2Array] = GeometryUtils.split_into_inner_outer_polygons(clipped)[0]
 			var main: PackedVector2Array = GeometryUtils.find_largest_polygon(outers)
 			enemy_area.polygon = main
 			for poly: PackedVector2Array in outers:
@@ -2100,17 +2140,15 @@ func _spawn_area_for_vehicle(vehicle: Vehicle) -> void:
 			if merged:
 				continue
 				
-			var merged_polys: Array[PackedVector2Array] = Geometry2D.merge_polygons(
-				area.polygon, collision_polygon
+			var merged_tree: Array = boolean_polygons_tree(
+				area.polygon, collision_polygon, Geometry2D.OPERATION_UNION
 			)
-			var holes: Array[PackedVector2Array] = GeometryUtils.split_into_inner_outer_polygons(
-				merged_polys
-			)[1]
-			var polys: Array[PackedVector2Array] = GeometryUtils.split_into_inner_outer_polygons(
-				merged_polys
-			)[0]
+			var polys: Array[PackedVector2Array] = []
+			polys.assign(merged_tree[0])
+			var holes: Array[PackedVector2Array] = []
+			holes.assign(merged_tree[1])
 			if polys.size() == 1:
-				area.polygon = GeometryUtils.find_largest_polygon(merged_polys)
+				area.polygon = polys[0]
 				if newly_encircled_areas.has(area) == false:
 					newly_encircled_areas[area] = []
 				newly_encircled_areas[area].append_array(
@@ -2389,7 +2427,7 @@ func _physics_process(delta: float) -> void:
 	
 
 
-	merge_overlapping_areas_brute_force()
+	merge_overlapping_areas_same_owner()
 	
 	#var was_clipped: bool = true
 	#var areas_checked: Array = []
@@ -2435,70 +2473,65 @@ func _physics_process(delta: float) -> void:
 
 	# Compute strengths and offset polygons for simplification
 	var all_area_strengths_raw: Dictionary[Area, float] = _compute_all_area_strengths_raw()
+	_refresh_simplifier_unclicked_areas()
 	for area in areas:
 		if area.owner_id >= 0:
 			if print_iter > print_time:
 				print("before ", area.polygon.size())
 			
-			var point_to_walkable_areas_map: Dictionary[Vector2, Area] = (
-				GeometryUtils.points_to_areas_mapping(area.polygon, map, map.original_walkable_areas)
-			)
+			var vertex_area_indices: PackedInt32Array = locate_walkable_areas(area.polygon)
 
 			var polygon_before_simplificaiton: PackedVector2Array = area.polygon
-			var point_strength_multipliers: Dictionary[Vector2, float] = _precalculate_point_strength_multipliers(
+			var vertex_strength_multipliers: PackedFloat64Array = _precalculate_point_strength_multipliers(
 				area.polygon,
 				area,
 				all_area_strengths_raw,
-				point_to_walkable_areas_map,
+				vertex_area_indices,
 			)
 			
-			area.polygon = VisvalingamSimplifier.simplify_polygon_visvalingams(
-				area.polygon,
-				SIMPLIFICATION_TOLERANCE,
-				EXPANSION_SPEED,
-				map,
-				point_to_walkable_areas_map,
-				get_strength_density(area),
+			var simplification: Array = _simplify_area_polygon(
 				area,
-				clicked_original_walkable_areas,
-				point_strength_multipliers,
+				vertex_area_indices,
+				vertex_strength_multipliers,
 			)
+			area.polygon = simplification[0]
 			#area.polygon = NavigationServer2D.simplify_path(area.polygon, SIMPLIFICATION_TOLERANCE)
-			
-			var expanded_areas_from_simplification: Array[PackedVector2Array] = Geometry2D.clip_polygons(
-				area.polygon,
-				polygon_before_simplificaiton,
-			)
-			for expanded_area_from_simplification: PackedVector2Array in expanded_areas_from_simplification:
-				map.total_manpower[area.owner_id] -= polygon_to_numbers(expanded_area_from_simplification)
 
-			var removed_areas_from_simplification: Array[PackedVector2Array] = Geometry2D.clip_polygons(
-				polygon_before_simplificaiton,
-				area.polygon,
-			)
-			for removed_area_from_simplification: PackedVector2Array in removed_areas_from_simplification:
-				map.total_manpower[area.owner_id] += polygon_to_numbers(removed_area_from_simplification)
-			
-			var expanded_areas_from_simplification_inner: Array[PackedVector2Array] = GeometryUtils.split_into_inner_outer_polygons(expanded_areas_from_simplification)[0]
-			var expanded_areas_from_simplification_holes: Array[PackedVector2Array] = GeometryUtils.split_into_inner_outer_polygons(expanded_areas_from_simplification)[1]
-			
-			# TODO Should have to respect holes instead of skipping them
-			if expanded_areas_from_simplification_holes.size() == 0:
-			
-				if not newly_expanded_areas_full.has(area):
-					newly_expanded_areas_full[area] = []
+			# Area gained by simplification costs manpower, area lost refunds it
+			var simplification_area_delta: float = simplification[1]
+			map.total_manpower[area.owner_id] -= area_to_numbers(simplification_area_delta)
+
+			# Only the player's expansion is highlighted, so only it needs the gained pieces
+			if area.owner_id == PLAYER_ID and area.polygon.size() != polygon_before_simplificaiton.size():
+				var expanded_areas_from_simplification: Array = boolean_polygons_tree(
+					area.polygon,
+					polygon_before_simplificaiton,
+					Geometry2D.OPERATION_DIFFERENCE,
+				)
+				var expanded_areas_from_simplification_holes: Array = expanded_areas_from_simplification[1]
 				
-				for expanded_area_from_simplification: PackedVector2Array in expanded_areas_from_simplification:
-					newly_expanded_areas_full[area].append(expanded_areas_from_simplification)
+				# TODO Should have to respect holes instead of skipping them
+				if expanded_areas_from_simplification_holes.size() == 0:
+				
+					if not newly_expanded_areas_full.has(area):
+						newly_expanded_areas_full[area] = []
+					
+					for expanded_area_from_simplification: PackedVector2Array in expanded_areas_from_simplification[0]:
+						newly_expanded_areas_full[area].append(expanded_area_from_simplification)
 
 			if print_iter > print_time:
 				print("after ", area.polygon.size())
 
 	var extra_after_clip: Array[Area] = []
+	var clipped_areas: Array[Area] = []
+	var clipped_polygons: Array[PackedVector2Array] = []
 	for area: Area in areas:
 		if area.owner_id >= 0:
-			var clip_pairs: Array = clip_obstacles(area.polygon, areas)
-			_apply_clip_result_to_area(area, clip_pairs, extra_after_clip)
+			clipped_areas.append(area)
+			clipped_polygons.append(area.polygon)
+	var clip_pairs_per_area: Array = clip_obstacles_batched(clipped_polygons)
+	for i: int in clipped_areas.size():
+		_apply_clip_result_to_area(clipped_areas[i], clip_pairs_per_area[i], extra_after_clip)
 	areas.append_array(extra_after_clip)
 
 	_update_tanks_and_spawn(delta)
@@ -3053,85 +3086,34 @@ func _merge_areas_into_union(group_areas: Array) -> PackedVector2Array:
 
 func _build_union_adjacency_and_borders() -> void:
 	# Initialize adjacency and shared borders for unions
+	var union_polygons: Array[PackedVector2Array] = []
 	for union_area: Area in union_walkable_areas:
 		adjacent_union_walkable_area[union_area] = []
 		union_walkable_area_shared_borders[union_area] = {}
-	
-	# Build adjacency between unions
-	for i: int in range(union_walkable_areas.size()):
-		var union1: Area = union_walkable_areas[i]
-		for j: int in range(i + 1, union_walkable_areas.size()):
-			var union2: Area = union_walkable_areas[j]
-			
-			# Check if unions are adjacent by checking if their polygons share a border
-			var shared_borders: Array[PackedVector2Array] = _get_shared_border_between_unions(union1, union2)
-			if shared_borders.size() > 0:
-				adjacent_union_walkable_area[union1].append(union2)
-				adjacent_union_walkable_area[union2].append(union1)
-				union_walkable_area_shared_borders[union1][union2] = shared_borders
-				union_walkable_area_shared_borders[union2][union1] = shared_borders
-
-func _get_shared_border_between_unions(union1: Area, union2: Area) -> Array[PackedVector2Array]:
-	# Find all shared borders between two union areas
-	# Unions can have multiple separate border segments, so return an array
-	var shared_borders: Array[PackedVector2Array] = []
-	
-	#debug_poly = union2.polygon.duplicate()
-	# Use the same logic as the map generator for finding shared edges
-	var shared: Array = []
-	for i in range(union1.polygon.size()):
-		var a0 = union1.polygon[i]
-		var a1 = union1.polygon[(i+1)%union1.polygon.size()]
-		for j in range(union2.polygon.size()):
-			var b0 = union2.polygon[j]
-			var b1 = union2.polygon[(j+1)%union2.polygon.size()]
-			if (a0 == b1 and a1 == b0) or (a0 == b0 and a1 == b1):
-				shared.append([a0, a1])
-	
-	if shared.size() == 0:
-		return shared_borders
-	
-	# Chain together shared edges into polylines
-	# Since unions can have multiple separate border segments, we need to handle multiple chains
-	var remaining_shared = shared.duplicate()
-	
-	while remaining_shared.size() > 0:
-		var border = [remaining_shared[0][0], remaining_shared[0][1]]
-		remaining_shared.remove_at(0)
-		
-		# Try to extend this border chain
-		var extended = true
-		while extended and remaining_shared.size() > 0:
-			extended = false
-			for k in range(remaining_shared.size()):
-				var e0 = remaining_shared[k][0]
-				var e1 = remaining_shared[k][1]
-				if border[border.size()-1] == e0:
-					border.append(e1)
-					remaining_shared.remove_at(k)
-					extended = true
-					break
-				elif border[border.size()-1] == e1:
-					border.append(e0)
-					remaining_shared.remove_at(k)
-					extended = true
-					break
-				elif border[0] == e0:
-					border.insert(0, e1)
-					remaining_shared.remove_at(k)
-					extended = true
-					break
-				elif border[0] == e1:
-					border.insert(0, e0)
-					remaining_shared.remove_at(k)
-					extended = true
-					break
-		
-		# Add this border segment if it's long enough
-		if border.size() >= 2:
-			shared_borders.append(PackedVector2Array(border))
-	
-	return shared_borders
+		union_polygons.append(union_area.polygon)
+	
+	# Unions are adjacent when their polygons share an edge; unions can have several
+	# separate border segments. [first, second, points, border_offsets, border_pairs]
+	var borders: Array = PolygonTopology.shared_borders(union_polygons)
+	var first: PackedInt32Array = borders[0]
+	var second: PackedInt32Array = borders[1]
+	var points: PackedVector2Array = borders[2]
+	var border_offsets: PackedInt32Array = borders[3]
+	var border_pairs: PackedInt32Array = borders[4]
+	var shared_borders_per_pair: Array = []
+	for pair: int in first.size():
+		var shared_borders: Array[PackedVector2Array] = []
+		shared_borders_per_pair.append(shared_borders)
+	for b: int in border_pairs.size():
+		shared_borders_per_pair[border_pairs[b]].append(points.slice(border_offsets[b], border_offsets[b + 1]))
+
+	for pair: int in first.size():
+		var union1: Area = union_walkable_areas[first[pair]]
+		var union2: Area = union_walkable_areas[second[pair]]
+		adjacent_union_walkable_area[union1].append(union2)
+		adjacent_union_walkable_area[union2].append(union1)
+		union_walkable_area_shared_borders[union1][union2] = shared_borders_per_pair[pair]
+		union_walkable_area_shared_borders[union2][union1] = shared_borders_per_pair[pair]
 
 func _build_union_river_neighbors() -> void:
 	# Initialize river neighbors for unions
@@ -3169,79 +3151,76 @@ func _collect_intersections_with_walkable_areas() -> void:
 		# Initialize union intersections
 		for union_area: Area in union_walkable_areas:
 			intersecting_union_walkable_area_start_of_tick[union_area] = {}
-		
 
+	# Coverage dictionaries are sparse: walkable areas without an entry are not covered
+	var owned_areas: Array[Area] = []
+	var owned_polygons: Array[PackedVector2Array] = []
 	for area: Area in areas:
 		if area.owner_id < 0:
 			continue
-		
-		# Initialize dictionaries for this area
-		var original_walkable_area_covered: Dictionary = {}
-		original_walkable_areas_covered[area] = original_walkable_area_covered
-		
+		owned_areas.append(area)
+		owned_polygons.append(area.polygon)
+		original_walkable_areas_covered[area] = {}
+		original_walkable_areas_partially_covered[area] = {}
+		area_source_polygons[area] = []
+
+	# One native call for all areas x all original walkable areas, broadphase included.
+	# Only actual overlaps come back, ordered by area, then by walkable area index.
+	var sparse_results: Array = gd_extension_clip.intersect_polygons_with_registered_polygons(
+		owned_polygons,
+		original_walkable_areas_handle
+	)
+	var result_area_indices: PackedInt32Array = sparse_results[0]
+	var result_original_indices: PackedInt32Array = sparse_results[1]
+	var result_polygons: Array = sparse_results[2]
+	for k: int in result_area_indices.size():
+		var area: Area = owned_areas[result_area_indices[k]]
+		var original_area: Area = map.original_walkable_areas[result_original_indices[k]]
+		var intersecting_polygons: Array = result_polygons[k]
+		var fully_covered: bool = false
+		
+		if intersecting_polygons.size() == 1:
+			fully_covered = GeometryUtils.same_polygon_shifted(original_area.polygon, intersecting_polygons[0])
+		
+		intersecting_original_walkable_area_start_of_tick[original_area][area] = intersecting_polygons
+		original_walkable_areas_covered[area][original_area] = fully_covered
+		original_walkable_areas_partially_covered[area][original_area] = true
+		if not USE_UNION:
+			# Record area as source if there's any intersection
+			area_source_polygons[area].append(original_area.polygon_id)
+
+	if not USE_UNION:
+		return
+
+	for area: Area in owned_areas:
 		# Calculate area bounds once
 		var area_bounds: Rect2 = GeometryUtils.calculate_bounding_box(area.polygon)
 		
-		# Collect polygons to batch process for original walkable areas
-		var original_polygons_to_intersect: Array[PackedVector2Array] = []
-		var original_area_keys: Array = []
+		# Collect polygons to batch process for union areas
+		var union_polygons_to_intersect: Array[PackedVector2Array] = []
+		var union_area_keys: Array = []
 		
-		# Process each original walkable area - collect for batching
-		for original_area: Area in map.original_walkable_areas:
-			var polygon_id: int = original_area.polygon_id
-			var original_rect: Rect2 = map.original_walkable_area_bounds_rect[original_area]
+		# Process each union area for intersections - collect for batching
+		for union_area: Area in union_walkable_areas:
+			var union_rect: Rect2 = GeometryUtils.calculate_bounding_box(union_area.polygon)
 			
 			# Fast bounds check
-			if not area_bounds.intersects(original_rect):
-				# No intersection possible, use empty array instead of computing
-				original_walkable_area_covered[original_area] = false
+			if not area_bounds.intersects(union_rect):
 				continue
-
-			original_polygons_to_intersect.append(original_area.polygon)
-			original_area_keys.append(original_area)
-		
-		# Batch process original walkable area intersections using Clipper2
-		if original_polygons_to_intersect.size() > 0:
-			var original_results: Array = intersect_polygons_batched(original_polygons_to_intersect, area.polygon)
 			
-			for i: int in original_results.size():
-				var original_area: Area = original_area_keys[i]
-				var intersecting_polygons: Array = original_results[i]
-				var fully_covered: bool = false
-				
-				if intersecting_polygons.size() == 1:
-					fully_covered = GeometryUtils.same_polygon_shifted(original_area.polygon, intersecting_polygons[0])
-				
-				if intersecting_polygons.size() > 0:
-					intersecting_original_walkable_area_start_of_tick[original_area][area] = intersecting_polygons
-				original_walkable_area_covered[original_area] = fully_covered
-		
-		if USE_UNION:
-			# Collect polygons to batch process for union areas
-			var union_polygons_to_intersect: Array[PackedVector2Array] = []
-			var union_area_keys: Array = []
+			union_polygons_to_intersect.append(union_area.polygon)
+			union_area_keys.append(union_area)
+	
+		# Batch process union area intersections using Clipper2
+		if union_polygons_to_intersect.size() > 0:
+			var union_results: Array = intersect_polygons_batched(union_polygons_to_intersect, area.polygon)
 			
-			# Process each union area for intersections - collect for batching
-			for union_area: Area in union_walkable_areas:
-				var union_rect: Rect2 = GeometryUtils.calculate_bounding_box(union_area.polygon)
-				
-				# Fast bounds check
-				if not area_bounds.intersects(union_rect):
-					continue
+			for i: int in union_results.size():
+				var union_area: Area = union_area_keys[i]
+				var union_intersecting_polygons: Array = union_results[i]
 				
-				union_polygons_to_intersect.append(union_area.polygon)
-				union_area_keys.append(union_area)
-		
-			# Batch process union area intersections using Clipper2
-			if union_polygons_to_intersect.size() > 0:
-				var union_results: Array = intersect_polygons_batched(union_polygons_to_intersect, area.polygon)
-				
-				for i: int in union_results.size():
-					var union_area: Area = union_area_keys[i]
-					var union_intersecting_polygons: Array = union_results[i]
-					
-					if union_intersecting_polygons.size() != 0:
-						intersecting_union_walkable_area_start_of_tick[union_area][area] = union_intersecting_polygons
+				if union_intersecting_polygons.size() != 0:
+					intersecting_union_walkable_area_start_of_tick[union_area][area] = union_intersecting_polygons
 
 		var area_sources: Array = []
 		for walkable_area: Area in walkable_areas():
@@ -3252,30 +3231,12 @@ func _collect_intersections_with_walkable_areas() -> void:
 			):
 				area_sources.append(walkable_area.polygon_id)
 		area_source_polygons[area] = area_sources
-		
 
-	for area: Area in areas:
-		if area.owner_id < 0:
-			continue
-			
-		var owner_id: int = area.owner_id
-		if not original_walkable_areas_partially_covered.has(area):
-			original_walkable_areas_partially_covered[area] = {}
+	for area: Area in owned_areas:
 		if not union_walkable_areas_partially_covered.has(area):
 			union_walkable_areas_partially_covered[area] = {}
 		if not union_walkable_areas_covered.has(area):
 			union_walkable_areas_covered[area] = {}
-			
-		for original_area: Area in map.original_walkable_areas:
-			original_walkable_areas_partially_covered[area][original_area]=false
-			
-			var polygon_id: int = original_area.polygon_id
-			# Check for partial coverage and collect for player ID
-			if (
-				intersecting_original_walkable_area_start_of_tick[original_area].has(area) and
-				intersecting_original_walkable_area_start_of_tick[original_area][area].size() > 0
-			):
-				original_walkable_areas_partially_covered[area][original_area] = true
 		
 		# Collect union coverage
 		for union_area: Area in union_walkable_areas:
@@ -3314,7 +3275,7 @@ func _collect_intersecting_boundaries() -> void:
 		var polyline_keys: Array = []
 
 		for walkable_area: Area in walkable_areas():
-			if not walkable_areas_partially_covered()[area][walkable_area]:
+			if not walkable_areas_partially_covered()[area].get(walkable_area, false):
 				continue
 
 			for adjacent_walkable_area: Area in adjacent_walkable_area()[walkable_area]:
@@ -3357,6 +3318,23 @@ func intersect_many_polyline_with_polygon_deterministic(
 ):
 	return gd_extension_clip.intersect_many_polyline_with_polygon_deterministic(polylines, polygon, eps)
 
+# One [outers, holes, hole_parents] entry per (polygon, delta), polygon-major
+func offset_polygons_batched(
+	polygons: Array,
+	deltas: PackedFloat32Array,
+	join_type: Geometry2D.PolyJoinType
+) -> Array:
+	return gd_extension_clip.offset_polygons_batched(polygons, deltas, join_type)
+
+# Geometry2D-style boolean of two polygons as [outers, holes, hole_parents]; Clipper's
+# PolyTree already tells outers from holes, so no orientation pass is needed
+func boolean_polygons_tree(
+	polygon_a: PackedVector2Array,
+	polygon_b: PackedVector2Array,
+	operation: Geometry2D.PolyBooleanOperation
+) -> Array:
+	return gd_extension_clip.boolean_polygons_tree([polygon_a], [polygon_b], operation)
+
 func intersect_polygons_batched(
 	polygons: Array,
 	subject_polygon: PackedVector2Array
@@ -3369,6 +3347,20 @@ func intersect_many_polylines_with_polygons(
 ) -> Array:
 	return gd_extension_clip.intersect_many_polylines_with_polygons(polylines, polygons)
 
+func intersect_registered_polygons_batched(
+	handle: int,
+	indices: PackedInt32Array,
+	subject_polygon: PackedVector2Array
+) -> Array:
+	return gd_extension_clip.intersect_registered_polygons_batched(handle, indices, subject_polygon)
+
+func intersect_many_ringpolylines_with_registered_polygons(
+	polylines: Array,
+	handle: int,
+	indices: PackedInt32Array
+) -> Array:
+	return gd_extension_clip.intersect_many_ringpolylines_with_registered_polygons(polylines, handle, indices)
+
 func intersect_many_ringpolylines_with_polygons(
 	polylines: Array,
 	polygons: Array
@@ -3376,70 +3368,62 @@ func intersect_many_ringpolylines_with_polygons(
 	return gd_extension_clip.intersect_many_ringpolylines_with_polygons(polylines, polygons)
 
 func _collect_big_cross_area_intersections() -> void:
+	# Offsets, enemy overlaps and their contact lengths in one native call
+	var offset_keys: Array[Area] = []
+	var offset_polygons: Array[PackedVector2Array] = []
+	var offset_owner_ids: PackedInt32Array = PackedInt32Array()
 	for area: Area in areas:
 		if area.owner_id < 0: continue
-		slightly_offset_area_polygons[area] = Geometry2D.offset_polygon(
-			area.polygon,
-			OFFSET_MULT_FOR_DETECTING_EXPANSION,
-			Geometry2D.JOIN_ROUND
-		)
-	
-	for area: Area in areas:
-		if area.owner_id < 0: continue
+		offset_keys.append(area)
+		offset_polygons.append(area.polygon)
+		offset_owner_ids.append(area.owner_id)
+	# Note that it will be missing exactly the holding area!
+	var measure_polygons: Array[PackedVector2Array] = []
+	for walkable_area: Area in walkable_areas():
+		if clicked_walkable_areas().has(walkable_area.polygon_id):
+			measure_polygons.append(walkable_area.polygon)
+	# [offsets, first, second, contact_lengths, overlaps]
+	var detection: Array = gd_extension_clip.collect_offset_overlaps(
+		offset_polygons,
+		offset_owner_ids,
+		OFFSET_MULT_FOR_DETECTING_EXPANSION,
+		measure_polygons,
+		GameSimulationComponent.PLAYER_ID,
+	)
+	var offset_results: Array = detection[0]
+	var first_indices: PackedInt32Array = detection[1]
+	var second_indices: PackedInt32Array = detection[2]
+	var contact_lengths: PackedFloat64Array = detection[3]
+	var overlaps: Array = detection[4]
+	for i: int in offset_keys.size():
+		var rings: Array[PackedVector2Array] = []
+		rings.assign(offset_results[i][0])
+		rings.append_array(offset_results[i][1])
+		slightly_offset_area_polygons[offset_keys[i]] = rings
+	
+	for area: Area in offset_keys:
 		big_intersecting_areas[area] = {}
-		for other_area: Area in areas:
-			if other_area.owner_id < 0: continue
+		if area.owner_id == GameSimulationComponent.PLAYER_ID:
+			big_intersecting_areas_circumferences[area] = {}
+		for other_area: Area in offset_keys:
 			var empty: Array[PackedVector2Array] = []
 			big_intersecting_areas[area][other_area] = empty
-	for area: Area in areas:
-		if area.owner_id < 0: continue
-		
-		for slightly_offset_area_polygon: PackedVector2Array in slightly_offset_area_polygons[area]:
-			for other_area: Area in areas:
-				if other_area.owner_id < 0: continue
-				if area.owner_id == other_area.owner_id:
-					continue
-				
-				for slightly_offset_other_area_polygon: PackedVector2Array in slightly_offset_area_polygons[other_area]:
-					var all_intersecting: Array[PackedVector2Array] = Geometry2D.intersect_polygons(
-						slightly_offset_area_polygon,
-						slightly_offset_other_area_polygon,
-					) 
-					big_intersecting_areas[area][other_area].append_array(
-						all_intersecting
-					)
-
-	for area: Area in big_intersecting_areas.keys():
-		if area.owner_id != GameSimulationComponent.PLAYER_ID: continue
-		big_intersecting_areas_circumferences[area] = {}
-		for other_area: Area in big_intersecting_areas[area]:
-			if (
-				big_intersecting_areas_circumferences.has(other_area) and 
-				big_intersecting_areas_circumferences[other_area].has(area)
-			):
-				big_intersecting_areas_circumferences[area][other_area] = big_intersecting_areas_circumferences[other_area][area]
-				continue
-
-			big_intersecting_areas_circumferences[area][other_area] = 0
-			var polylines: Array[PackedVector2Array] = big_intersecting_areas[area][other_area]
-			for polyline: PackedVector2Array in polylines:
-				var is_hole: bool = Geometry2D.is_polygon_clockwise(polyline)
-				var multiplier: float = 1
-				if is_hole:
-					multiplier = -1
-				polyline = polyline.duplicate()
-				polyline.append(polyline[0])
-				for walkable_area: Area in walkable_areas():
-					if not clicked_walkable_areas().has(walkable_area.polygon_id):
-						continue
-					
-					# Note that it will be missing exactly the holding area!
-					for intersecting_polyline: PackedVector2Array in Geometry2D.intersect_polyline_with_polygon(
-						polyline,
-						walkable_area.polygon
-					):
-						for ind: int in range(intersecting_polyline.size()-1):							
-							big_intersecting_areas_circumferences[area][other_area] += multiplier*(intersecting_polyline[ind]-intersecting_polyline[ind+1]).length()
+			if area.owner_id == GameSimulationComponent.PLAYER_ID:
+				big_intersecting_areas_circumferences[area][other_area] = 0
+
+	# Only pairs that really overlap come back, each once
+	for k: int in first_indices.size():
+		var area: Area = offset_keys[first_indices[k]]
+		var other_area: Area = offset_keys[second_indices[k]]
+		var rings: Array[PackedVector2Array] = []
+		rings.assign(overlaps[k][0])
+		rings.append_array(overlaps[k][1])
+		big_intersecting_areas[area][other_area] = rings
+		big_intersecting_areas[other_area][area] = rings.duplicate()
+		if big_intersecting_areas_circumferences.has(area):
+			big_intersecting_areas_circumferences[area][other_area] = contact_lengths[k]
+		if big_intersecting_areas_circumferences.has(other_area):
+			big_intersecting_areas_circumferences[other_area][area] = contact_lengths[k]
 
 func _collect_expanding_lines() -> void:
 
@@ -3468,15 +3452,27 @@ func _collect_expanding_lines() -> void:
 				continue
 			# Build walkable batch for this single line
 			var batch_polys: Array[PackedVector2Array] = []
+			var batch_indices: PackedInt32Array = PackedInt32Array()
 			var batch_keys: Array = []
-			for walkable_area_b: Area in walkable_areas():
+			for walkable_index: int in walkable_areas().size():
+				var walkable_area_b: Area = walkable_areas()[walkable_index]
 				if should_expand_subarea(area, walkable_area_b):
-					batch_polys.append(walkable_area_b.polygon)
+					if USE_UNION:
+						batch_polys.append(walkable_area_b.polygon)
+					batch_indices.append(walkable_index)
 					batch_keys.append(walkable_area_b)
-			if batch_polys.size() == 0:
+			if batch_keys.size() == 0:
 				continue
 			# Use ring-aware version to avoid duplicating polyline in GDScript
-			var grouped_line: Array = intersect_many_ringpolylines_with_polygons([slightly_offset_poly_b], batch_polys)
+			var grouped_line: Array
+			if USE_UNION:
+				grouped_line = intersect_many_ringpolylines_with_polygons([slightly_offset_poly_b], batch_polys)
+			else:
+				grouped_line = intersect_many_ringpolylines_with_registered_polygons(
+					[slightly_offset_poly_b],
+					original_walkable_areas_handle,
+					batch_indices
+				)
 			if grouped_line.size() != batch_keys.size():
 				continue
 			var total_circum_sum_line: float = 0.0
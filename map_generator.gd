@@ -23,6 +23,9 @@ const weights: Dictionary[String, float] = {
 
 const use_floodfill_borders := true # Set to true to enable wavy borders
 
+# Vertices shared by neighbouring map polygons are compared on this grid
+const ADJACENCY_SNAP: float = 0.001
+
 func setup_game(
 	mode: Global.GameMode,
 	areas: Array[Area],
@@ -95,17 +98,15 @@ func setup_random_game(areas: Array[Area], minimum_area_strength: float) -> void
 
 
 func _build_walkable_adjacency(walkables: Array[Area]) -> Dictionary:
+	var graph: Array = PolygonTopology.adjacency_graph(_area_polygons(walkables), ADJACENCY_SNAP)
+	var offsets: PackedInt32Array = graph[0]
+	var neighbours: PackedInt32Array = graph[1]
 	var adjacency: Dictionary = {}
 	for i: int in range(walkables.size()):
-		var a: Area = walkables[i]
-		adjacency[a.polygon_id] = []
-	for i: int in range(walkables.size()):
-		var a: Area = walkables[i]
-		for j: int in range(i + 1, walkables.size()):
-			var b: Area = walkables[j]
-			if GeometryUtils.are_polygons_adjacent(a.polygon, b.polygon):
-				adjacency[a.polygon_id].append(b.polygon_id)
-				adjacency[b.polygon_id].append(a.polygon_id)
+		var adjacent: Array = []
+		for k: int in range(offsets[i], offsets[i + 1]):
+			adjacent.append(walkables[neighbours[k]].polygon_id)
+		adjacency[walkables[i].polygon_id] = adjacent
 	return adjacency
 
 
@@ -133,22 +134,7 @@ func _walkable_is_connected(areas_all: Array[Area]) -> bool:
 
 # Helper: Lloyd relaxation for seed points
 func lloyd_relaxation(seed_points: Array, iterations: int) -> Array:
-	var points = seed_points.duplicate()
-	for _i: int in range(iterations):
-		var voronoi = generate_voronoi_cells(points)
-		var new_points = []
-		for center in points:
-			var cell = voronoi[center]
-			if cell.size() == 0:
-				continue
-			# Compute centroid
-			var centroid = Vector2.ZERO
-			for pt in cell:
-				centroid += pt
-			centroid /= cell.size()
-			new_points.append(centroid)
-		points = new_points
-	return points
+	return Array(VoronoiDiagram.relax_seeds(PackedVector2Array(seed_points), _voronoi_bounds(), iterations))
 
 func _safe_round(point: Vector2) -> Vector2:
 		var eps: float = 0.01
@@ -163,24 +149,12 @@ func generate_voronoi_map(
 	var total_cells = num_areas
 
 	# 2. Generate seed points for Voronoi cells
-	var seed_points = []
 	var world_area = Global.world_size.x * Global.world_size.y
 	var point_density = total_cells / world_area
 	var min_distance = sqrt(1.0 / point_density) * 0.75
-	var max_attempts = total_cells * 10
-	var attempts = 0
-	while seed_points.size() < total_cells and attempts < max_attempts:
-		attempts += 1
-		var x = rng.randf_range(0, Global.world_size.x)
-		var y = rng.randf_range(0, Global.world_size.y)
-		var new_point = Vector2(x, y)
-		var too_close = false
-		for existing in seed_points:
-			if existing.distance_to(new_point) < min_distance:
-				too_close = true
-				break
-		if not too_close:
-			seed_points.append(new_point)
+	var seed_points: Array = Array(PoissonDiskSampler.sample(
+		Rect2(Vector2.ZERO, Global.world_size), min_distance, total_cells, rng.randi()
+	))
 
 	print("seed_points count: ", seed_points.size())
 
@@ -188,36 +162,14 @@ func generate_voronoi_map(
 	seed_points = lloyd_relaxation(seed_points, 3)
 
 	# 4. Generate Voronoi diagram
-	var voronoi_cells: Dictionary[Vector2, PackedVector2Array] = generate_voronoi_cells(seed_points)
+	# Snapping to integers is important to avoid floating point issues around
+	# vertices, e.g. merging two obstacles that are "just" adjacent.
+	var cell_adjacency: Dictionary = {}
+	var voronoi_cells: Dictionary[Vector2, PackedVector2Array] = generate_voronoi_cells(seed_points, true, cell_adjacency)
 	print("voronoi_cells count: ", voronoi_cells.size())
 
-	for center_point: Vector2  in voronoi_cells.keys():
-		var cell: PackedVector2Array = voronoi_cells[center_point]
-		assert(cell.size() >= 3)
-		# This is important to avoid floating point issues around vertices,
-		# e.g. merging two obstacles that are "just" adjacent.
-		var integer_cell: PackedVector2Array = []
-		for point in cell:
-			integer_cell.append(_safe_round(point))
-		voronoi_cells[center_point] = integer_cell
-	
 	if use_floodfill_borders:
-		# Build adjacency for all cells
 		var cell_centers = voronoi_cells.keys()
-		var cell_adjacency = {}
-		for i in range(cell_centers.size()):
-			var a = cell_centers[i]
-			cell_adjacency[a] = []
-		for i in range(cell_centers.size()):
-			var a = cell_centers[i]
-			var poly_a = voronoi_cells[a]
-			for j in range(i+1, cell_centers.size()):
-				var b = cell_centers[j]
-				var poly_b = voronoi_cells[b]
-				if GeometryUtils.are_polygons_adjacent(poly_a, poly_b):
-					cell_adjacency[a].append(b)
-					cell_adjacency[b].append(a)
-		
 		
 		# For each pair of adjacent cells, replace shared border with wavy border
 		var processed_pairs = {}
@@ -296,146 +248,33 @@ func generate_voronoi_map(
 				original_area.color = Global.neutral_color
 	return areas
 
-# Generate Voronoi cells from seed points using the Fortune's algorithm approach
-func generate_voronoi_cells(seed_points: Array) -> Dictionary[Vector2, PackedVector2Array]:
+func _voronoi_bounds() -> Rect2:
+	return Rect2(Vector2.ZERO, Global.world_size)
+
+# Voronoi cells of the seed points clipped to the world, keyed by seed point.
+# snap_to_integer rounds the vertices like _safe_round (neighbouring cells
+# keep exactly shared edges). cell_adjacency, when given, is filled with the
+# seed points whose cells share an edge with each cell.
+func generate_voronoi_cells(
+	seed_points: Array,
+	snap_to_integer: bool = false,
+	cell_adjacency: Dictionary = {}
+) -> Dictionary[Vector2, PackedVector2Array]:
 	var voronoi_cells: Dictionary[Vector2, PackedVector2Array] = {}
-	
-	# 1. Create a bounding box larger than the world size to ensure all cells are closed
-	var padding = 300  # Extra space around the world to ensure closed polygons
-	var bounds = Rect2(
-		-padding, -padding, 
-		Global.world_size.x + 2*padding, Global.world_size.y + 2*padding
-	)
-	
-	# 2. For each seed point, calculate its Voronoi cell
+	var diagram: Array = VoronoiDiagram.build_cells(PackedVector2Array(seed_points), _voronoi_bounds(), snap_to_integer)
+	var cells: Array = diagram[0]
+	var adjacency_offsets: PackedInt32Array = diagram[1]
+	var adjacency: PackedInt32Array = diagram[2]
 	for i: int in range(seed_points.size()):
-		var cell_vertices = compute_voronoi_cell(seed_points[i], seed_points, i, bounds)
-		if cell_vertices.size() >= 3:
-			#var integer_cell_vertices: PackedVector2Array = PackedVector2Array()
-			#for voroni_point in cell_vertices:
-			#	integer_cell_vertices.append(Vector2i(voroni_point))
-			#cell_vertices = integer_cell_vertices
-			#voronoi_cells[seed_points[i]] = PackedVector2Array(cell_vertices)
-			
-			voronoi_cells[seed_points[i]] = cell_vertices
-			
-	return voronoi_cells
-
-# Compute a single Voronoi cell for a seed point
-func compute_voronoi_cell(center: Vector2, all_points: Array, center_index: int, bounds: Rect2) -> PackedVector2Array:
-	# This function computes a Voronoi cell by:
-	# 1. Finding all perpendicular bisectors between this point and all other points
-	# 2. Finding the intersection of half-planes defined by these bisectors
-	
-	# Start with the bounding box as the initial polygon
-	var vertices = [
-		Vector2(bounds.position.x, bounds.position.y),
-		Vector2(bounds.position.x + bounds.size.x, bounds.position.y),
-		Vector2(bounds.position.x + bounds.size.x, bounds.position.y + bounds.size.y),
-		Vector2(bounds.position.x, bounds.position.y + bounds.size.y)
-	]
-	
-	# For each other point, clip the polygon with the perpendicular bisector
-	for j in range(all_points.size()):
-		if j == center_index:
+		var cell_vertices: PackedVector2Array = cells[i]
+		if cell_vertices.size() < 3:
 			continue
-			
-		var other = all_points[j]
-		
-		# Calculate the midpoint between the center and other point
-		var midpoint = (center + other) / 2.0
-		
-		# Calculate the perpendicular direction (normal) to the line between points
-		var direction = (other - center).normalized()
-		var normal = Vector2(-direction.y, direction.x)
-		
-		# Define a line through the midpoint in the normal direction
-		var line_start = midpoint
-		var line_end = midpoint + normal * 1000  # Long enough to intersect with polygon
-		
-		# Clip the current polygon with this half-plane
-		vertices = clip_polygon_with_line(vertices, line_start, line_end, center, other)
-		
-		# If too few vertices remain, this cell is invalid
-		if vertices.size() < 3:
-			break
-	
-	# Clip against world boundary to ensure we stay in bounds
-	var world_rect = Rect2(0, 0, Global.world_size.x, Global.world_size.y)
-	vertices = clip_polygon_with_rect(vertices, world_rect)
-	
-	return PackedVector2Array(vertices)
-
-# Helper function to clip a polygon with a line
-func clip_polygon_with_line(vertices: Array, line_start: Vector2, line_end: Vector2, 
-							center: Vector2, other: Vector2) -> Array:
-	var result = []
-	var line_dir = (line_end - line_start).normalized()
-	
-	# Determine which side of the line to keep (the one containing center)
-	var center_side = sign((center - line_start).cross(line_dir))
-	
-	for i in range(vertices.size()):
-		var current = vertices[i]
-		var next = vertices[(i + 1) % vertices.size()]
-		
-		# Check which side of the line the current vertex is on
-		var current_side = sign((current - line_start).cross(line_dir))
-		var next_side = sign((next - line_start).cross(line_dir))
-		
-		# If current vertex is on the correct side (or on the line), keep it
-		if current_side == center_side or current_side == 0:
-			result.append(current)
-		
-		# If the edge crosses the line, add the intersection point
-		if current_side != next_side and current_side != 0 and next_side != 0:
-			var intersection = line_intersection(current, next, line_start, line_end)
-			if intersection != null:
-				result.append(intersection)
-	
-	return result
-
-# Helper function to find intersection of two line segments
-func line_intersection(a: Vector2, b: Vector2, c: Vector2, d: Vector2):
-	var denominator = (b.x - a.x) * (d.y - c.y) - (b.y - a.y) * (d.x - c.x)
-	
-	if denominator == 0:
-		return null  # Lines are parallel
-	
-	var t = ((c.x - a.x) * (d.y - c.y) - (c.y - a.y) * (d.x - c.x)) / denominator
-	
-	return Vector2(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y))
-
-# Helper function to clip a polygon against a rectangle
-func clip_polygon_with_rect(vertices: Array, rect: Rect2) -> Array:
-	# Clip against each edge of the rectangle
-	var result = vertices
-	
-	# Left edge
-	result = clip_polygon_with_line(result, Vector2(rect.position.x, rect.position.y), 
-									Vector2(rect.position.x, rect.position.y + rect.size.y),
-									Vector2(rect.position.x + 1, rect.position.y), 
-									Vector2(rect.position.x - 1, rect.position.y))
-	
-	# Right edge
-	result = clip_polygon_with_line(result, Vector2(rect.position.x + rect.size.x, rect.position.y), 
-									Vector2(rect.position.x + rect.size.x, rect.position.y + rect.size.y),
-									Vector2(rect.position.x + rect.size.x - 1, rect.position.y), 
-									Vector2(rect.position.x + rect.size.x + 1, rect.position.y))
-	
-	# Top edge
-	result = clip_polygon_with_line(result, Vector2(rect.position.x, rect.position.y), 
-									Vector2(rect.position.x + rect.size.x, rect.position.y),
-									Vector2(rect.position.x, rect.position.y + 1), 
-									Vector2(rect.position.x, rect.position.y - 1))
-	
-	# Bottom edge
-	result = clip_polygon_with_line(result, Vector2(rect.position.x, rect.position.y + rect.size.y), 
-									Vector2(rect.position.x + rect.size.x, rect.position.y + rect.size.y),
-									Vector2(rect.position.x, rect.position.y + rect.size.y - 1), 
-									Vector2(rect.position.x, rect.position.y + rect.size.y + 1))
-	
-	return result
+		voronoi_cells[seed_points[i]] = cell_vertices
+		var neighbours: Array = []
+		for k: int in range(adjacency_offsets[i], adjacency_offsets[i + 1]):
+			neighbours.append(seed_points[adjacency[k]])
+		cell_adjacency[seed_points[i]] = neighbours
+	return voronoi_cells
 
 func assign_terrain_type() -> String:	
 	#return "plains" 
@@ -456,34 +295,37 @@ func assign_terrain_type() -> String:
 
 
 func calculate_adjacent_original_walkable_area(original_walkable_areas: Array[Area]) -> Dictionary[Area, Array]:
-	var adjacency:  Dictionary[Area, Array] = {}
-	
-	# Cache bounding boxes for quick checks
-	var bounding_boxes = {}
-	for original_area in original_walkable_areas:
-		bounding_boxes[original_area] = GeometryUtils.calculate_bounding_box(original_area.polygon)
-	
-	# Build adjacency list
-	for i in range(original_walkable_areas.size()):
-		var original_area_a = original_walkable_areas[i]
-		
-		if not adjacency.has(original_area_a):
-			adjacency[original_area_a] = []
-		
-		for j in range(i + 1, original_walkable_areas.size()):
-			var original_area_b = original_walkable_areas[j]
-			
-			# Quick bounding box check first
-			if GeometryUtils.are_bounding_boxes_overlapping(bounding_boxes[original_area_a], bounding_boxes[original_area_b]):
-				# Check if polygons are adjacent
-				if GeometryUtils.are_polygons_adjacent(original_area_a.polygon, original_area_b.polygon):
-					if not adjacency.has(original_area_b):
-						adjacency[original_area_b] = []
-					
-					# Mark them as adjacent to each other
-					adjacency[original_area_a].append(original_area_b)
-					adjacency[original_area_b].append(original_area_a)
-	
+	var graph: Array = PolygonTopology.adjacency_graph(_area_polygons(original_walkable_areas), ADJACENCY_SNAP)
+	return _adjacency_among(original_walkable_areas, graph, original_walkable_areas)
+
+
+func _area_polygons(areas: Array[Area]) -> Array[PackedVector2Array]:
+	var polygons: Array[PackedVector2Array] = []
+	for area: Area in areas:
+		polygons.append(area.polygon)
+	return polygons
+
+
+# Adjacency restricted to members, read off a PolygonTopology.adjacency_graph
+# built over areas (a superset of members). Neighbour lists keep the order of
+# areas.
+func _adjacency_among(areas: Array[Area], graph: Array, members: Array[Area]) -> Dictionary[Area, Array]:
+	var is_member: Dictionary[Area, bool] = {}
+	for area: Area in members:
+		is_member[area] = true
+	var offsets: PackedInt32Array = graph[0]
+	var neighbours: PackedInt32Array = graph[1]
+	var adjacency: Dictionary[Area, Array] = {}
+	for i: int in range(areas.size()):
+		var area: Area = areas[i]
+		if not is_member.has(area) or adjacency.has(area):
+			continue
+		var adjacent: Array = []
+		for k: int in range(offsets[i], offsets[i + 1]):
+			var other: Area = areas[neighbours[k]]
+			if is_member.has(other) and other != area and not adjacent.has(other):
+				adjacent.append(other)
+		adjacency[area] = adjacent
 	return adjacency
 
 
@@ -594,74 +436,36 @@ func setup_area_spatial_grid(
 
 # Return the ordered poly-line of every edge that polygon_a and polygon_b share.
 static func _get_shared_border_between_polygons(poly_a: PackedVector2Array, poly_b: PackedVector2Array) -> PackedVector2Array:
-	var shared: Array = []
-	for i in range(poly_a.size()):
-		var a0 = poly_a[i]
-		var a1 = poly_a[(i+1)%poly_a.size()]
-		for j in range(poly_b.size()):
-			var b0 = poly_b[j]
-			var b1 = poly_b[(j+1)%poly_b.size()]
-			if (a0 == b1 and a1 == b0) or (a0 == b0 and a1 == b1):
-				shared.append([a0, a1])
-	if shared.size() == 0:
-		return PackedVector2Array()
-	# Now chain together all shared edges into a polyline
-	var border = [shared[0][0], shared[0][1]]
-	shared.remove_at(0)
-	while shared.size() > 0:
-		var extended = false
-		for k in range(shared.size()):
-			var e0 = shared[k][0]
-			var e1 = shared[k][1]
-			if border[border.size()-1] == e0:
-				border.append(e1)
-				shared.remove_at(k)
-				extended = true
-				break
-			elif border[border.size()-1] == e1:
-				border.append(e0)
-				shared.remove_at(k)
-				extended = true
-				break
-			elif border[0] == e0:
-				border.insert(0, e1)
-				shared.remove_at(k)
-				extended = true
-				break
-			elif border[0] == e1:
-				border.insert(0, e0)
-				shared.remove_at(k)
-				extended = true
-				break
-		if not extended:
-			break
-	return PackedVector2Array(border)
+	# Shared edges hashed natively; the first chain, in the direction of poly_a
+	return PolygonTopology.shared_border(poly_a, poly_b)
 
 
 func calculate_shared_borders(
 	original_walkable_areas: Array[Area]
 ) -> Dictionary[Area, Dictionary]:
 	var shared: Dictionary[Area, Dictionary] = {}
-
-	for i: int in range(original_walkable_areas.size()):
-		var area_a: Area = original_walkable_areas[i]
-		if not shared.has(area_a):
-			shared[area_a] = {}
-		
-		for j: int in range(i + 1, original_walkable_areas.size()):
-			var area_b: Area = original_walkable_areas[j]
-
-			# Only proceed if the polygons actually touch.
-			if GeometryUtils.are_polygons_adjacent(area_a.polygon, area_b.polygon):
-				var border: PackedVector2Array = _get_shared_border_between_polygons(
-					area_a.polygon,
-					area_b.polygon
-				)
-				if border.size() >= 2:
-					shared[area_a][area_b] = [border]
-					if not shared.has(area_b):
-						shared[area_b] = {}
-					shared[area_b][area_a] = [PackedVector2Array(border)]
+	var polygons: Array[PackedVector2Array] = []
+	for area: Area in original_walkable_areas:
+		shared[area] = {}
+		polygons.append(area.polygon)
+
+	# All adjacent pairs in one pass: [first, second, points, border_offsets, border_pairs]
+	var borders: Array = PolygonTopology.shared_borders(polygons)
+	var first: PackedInt32Array = borders[0]
+	var second: PackedInt32Array = borders[1]
+	var points: PackedVector2Array = borders[2]
+	var border_offsets: PackedInt32Array = borders[3]
+	var border_pairs: PackedInt32Array = borders[4]
+	for b: int in border_pairs.size():
+		var pair: int = border_pairs[b]
+		var area_a: Area = original_walkable_areas[first[pair]]
+		var area_b: Area = original_walkable_areas[second[pair]]
+		# Like _get_shared_border_between_polygons, only the first chain of a pair
+		if shared[area_a].has(area_b):
+			continue
+		var border: PackedVector2Array = points.slice(border_offsets[b], border_offsets[b + 1])
+		shared[area_a][area_b] = [border]
+		shared[area_b][area_a] = [PackedVector2Array(border)]
 	return shared
 
 func _point_is_in_list(p: Vector2, list: Array[Vector2]) -> bool:
@@ -1599,9 +1403,14 @@ func update_map(
 		map.original_obstacles_index_by_polygon_id[obstacle.polygon_id] = ind
 		
 
-	map.adjacent_original_walkable_area = calculate_adjacent_original_walkable_area(map.original_walkable_areas)
-	map.adjacent_original_walkable_area_and_obstacles = calculate_adjacent_original_walkable_area(map.original_walkable_areas+map.original_obstacles)
-	map.adjacent_original_walkable_area_and_unmerged_obstacles = calculate_adjacent_original_walkable_area(map.original_walkable_areas+map.original_unmerged_obstacles)
+	# One graph over every original polygon serves all three adjacencies
+	var walkables_and_obstacles: Array[Area] = map.original_walkable_areas + map.original_obstacles
+	var walkables_and_unmerged_obstacles: Array[Area] = map.original_walkable_areas + map.original_unmerged_obstacles
+	var adjacency_areas: Array[Area] = walkables_and_obstacles + map.original_unmerged_obstacles
+	var adjacency_graph: Array = PolygonTopology.adjacency_graph(_area_polygons(adjacency_areas), ADJACENCY_SNAP)
+	map.adjacent_original_walkable_area = _adjacency_among(adjacency_areas, adjacency_graph, map.original_walkable_areas)
+	map.adjacent_original_walkable_area_and_obstacles = _adjacency_among(adjacency_areas, adjacency_graph, walkables_and_obstacles)
+	map.adjacent_original_walkable_area_and_unmerged_obstacles = _adjacency_among(adjacency_areas, adjacency_graph, walkables_and_unmerged_obstacles)
 	map.original_walkable_area_bounds = calculate_adjacent_original_walkable_area_bounds(map.original_walkable_areas)
 	map.original_walkable_area_and_obstacles_bounds = calculate_adjacent_original_walkable_area_bounds(map.original_walkable_areas+map.original_obstacles)
 	
@@ -1711,30 +1520,11 @@ func create_map_from_seed_points(
 	world_boundary.reverse()
 	areas.append(Area.new(Global.obstacle_color, world_boundary, -3))
 
-	var voronoi_cells: Dictionary[Vector2, PackedVector2Array] = generate_voronoi_cells(seed_points)
-	for center_point: Vector2 in voronoi_cells.keys():
-		var cell: PackedVector2Array = voronoi_cells[center_point]
-		if cell.size() >= 3:
-			var integer_cell: PackedVector2Array = PackedVector2Array()
-			for p: Vector2 in cell:
-				integer_cell.append(_safe_round(p))
-			voronoi_cells[center_point] = integer_cell
+	var cell_adjacency: Dictionary = {}
+	var voronoi_cells: Dictionary[Vector2, PackedVector2Array] = generate_voronoi_cells(seed_points, true, cell_adjacency)
 
 	if add_waves == true:
 		var cell_centers: Array = voronoi_cells.keys()
-		var cell_adjacency: Dictionary = {}
-		for i: int in range(cell_centers.size()):
-			var a: Vector2 = cell_centers[i]
-			cell_adjacency[a] = []
-		for i2: int in range(cell_centers.size()):
-			var ca: Vector2 = cell_centers[i2]
-			var poly_a: PackedVector2Array = voronoi_cells[ca]
-			for j: int in range(i2 + 1, cell_centers.size()):
-				var cb: Vector2 = cell_centers[j]
-				var poly_b: PackedVector2Array = voronoi_cells[cb]
-				if GeometryUtils.are_polygons_adjacent(poly_a, poly_b):
-					(cell_adjacency[ca] as Array).append(cb)
-					(cell_adjacency[cb] as Array).append(ca)
 		var processed_pairs: Dictionary[String, bool] = {}
 		for i3: int in range(cell_centers.size()):
 			var a2: Vector2 = cell_centers[i3]
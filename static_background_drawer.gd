@@ -37,7 +37,6 @@ const MTN_TEX_SUBPIXEL_OFFSET: float = 0.5
 # Mountain ridges configuration
 const RIDGE_LEVELS: int = 2
 const RIDGE_LEVEL_WIDTH_FACTOR: float = 2.0
-const RIDGE_NORMAL_STRENGTH: float = 1.0
 const RIDGE_DISTANCE_STRENGTH: float = 0.05
 const RIDGE_EPS: float = 0.0001
 const RIDGE_TRACE_STEP_PX: float = 16.0
@@ -50,7 +49,6 @@ const RIDGE_SECOND_NOISE_FREQ: float = 1.0 / 140.0
 const RIDGE_SECOND_MAX_STEPS: int = 16
 const RIDGE_SECOND_BIAS: float = 0.35
 const RIDGE_MAIN_DISTANCE_BIAS: float = 2.0
-const RIDGE_MAIN_NORMAL_DOMINANCE: float = 0.5
 
 const LIGHT_Z: float = 0.90					# z component of the light dir (0..1)
 const BASE_SLOPE_DEG: float = 0.0			# outward tilt near polygon edge
@@ -109,6 +107,7 @@ var _tree_canopy_instances: Array[Dictionary] = []  # {vertices, color}
 
 # MultiMesh for mountains
 var _mountain_textures: Dictionary = {}  # poly_id -> {"texture": ImageTexture, "aabb": Rect2}
+var _terrain_rasterizer: TerrainRasterizer = TerrainRasterizer.new()
 
 # ─── Plains texture (procedural mottled parchment) ─────────────────────────────
 const PLAINS_TEX_SIZE: int = 2048
@@ -124,6 +123,9 @@ var _world_aabb: Rect2 = Rect2()
 
 var before_rivers: bool = false
 
+func _init() -> void:
+	_terrain_rasterizer.set_parallel(true)
+
 func setup(p_areas: Array[Area], p_map_generator: MapGenerator, p_map: Global.Map) -> void:
 	areas = p_areas
 	map_generator = p_map_generator
@@ -320,54 +322,23 @@ func _compute_world_aabb() -> void:
 	else:
 		_world_aabb = Rect2(Vector2.ZERO, Vector2(1.0, 1.0))
 
-# Shared noise image generator for textured areas (plains/forest)
+# Shared noise image generator for textured areas (plains/forest): the layered
+# simplex/value FBm recipe is evaluated natively, rows split across cores
 func _generate_noise_image(seed1: int, seed2: int, seed3: int) -> Image:
-	var img: Image = Image.create(PLAINS_TEX_SIZE, PLAINS_TEX_SIZE, false, Image.FORMAT_RGBA8)
-	var noise1: FastNoiseLite = FastNoiseLite.new()
-	noise1.seed = seed1
-	noise1.noise_type = FastNoiseLite.TYPE_SIMPLEX
-	noise1.frequency = PLAINS_NOISE_FREQ_1
-	noise1.fractal_type = FastNoiseLite.FRACTAL_FBM
-	noise1.fractal_octaves = 4
-	var noise2: FastNoiseLite = FastNoiseLite.new()
-	noise2.seed = seed2
-	noise2.noise_type = FastNoiseLite.TYPE_SIMPLEX
-	noise2.frequency = PLAINS_NOISE_FREQ_2
-	noise2.fractal_type = FastNoiseLite.FRACTAL_FBM
-	noise2.fractal_octaves = 3
-	var noise3: FastNoiseLite = FastNoiseLite.new()
-	noise3.seed = seed3
-	noise3.noise_type = FastNoiseLite.TYPE_VALUE
-	noise3.frequency = PLAINS_NOISE_FREQ_3
-	var warp_freq: float = 1.0 / 1600.0
-	var warp_amp: float = 0.0
-	for y: int in range(PLAINS_TEX_SIZE):
-		for x: int in range(PLAINS_TEX_SIZE):
-			var fx: float = float(x)
-			var fy: float = float(y)
-			var wx: float = fx + noise3.get_noise_2d(fx * warp_freq, fy * warp_freq) * warp_amp
-			var wy: float = fy + noise2.get_noise_2d(fx * warp_freq * 1.13, fy * warp_freq * 0.91) * warp_amp
-			var n1: float = noise1.get_noise_2d(wx, wy)
-			var n2: float = noise2.get_noise_2d(wx * 1.87, wy * 1.63)
-			var n3: float = noise3.get_noise_2d(wx * 2.11, wy * 2.39)
-			var v: float = 0.25 + 0.5 * n1 + 0.45 * n2 + 0.3 * n3
-			if v < 0.0:
-				v = 0.0
-			else:
-				v = v
-			var centered: float = v - 0.5
-			v = 0.5 + centered * (1.0 + PLAINS_TEX_CONTRAST)
-			var mul: float = 1.0 + (v - 0.5) * 2.0 * PLAINS_TEX_INTENSITY
-			if mul < 0.0:
-				mul = 0.0
-			else:
-				mul = mul
-			if mul > 1.5:
-				mul = 1.5
-			else:
-				mul = mul
-			img.set_pixel(x, y, Color(mul, mul, mul, 1.0))
-	return img
+	var recipe: Dictionary = {}
+	recipe["frequency_1"] = PLAINS_NOISE_FREQ_1
+	recipe["frequency_2"] = PLAINS_NOISE_FREQ_2
+	recipe["frequency_3"] = PLAINS_NOISE_FREQ_3
+	recipe["octaves_1"] = 4
+	recipe["octaves_2"] = 3
+	recipe["octaves_3"] = 5	# FastNoiseLite default fractal (FBm, 5 octaves)
+	recipe["warp_frequency"] = 1.0 / 1600.0
+	recipe["warp_amplitude"] = 0.0
+	recipe["contrast"] = PLAINS_TEX_CONTRAST
+	recipe["intensity"] = PLAINS_TEX_INTENSITY
+	var seeds: PackedInt32Array = PackedInt32Array([seed1, seed2, seed3])
+	var pixels: PackedByteArray = _terrain_rasterizer.generate_noise(PLAINS_TEX_SIZE, seeds, recipe)
+	return Image.create_from_data(PLAINS_TEX_SIZE, PLAINS_TEX_SIZE, false, Image.FORMAT_RGBA8, pixels)
 
 func _generate_plains_image() -> Image:
 	var img: Image = _generate_noise_image(1337, 7331, 9119)
@@ -447,18 +418,6 @@ func _draw_mountain_black_bases() -> void:
 			draw_colored_polygon(original_area.polygon, black)
 
 # ──────────────────────────── Helpers ─────────────────────────────────────
-func _composite_over_color(src: Color, dst: Color) -> Color:
-	var a: float = src.a
-	if a < 0.0:
-		a = 0.0
-	else:
-		if a > 1.0:
-			a = 1.0
-	var out_r: float = src.r * a + dst.r * (1.0 - a)
-	var out_g: float = src.g * a + dst.g * (1.0 - a)
-	var out_b: float = src.b * a + dst.b * (1.0 - a)
-	return Color(out_r, out_g, out_b, 1.0)
-
 static func build_between_band_quads(poly_a: PackedVector2Array, poly_b: PackedVector2Array) -> Array[PackedVector2Array]:
 	var out: Array[PackedVector2Array] = []
 	if poly_a.size() < 2:
@@ -793,7 +752,6 @@ func _build_mountain_texture_entry(poly_id: int, polygon: PackedVector2Array) ->
 	var aabb_padded: Rect2 = Rect2(padded_pos, padded_size)
 	var tex_w: int = int(ceil(max(1.0, aabb_padded.size.x)))
 	var tex_h: int = int(ceil(max(1.0, aabb_padded.size.y)))
-	var img: Image = Image.create(tex_w, tex_h, false, Image.FORMAT_RGBA8)
 	var centroid: Vector2 = GeometryUtils.calculate_centroid(polygon)
 	var t_ridge0: int = 0
 	var t_ridge_ms: int = 0
@@ -802,81 +760,29 @@ func _build_mountain_texture_entry(poly_id: int, polygon: PackedVector2Array) ->
 	var ridges: Array[Dictionary] = _build_ridges_for_polygon(polygon)
 	if PROFILE_MTN:
 		t_ridge_ms = Time.get_ticks_msec() - t_ridge0
+	var ridge_points: PackedVector2Array = PackedVector2Array()
+	var ridge_levels: PackedInt32Array = PackedInt32Array()
+	for ridge: Dictionary in ridges:
+		ridge_points.append(ridge["a"])
+		ridge_points.append(ridge["b"])
+		ridge_levels.append(ridge["level"])
 	var base: Color = Global.get_color_for_terrain("mountains")
 	var base_hsv: Vector3 = Vector3(base.h, base.s, base.v)
 	var base_col: Color = Color.from_hsv(base_hsv.x, base_hsv.y, base_hsv.z, base.a)
-	var distances: PackedFloat32Array = PackedFloat32Array()
-	distances.resize(tex_w * tex_h)
-	var max_edge_dist: float = 0.0
-	var tested_pixels: int = 0
-	var inside_pixels: int = 0
-	var edge_tests: int = 0
-	var t_pass1_0: int = 0
-	var t_pass1_ms: int = 0
-	var t_pp_ms: int = 0
-	var t_edge_ms: int = 0
-	# Pass 1: compute edge distances and max
-	var y1: int = 0
-	while y1 < tex_h:
-		var x1: int = 0
-		while x1 < tex_w:
-			if PROFILE_MTN:
-				if y1 == 0 and x1 == 0:
-					t_pass1_0 = Time.get_ticks_msec()
-			var world_p: Vector2 = Vector2(aabb_padded.position.x + float(x1) + MTN_TEX_SUBPIXEL_OFFSET, aabb_padded.position.y + float(y1) + MTN_TEX_SUBPIXEL_OFFSET)
-			var t_pp0: int = 0
-			if PROFILE_MTN:
-				t_pp0 = Time.get_ticks_msec()
-			var inside: bool = Geometry2D.is_point_in_polygon(world_p, polygon)
-			if PROFILE_MTN:
-				t_pp_ms += Time.get_ticks_msec() - t_pp0
-			var idx: int = y1 * tex_w + x1
-			if inside:
-				var t_e0: int = 0
-				if PROFILE_MTN:
-					t_e0 = Time.get_ticks_msec()
-				var d: float = _nearest_edge_distance(world_p, polygon)
-				if PROFILE_MTN:
-					t_edge_ms += Time.get_ticks_msec() - t_e0
-				edge_tests += 1
-				distances[idx] = d
-				if d > max_edge_dist:
-					max_edge_dist = d
-				inside_pixels += 1
-			else:
-				distances[idx] = -1.0
-			tested_pixels += 1
-			x1 += 1
-		y1 += 1
+	# Scanline fill, distance transform and ridge shading run natively over all cores
+	var t_raster0: int = 0
+	var t_raster_ms: int = 0
 	if PROFILE_MTN:
-		t_pass1_ms = Time.get_ticks_msec() - t_pass1_0
-	# Pass 2: shade pixels
-	var y2: int = 0
-	var t_pass2_0: int = 0
-	var t_pass2_ms: int = 0
-	var t_ridge_lookup_ms: int = 0
-	if PROFILE_MTN:
-		t_pass2_0 = Time.get_ticks_msec()
-	while y2 < tex_h:
-		var x2: int = 0
-		while x2 < tex_w:
-			var idx2: int = y2 * tex_w + x2
-			var d2: float = distances[idx2]
-			if d2 >= 0.0:
-				var world_p2: Vector2 = Vector2(aabb_padded.position.x + float(x2) + MTN_TEX_SUBPIXEL_OFFSET, aabb_padded.position.y + float(y2) + MTN_TEX_SUBPIXEL_OFFSET)
-				var t_r0: int = 0
-				if PROFILE_MTN:
-					t_r0 = Time.get_ticks_msec()
-				var col: Color = _compute_mountain_pixel_color(world_p2, centroid, base_col, ridges, d2, max_edge_dist)
-				if PROFILE_MTN:
-					t_ridge_lookup_ms += Time.get_ticks_msec() - t_r0
-				img.set_pixel(x2, y2, col)
-			else:
-				img.set_pixel(x2, y2, Color(0.0, 0.0, 0.0, 0.0))
-			x2 += 1
-		y2 += 1
+		t_raster0 = Time.get_ticks_msec()
+	var pixels: PackedByteArray = _terrain_rasterizer.rasterize_mountain(
+		polygon, aabb_padded.position, tex_w, tex_h, centroid,
+		ridge_points, ridge_levels, _mountain_shading(base_col), _rng.randi()
+	)
 	if PROFILE_MTN:
-		t_pass2_ms = Time.get_ticks_msec() - t_pass2_0
+		t_raster_ms = Time.get_ticks_msec() - t_raster0
+	if pixels.size() != tex_w * tex_h * 4:
+		return result
+	var img: Image = Image.create_from_data(tex_w, tex_h, false, Image.FORMAT_RGBA8, pixels)
 	var tex: ImageTexture = ImageTexture.create_from_image(img)
 	result["texture"] = tex
 	result["aabb"] = aabb_padded
@@ -884,90 +790,36 @@ func _build_mountain_texture_entry(poly_id: int, polygon: PackedVector2Array) ->
 		var t_total_ms: int = Time.get_ticks_msec() - t_total0
 		print("[MTN/TEX] poly_id=", poly_id,
 			" tex=", tex_w, "x", tex_h,
-			" tested=", tested_pixels,
-			" inside=", inside_pixels,
+			" ridges=", ridge_levels.size(),
 			" ridge_ms=", t_ridge_ms,
-			" pass1_ms=", t_pass1_ms, " (pp_ms=", t_pp_ms, ", edge_ms=", t_edge_ms, ", edge_tests=", edge_tests, ")",
-			" pass2_ms=", t_pass2_ms, " (ridge_ms=", t_ridge_lookup_ms, ")",
+			" raster_ms=", t_raster_ms,
 			" total_ms=", t_total_ms)
 	return result
 
 
-func _compute_mountain_pixel_color(p: Vector2, centroid: Vector2, base_col: Color, ridges: Array[Dictionary], edge_dist: float, max_edge_dist: float) -> Color:
-	var dir_vec: Vector2 = (p - centroid)
-	var n: Vector2
-	if dir_vec.length() == 0.0:
-		n = Vector2(0.0, -1.0)
-	else:
-		n = dir_vec.normalized()
-	var yaw: float = deg_to_rad(_rng.randf_range(-MTN_JITTER_DEG, MTN_JITTER_DEG))
-	var n_rot: Vector2 = Vector2(
-		n.x * cos(yaw) - n.y * sin(yaw),
-		n.x * sin(yaw) + n.y * cos(yaw)
-	)
-	var d_l: float = n_rot.dot(-Global.LIGHT_DIR)
-	if d_l < -1.0:
-		d_l = -1.0
-	else:
-		if d_l > 1.0:
-			d_l = 1.0
-	var f_light: float = MTN_BRIGHT_MIN + (MTN_BRIGHT_MAX - MTN_BRIGHT_MIN) * (d_l + 1.0) * 0.5
-	var ridge_pair: Dictionary = _ridge_multipliers_at(p, ridges)
-	var ridge_dist_mul: float = float(ridge_pair["distance"])
-	#var ridge_norm_mul: float = float(ridge_pair["normal"])
-	
-	var N: Vector3 = _compute_normal3d_for_pixel(p, centroid, ridges, edge_dist, max_edge_dist)
-
-	var L: Vector3 = Vector3(-Global.LIGHT_DIR.x, -Global.LIGHT_DIR.y, LIGHT_Z)
-	L = L.normalized()
-
-	var lambert: float = N.dot(L)
-	if lambert < 0.0:
-		lambert = 0.0
-	else:
-		lambert = lambert
-	var ridge_norm_mul: float = (lambert*0.5+lambert*lambert*0.5)
-	
-	var t_norm: float = 0.0
-	if max_edge_dist > 0.0:
-		t_norm = edge_dist / max_edge_dist
-	else:
-		t_norm = 0.0
-	var eased: float = pow(t_norm, 1.0 / 2.0)
-	eased = min(eased, 0.75)
-	var col: Color = base_col * (0.75 * ridge_norm_mul + 0.75 * f_light)
-	col = _composite_over_color(col, Global.background_color)
-	var prox_mul: float = 0.5 + eased * 0.5 + min(1.0, 2.0 * pow(eased, 2.0) * pow(1.0 - ridge_dist_mul, 3.0))
-	if prox_mul > 1.0:
-		prox_mul = 1.0
-	else:
-		prox_mul = prox_mul
-	col = col * prox_mul
-	col.a = 1.0
-	return col
-
-#func _compute_mountain_pixel_color(
-		#p: Vector2, centroid: Vector2, base_col: Color,
-		#ridges: Array[Dictionary], edge_dist: float, max_edge_dist: float
-	#) -> Color:
-	#var N: Vector3 = _compute_normal3d_for_pixel(p, centroid, ridges, edge_dist, max_edge_dist)
-#
-	#var L: Vector3 = Vector3(-Global.LIGHT_DIR.x, -Global.LIGHT_DIR.y, LIGHT_Z)
-	#L = L.normalized()
-#
-	#var lambert: float = N.dot(L)
-	#if lambert < 0.0:
-		#lambert = 0.0
-	#else:
-		#lambert = lambert
-#
-	## Soft half-Lambert for nicer rolloff
-	#var f_light: float = 0.5 * lambert + 0.5 * lambert * lambert
-#
-	#var col: Color = base_col * (0.60 + 0.80 * f_light)
-	#col = _composite_over_color(col, Global.background_color)
-	#col.a = 1.0
-	#return col
+# Shading recipe for TerrainRasterizer.rasterize_mountain
+func _mountain_shading(base_col: Color) -> Dictionary:
+	var shading: Dictionary = {}
+	shading["base_color"] = base_col
+	shading["background_color"] = Global.background_color
+	shading["light_dir"] = Global.LIGHT_DIR
+	shading["light_z"] = LIGHT_Z
+	shading["bright_min"] = MTN_BRIGHT_MIN
+	shading["bright_max"] = MTN_BRIGHT_MAX
+	shading["jitter_deg"] = MTN_JITTER_DEG
+	shading["base_slope_deg"] = BASE_SLOPE_DEG
+	shading["base_edge_exp"] = BASE_EDGE_EXP
+	shading["ridge_slope_deg"] = RIDGE_SLOPE_DEG
+	shading["ridge_width_l1"] = RIDGE_WIDTH_L1
+	shading["ridge_width_l2"] = RIDGE_WIDTH_L2
+	shading["ridge_sharpness_pow"] = RIDGE_SHARPNESS_POW
+	shading["min_width_px"] = MIN_WIDTH_PX
+	shading["ridge_level_width_factor"] = RIDGE_LEVEL_WIDTH_FACTOR
+	shading["ridge_distance_strength"] = RIDGE_DISTANCE_STRENGTH
+	shading["ridge_eps"] = RIDGE_EPS
+	shading["ridge_secondary_distance_bias"] = RIDGE_MAIN_DISTANCE_BIAS
+	shading["subpixel_offset"] = MTN_TEX_SUBPIXEL_OFFSET
+	return shading
 
 
 func _draw_textured_polygon_with_aabb(polygon: PackedVector2Array, texture: Texture2D, aabb: Rect2) -> void:
@@ -1518,203 +1370,6 @@ func _closest_point_on_polyline(p: Vector2, poly: PackedVector2Array) -> Vector2
 	return best
 
 
-func _nearest_edge_distance(p: Vector2, poly: PackedVector2Array) -> float:
-	var best: float = INF
-	var e: int = 0
-	while e < poly.size():
-		var a: Vector2 = poly[e]
-		var b: Vector2 = poly[(e + 1) % poly.size()]
-		var proj: Vector2 = Geometry2D.get_closest_point_to_segment(p, a, b)
-		var d: float = p.distance_to(proj)
-		if d < best:
-			best = d
-		else:
-			best = best
-		e += 1
-	return best
-
-func _smooth01(x: float) -> float:
-	var v: float = x
-	if v < 0.0:
-		v = 0.0
-	else:
-		if v > 1.0:
-			v = 1.0
-	return v
-
-func _ridge_influence_width_for_level(level: int) -> float:
-	if level <= 1:
-		return RIDGE_WIDTH_L1
-	else:
-		return RIDGE_WIDTH_L2
-
-func _ridge_multipliers_at(p: Vector2, segments: Array[Dictionary]) -> Dictionary:
-	var result: Dictionary = {}
-	result["distance"] = 1.0
-	result["normal"] = 1.0
-	result["level"] = 0
-	if segments.size() <= 0:
-		return result
-	var best_idx: int = -1
-	var best_d_eff: float = INF
-	var best_proj: Vector2 = Vector2.ZERO
-	var main_best: float = INF
-	var main_proj: Vector2 = Vector2.ZERO
-	var main_a: Vector2 = Vector2.ZERO
-	var main_b: Vector2 = Vector2.ZERO
-	var i: int = 0
-	while i < segments.size():
-		var seg: Dictionary = segments[i]
-		var a: Vector2 = seg["a"]
-		var b: Vector2 = seg["b"]
-		var lvl: int = seg["level"]
-		var proj: Vector2 = Geometry2D.get_closest_point_to_segment(p, a, b)
-		var d: float = p.distance_to(proj)
-		var d_eff: float = d
-		if lvl > 1:
-			d_eff = d * RIDGE_MAIN_DISTANCE_BIAS
-		else:
-			d_eff = d_eff
-		if d_eff < best_d_eff:
-			best_d_eff = d_eff
-			best_idx = i
-			best_proj = proj
-		else:
-			best_d_eff = best_d_eff
-		if lvl == 1:
-			var q: Vector2 = proj
-			var dmain: float = p.distance_to(q)
-			if dmain < main_best:
-				main_best = dmain
-				main_proj = q
-				main_a = a
-				main_b = b
-		else:
-			main_best = main_best
-		i += 1
-	assert(best_idx >= 0)
-	var chosen: Dictionary = segments[best_idx]
-	var a2: Vector2 = chosen["a"]
-	var b2: Vector2 = chosen["b"]
-	var level: int = chosen["level"]
-	var seg_vec: Vector2 = b2 - a2
-	if seg_vec.length() <= 0.0:
-		return result
-	var t_n: Vector2 = seg_vec.normalized()
-	var n_vec: Vector2 = Vector2(-t_n.y, t_n.x)
-	var yaw: float = deg_to_rad(_rng.randf_range(-MTN_JITTER_DEG, MTN_JITTER_DEG))
-	n_vec = Vector2(
-		n_vec.x * cos(yaw) - n_vec.y * sin(yaw),
-		n_vec.x * sin(yaw) + n_vec.y * cos(yaw)
-	)
-	var rel: Vector2 = p - best_proj
-	var side_dot: float = rel.dot(n_vec)
-	var side: float = 0.0
-	if side_dot >= 0.0:
-		side = 1.0
-	else:
-		side = -1.0
-	var light: float = n_vec.dot(-Global.LIGHT_DIR)
-	if light < -1.0:
-		light = -1.0
-	else:
-		if light > 1.0:
-			light = 1.0
-	result["distance"] = _ridge_factor_distance_from(best_d_eff, level)
-	var normal_chosen: float = _ridge_factor_normal_from(light, side)
-	var normal_main: float = normal_chosen
-	if main_a != main_b:
-		var m_vec: Vector2 = (main_b - main_a)
-		if m_vec.length() > 0.0:
-			var m_n: Vector2 = m_vec.normalized()
-			var m_perp: Vector2 = Vector2(-m_n.y, m_n.x)
-			var yaw2: float = deg_to_rad(_rng.randf_range(-MTN_JITTER_DEG, MTN_JITTER_DEG))
-			var m_light_n: Vector2 = Vector2(
-				m_perp.x * cos(yaw2) - m_perp.y * sin(yaw2),
-				m_perp.x * sin(yaw2) + m_perp.y * cos(yaw2)
-			)
-			var rel2: Vector2 = p - main_proj
-			var side2: float
-			if rel2.dot(m_perp) >= 0.0:
-				side2 = 1.0
-			else:
-				side2 = -1.0
-			var light2: float = m_light_n.dot(-Global.LIGHT_DIR)
-			if light2 < -1.0:
-				light2 = -1.0
-			else:
-				if light2 > 1.0:
-					light2 = 1.0
-			normal_main = _ridge_factor_normal_from(light2, side2)
-	var dom_w: float = 0.0
-	if level > 1:
-		dom_w = RIDGE_MAIN_NORMAL_DOMINANCE
-		if main_best < INF and best_d_eff > 0.0:
-			var ratio: float = clamp(main_best / pow(best_d_eff, 2.0), 0.0, 1.0)
-			dom_w = clamp(dom_w * (1.0 - ratio), 0.0, 1.0)
-	var normal_blend: float = normal_chosen * (1.0 - dom_w) + normal_main * dom_w
-	result["normal"] = normal_blend
-	result["level"] = level
-	
-	# Extra outputs used for distance-driven normals
-	var n2: Vector2 = n_vec.normalized()
-	result["n2"] = n2
-	result["proj"] = best_proj
-
-	var signed_d: float = p.distance_to(best_proj)
-	if side < 0.0:
-		signed_d = -signed_d
-	else:
-		signed_d = signed_d
-	result["signed_d"] = signed_d
-	return result
-
-func _compute_normal3d_for_pixel(
-		p: Vector2,
-		centroid: Vector2,
-		ridges: Array[Dictionary],
-		edge_dist: float,
-		max_edge_dist: float
-	) -> Vector3:
-	var nx: float = 0.0
-	var ny: float = 0.0
-
-	# --- Base mound: outward tilt grows toward the border; keeps far field flat-ish ---
-	if max_edge_dist > 0.0:
-		var t_edge: float = 1.0 - _smooth01(edge_dist / max_edge_dist)	# 0 center → 1 edge
-		var m_base: float = tan(deg_to_rad(BASE_SLOPE_DEG)) * pow(t_edge, BASE_EDGE_EXP)
-		var out_dir: Vector2 = (p - centroid)
-		if out_dir.length() > 0.0:
-			out_dir = out_dir.normalized()
-			nx += m_base * out_dir.x
-			ny += m_base * out_dir.y
-
-	# --- Ridge crest: strongest tilt on the crest, decays with |distance to crest| ---
-	var info: Dictionary = _ridge_multipliers_at(p, ridges)
-	var n2: Vector2 = info["n2"]						# 2D perp to the chosen ridge
-	var s: float = info["signed_d"]						# signed cross-ridge distance (px)
-	var lvl: int = int(info["level"])
-	var width_px: float = _ridge_influence_width_for_level(lvl)
-
-	if width_px < MIN_WIDTH_PX:
-		width_px = MIN_WIDTH_PX
-
-	var u: float = _smooth01(abs(s) / width_px)			# 0 at crest → 1 at influence edge
-	var m_ridge: float = tan(deg_to_rad(RIDGE_SLOPE_DEG)) * pow(1.0 - u, RIDGE_SHARPNESS_POW)
-
-	var sign_s: float = 1.0
-	if s < 0.0:
-		sign_s = -1.0
-	else:
-		sign_s = 1.0
-
-	nx += m_ridge * sign_s * n2.x
-	ny += m_ridge * sign_s * n2.y
-
-	var N: Vector3 = Vector3(nx, ny, 1.0)
-	N = N.normalized()
-	return N
-
 func _reconstruct_secondary_polylines(ridges: Array[Dictionary]) -> Array[PackedVector2Array]:
 	var out: Array[PackedVector2Array] = []
 	var cur: PackedVector2Array = PackedVector2Array()
@@ -1791,23 +1446,6 @@ func _trace_random_walk_until_hit(
 		out.append(pos)
 	return out
 
-func _ridge_factor_distance_from(best_d: float, level: int) -> float:
-	var width_px: float = 1.0 / (float(level) * RIDGE_LEVEL_WIDTH_FACTOR)
-	if width_px <= 0.0:
-		width_px = RIDGE_EPS
-	var atten: float = (best_d / width_px)
-	if atten < 0.0:
-		atten = 0.0
-	else:
-		atten = atten
-	var factor_distance: float = pow(RIDGE_DISTANCE_STRENGTH * atten, 1/4.0)
-	return clamp(factor_distance, 0.0, 1.0)
-
-func _ridge_factor_normal_from(light: float, side: float) -> float:
-	var factor_normal: float = RIDGE_NORMAL_STRENGTH * ((side * light) + 1.0) * 0.5
-	return clamp(factor_normal, 0.0, 1.0)
-
-
 # ---------- river confluence gap helpers ----------
 func _add_gap_range(
 		bank_gaps: Dictionary,
@@ -23,7 +23,7 @@ const MAX_UNITS:	int		= 100
 const NUMBER_PER_UNIT:	int		= 1000
 const POLYLINE_OFFSET:		float	= unit_size*1.25# * 1.125# * 0.75
 const use_flags: bool = false  # Toggle between NATO symbols and flags
-const HUNGARIAN_MAX_N: int = 24#-1#24
+const AUCTION_MIN_N: int = 256	# larger groups use the auction solver
 
 # ─────────────── NATO symbol tuning ───────────────
 const SYMBOL_TEXTURE_SIZE: int = unit_size
@@ -52,35 +52,54 @@ var _nav_map: RID
 var _region_by_area: Dictionary = {}			# Area → RID (NavigationRegion2D)
 
 var _region_to_navigation_layer: Dictionary[RID, int] = {}
+var _region_version_by_area: Dictionary[Area, int] = {}	# Area → polygon_version of the baked region
+var _navigation_cache: NavigationCache = NavigationCache.new()
+var _navmesh_builder: NavmeshBuilder = NavmeshBuilder.new()	# Keeps each area's triangulation between rebuilds
 
 var _offset_areas: Dictionary[Area, Array] = {}
-var _area_curves: Dictionary = {}
+var _agent_store: AgentStore = AgentStore.new()	# Owns the agents' motion state; _agents[k] is store agent k
+var _store_area_versions: Dictionary[Area, int] = {}	# Area → polygon_version uploaded to the store
+var _groups: Array[Area] = []						# Store group index → original area
+var _group_index: Dictionary[Area, int] = {}		# Original area → store group index
+var _owner_tints: PackedColorArray = PackedColorArray()	# Instance tint per owner id
 
 
 var debug_polylines: Array[PackedVector2Array] = []
 
 # ─────────────── Agent ───────────────
+# Position, velocity, fade, state, slot and holding live in _agent_store
 class Agent:
 	var area:	Area
-	var pos:	Vector2
-	var vel:	Vector2	= Vector2.ZERO
-	var alpha:	float	= 0.0
-	var state:	int		= State.SPAWNING
-	var slot:	Vector2	= Vector2.ZERO
+	var index:	int		= 0					# Row in _agent_store
 	var group:	Area	= null				# NEW: current original_area assignment
 	var prev_group : Area = null
-	var _path:	PackedVector2Array = PackedVector2Array()
-	var holding: bool = false
 	var id:		int		= 0					# Unique identifier for trail tracking
 	
 # ─────────────── State ───────────────
 var _agents:			Array[Agent]	= []
-var _fake_agents:		Array[Agent]	= []  # Fake units for defensive lines
 var _front_by_area:		Dictionary		= {}
+
+# Fake units for defensive lines
+var _fake_positions:	PackedVector2Array	= PackedVector2Array()
+var _fake_owners:		PackedInt32Array	= PackedInt32Array()
+var _fake_holding:		PackedByteArray		= PackedByteArray()
+var _fake_tint:			Color				= ((2*Color.DARK_GRAY+Color.BLUE)/3.0).darkened(0.4)
+
+# Store snapshots read by the slot assignment, and its results, uploaded in
+# one call each at the end of _assign_slots
+var _tick_states:		PackedInt32Array	= PackedInt32Array()
+var _tick_positions:	PackedVector2Array	= PackedVector2Array()
+var _regrouped_indices:	PackedInt32Array	= PackedInt32Array()
+var _regrouped_groups:	PackedInt32Array	= PackedInt32Array()
+var _assigned_indices:	PackedInt32Array	= PackedInt32Array()
+var _assigned_slots:	PackedVector2Array	= PackedVector2Array()
+var _assigned_groups:	PackedInt32Array	= PackedInt32Array()
+var _assigned_holding:	PackedByteArray		= PackedByteArray()
 @onready var _trail_manager:		TrailManager = $UnitTrailManager
 
 func _ready() -> void:
 	_nav_map = get_world_2d().get_navigation_map()
+	_agent_store.configure(spawn_fade_time, die_fade_time, unit_alpha, slot_reach_time, min_speed, max_speed)
 	
 	_setup_multimesh()
 	
@@ -350,7 +369,8 @@ func _physics_process(delta: float) -> void:
 	var sim: Node = _sim()
 	if sim == null:
 		_agents = []
-		_fake_agents = []
+		_agent_store.clear()
+		_clear_fake_agents()
 		return
 
 	var obstacle_outlines: Array[PackedVector2Array] = []
@@ -358,6 +378,9 @@ func _physics_process(delta: float) -> void:
 		var obstacle_outline: PackedVector2Array = obstacle.polygon.duplicate()
 		obstacle_outline.append(obstacle_outline[0])
 		obstacle_outlines.append(obstacle_outline)
+	if _navigation_cache.set_obstacles(obstacle_outlines):
+		_region_version_by_area.clear()
+		_navmesh_builder.clear()
 	# Refresh navigation for all areas (including obstacles)
 	for area: Area in sim.areas:
 		if area.owner_id >= 0:
@@ -369,21 +392,8 @@ func _physics_process(delta: float) -> void:
 	_fade_removed_areas(sim)
 	_update_frontlines(sim)
 	_assign_slots()
-	_store_new_area_curves()
 	_integrate_agents(delta)
 
-func _store_new_area_curves() -> void:
-	_area_curves.clear()
-	for ag: Agent in _agents:
-		if not _area_curves.has(ag.area):
-			if ag.area.polygon.size() == 0:
-				continue
-			var curve: Curve2D = Curve2D.new()
-			for pt: Vector2 in ag.area.polygon:
-				curve.add_point(pt)
-			curve.add_point(ag.area.polygon[0])
-			_area_curves[ag.area] = curve
-
 # ─────────────── Drawing ───────────────
 func _draw() -> void:
 	# Update MultiMesh instances instead of individual draw calls
@@ -400,87 +410,54 @@ func _draw() -> void:
 		draw_polyline_colors(debug_polyline, [Color.MAGENTA])
 
 func _update_multimesh_instances() -> void:
-	var friendly_index: int = 0
-	var enemy_index: int = 0
-	
 	if _friendly_multimesh == null: return
-	
-	# Clear all instances first
-	for i in range(MAX_UNITS_DRAW):
-		_friendly_multimesh.set_instance_color(i, Color(1,1,1,0))
-		_enemy_multimesh.set_instance_color(i, Color(1,1,1,0))
-	
-	# Update fake agents
-	for ag: Agent in _fake_agents:
-		assert(ag.alpha == unit_alpha)
-		var fake_color: Color = (2*Color.DARK_GRAY+Color.BLUE)/3.0
-		fake_color = fake_color.darkened(0.4)
-		var indices := _set_multimesh_instance(ag.pos, fake_color, fake_color.a, ag.area.owner_id, ag.holding, friendly_index, enemy_index)
-		friendly_index = indices[0]
-		enemy_index = indices[1]
-	
-	# Update real agents  
-	for ag: Agent in _agents:
-		if ag.alpha > 0.01:
-			var agent_color: Color
-			if use_flags:
-				# For flags, use white tint to preserve original flag colors
-				agent_color = (2*Color.WHITE+Global.get_vehicle_color(ag.area.owner_id))/3.0
-			else:
-				# For NATO symbols, use the vehicle color for tinting
-				agent_color = Global.get_vehicle_color(ag.area.owner_id)
-			
-			# Check if unit's group is in clicked_original_walkable_areas and apply darkening if not
-			var final_color: Color = agent_color
-			var sim: GameSimulationComponent = _sim()
-			if sim != null and ag.group != null:
-				if not sim.clicked_original_walkable_areas.has(ag.group.polygon_id):
-					# Apply black mask overlay similar to polygon layers
-					final_color = final_color.darkened(DrawComponent.DARKEN_UNCLICKED_ALPHA)
-			
-			var indices := _set_multimesh_instance(ag.pos, final_color, ag.alpha, ag.area.owner_id, ag.holding, friendly_index, enemy_index)
-			friendly_index = indices[0]
-			enemy_index = indices[1]
-
-func _set_multimesh_instance(
-	pos: Vector2,
-	col: Color, 
-	alpha: float,
-	owner_id: int,
-	holding: bool,
-	friendly_index: int,
-	enemy_index: int
-) -> Array[int]:
-	var agent_scale: float = HOLDING_SCALE if holding else 1.0
-	
-	# Use the base color to tint the pre-rendered texture
-	var tint_color: Color = col
-	tint_color.a = alpha
-	
-	var transform: Transform2D = Transform2D()
-	transform = transform.scaled(Vector2(agent_scale, agent_scale))
-	transform.origin = pos
-	
-	assert(friendly_index < MAX_UNITS_DRAW)
-	assert(enemy_index < MAX_UNITS_DRAW)
-	if owner_id == 0:  # Friendly
-		if friendly_index < MAX_UNITS_DRAW:
-			_friendly_multimesh.set_instance_transform_2d(friendly_index, transform)
-			_friendly_multimesh.set_instance_color(friendly_index, tint_color)
-			friendly_index += 1
-	else:  # Enemy
-		if enemy_index < MAX_UNITS_DRAW:
-			_enemy_multimesh.set_instance_transform_2d(enemy_index, transform)
-			_enemy_multimesh.set_instance_color(enemy_index, tint_color)
-			enemy_index += 1
-	
-	return [friendly_index, enemy_index]
+
+	# Units whose group is not in clicked_original_walkable_areas get the
+	# black mask overlay of the polygon layers
+	var group_dimmed: PackedByteArray = PackedByteArray()
+	var sim: GameSimulationComponent = _sim()
+	if sim != null:
+		group_dimmed.resize(_groups.size())
+		for g: int in range(_groups.size()):
+			group_dimmed[g] = 0 if sim.clicked_original_walkable_areas.has(_groups[g].polygon_id) else 1
+
+	# Fake agents first, then the visible real agents; unused instances stay
+	# transparent
+	var buffers: Array = _agent_store.build_instance_buffers(
+		MAX_UNITS_DRAW,
+		group_dimmed,
+		DrawComponent.DARKEN_UNCLICKED_ALPHA,
+		HOLDING_SCALE,
+		_fake_positions,
+		_fake_owners,
+		_fake_holding,
+		_fake_tint
+	)
+	_friendly_multimesh.buffer = buffers[0]
+	_enemy_multimesh.buffer = buffers[1]
+
+# Tint per owner id for the store, extended when a new owner spawns units
+func _ensure_owner_tint(owner_id: int) -> void:
+	if owner_id < _owner_tints.size():
+		return
+	for o: int in range(_owner_tints.size(), owner_id + 1):
+		if use_flags:
+			# For flags, use white tint to preserve original flag colors
+			_owner_tints.append((2*Color.WHITE+Global.get_vehicle_color(o))/3.0)
+		else:
+			# For NATO symbols, use the vehicle color for tinting
+			_owner_tints.append(Global.get_vehicle_color(o))
+	_agent_store.set_owner_tints(_owner_tints)
 
 func _refresh_navigation_for_area(
 	area: Area,
 	traversable_outline: PackedVector2Array,
 	obstacles: Array[PackedVector2Array]
 ) -> void:
+	# Only rebake regions whose polygon (or the obstacles) changed
+	if _region_version_by_area.get(area, -1) == area.polygon_version:
+		return
+
 	# 1. Ensure or create the region RID (unchanged)
 	var region: RID
 	if _region_by_area.has(area):
@@ -497,29 +474,25 @@ func _refresh_navigation_for_area(
 		NavigationServer2D.region_set_navigation_layers(region, navigation_layer)
 		_region_to_navigation_layer[region] = navigation_layer
 		
-	# 2. Create source geometry and add your polygon outline
-	var source_data := NavigationMeshSourceGeometryData2D.new()
-	
-	# Player-controlled areas: traversable
-	source_data.append_traversable_outlines(
-		[
-			traversable_outline
-		]
-	)
-	source_data.append_obstruction_outlines(obstacles)
+	# 2. Triangulate the outline minus the obstacles (constrained Delaunay,
+	# updated in place from the area's previous triangulation)
+	var mesh: Array = _navmesh_builder.update(area.polygon_id, traversable_outline, obstacles)
 
-	# 3. Bake into a new NavigationPolygon
+	# 3. Fill a new NavigationPolygon with the triangles, no bake needed
 	var nav_poly := NavigationPolygon.new()
-	nav_poly.agent_radius = 0.0
-	NavigationServer2D.bake_from_source_geometry_data(nav_poly, source_data)
+	nav_poly.vertices = mesh[0]
+	for polygon: PackedInt32Array in mesh[1]:
+		nav_poly.add_polygon(polygon)
 
 	# 4. Assign to the region
 	NavigationServer2D.region_set_navigation_polygon(region, nav_poly)
+	_region_version_by_area[area] = area.polygon_version
+	_navigation_cache.update_area(area.polygon_id, area.polygon_version, area.polygon)
 
 # ───────── Agent‑count synch / spawn / kill ─────────
 func _sync_counts(sim: GameSimulationComponent) -> void:
 	var desired: Dictionary = {}
-	var count_per_area: Dictionary = _count_living_agents_per_area()
+	var count_per_area: Dictionary = _count_living_agents_per_area(_agent_store.get_states())
 	for area: Area in sim.areas:
 		if area.owner_id >= 0:
 			var ideal: float = MAX_UNITS * area.get_strength(
@@ -547,13 +520,8 @@ func _sync_counts(sim: GameSimulationComponent) -> void:
 				MAX_UNITS
 			)
 			
-	var current: Dictionary = {}
-	for ag: Agent in _agents:
-		if ag.state != State.DYING:
-			current[ag.area] = current.get(ag.area, 0) + 1
-
 	for area: Area in desired.keys():
-		var diff: int = desired[area] - current.get(area, 0)
+		var diff: int = desired[area] - count_per_area.get(area, 0)
 		if diff > 0:
 			for _i: int in range(diff):
 				_spawn_agent(area)
@@ -564,47 +532,39 @@ func _sync_counts(sim: GameSimulationComponent) -> void:
 func _spawn_agent(area: Area) -> void:
 	var ag: Agent = Agent.new()
 	ag.area = area
-	ag.pos = GeometryUtils.calculate_centroid(area.polygon)
-	#ag.pos  = GeometryUtils.clamp_point_to_polygon(area.polygon, GeometryUtils.calculate_centroid(area.polygon))
 	ag.group = null
 	ag.id = ag.get_instance_id()
+	ag.index = _agent_store.add_agent(GeometryUtils.calculate_centroid(area.polygon), area.polygon_id, area.owner_id)
+	_ensure_owner_tint(area.owner_id)
 	_agents.append(ag)
 
 
 func _kill_some(area: Area, n: int) -> void:
-	for ag: Agent in _agents:
-		if n <= 0:
-			break
-		if ag.area == area and ag.state == State.ALIVE:
-			ag.state = State.DYING
-			# Remove trail data for this agent
-			if _trail_manager != null:
-				_trail_manager.remove_trails(ag.id)
-			n -= 1
+	_remove_trails(_agent_store.kill_in_area(area.polygon_id, n))
 
 
-func _fade_removed_areas(sim: Node) -> void:
-	for ag: Agent in _agents:
-		if ag.state != State.DYING and ag.area not in sim.areas:
-			ag.state = State.DYING
-			# Remove trail data for agents from removed areas
-			if _trail_manager != null:
-				_trail_manager.remove_trails(ag.id)
+# Remove trail data for store agents that started dying
+func _remove_trails(indices: PackedInt32Array) -> void:
+	if _trail_manager != null:
+		for i: int in indices:
+			_trail_manager.remove_trails(_agents[i].id)
 
-	# Clean up fake agents for removed areas
-	var i: int = 0
-	while i < _fake_agents.size():
-		var ag: Agent = _fake_agents[i]
-		if ag.area not in sim.areas:
-			_fake_agents.remove_at(i)
-		else:
-			i += 1
 
+func _fade_removed_areas(sim: Node) -> void:
 	for old_area: Area in _region_by_area.keys():
 		if old_area not in sim.areas:
+			# Agents of removed areas fade out where they stand
+			_remove_trails(_agent_store.kill_area(old_area.polygon_id))
+			_agent_store.remove_area(old_area.polygon_id)
+			_store_area_versions.erase(old_area)
+			_offset_areas.erase(old_area)
+
 			var region: RID = _region_by_area[old_area]
 			_region_to_navigation_layer.erase(_region_by_area[old_area])
 			_region_by_area.erase(old_area)
+			_region_version_by_area.erase(old_area)
+			_navigation_cache.remove_area(old_area.polygon_id)
+			_navmesh_builder.remove(old_area.polygon_id)
 			NavigationServer2D.free_rid(region)
 			
 	
@@ -613,44 +573,30 @@ func _fade_removed_areas(sim: Node) -> void:
 func _update_frontlines(sim: Node) -> void:
 	_front_by_area.clear()
 	
-	_offset_areas.clear()
-	for ag: Agent in _agents:
-		if not _offset_areas.has(ag.area):
-			var area: Area = ag.area
-			var unclipped_offset_polygons: Array[PackedVector2Array] = Geometry2D.offset_polygon(
-				area.polygon,
-				-POLYLINE_OFFSET if area.owner_id != GameSimulationComponent.PLAYER_ID else -POLYLINE_OFFSET*1.0,
-				# Use round to avoid jitter, that comes from miter.
-				Geometry2D.JOIN_ROUND
-			)
-			#debug_polylines = unclipped_offset_polygons
-			#unclipped_offset_polygons = [GeometryUtils.find_largest_polygon(unclipped_offset_polygons)]
-			unclipped_offset_polygons = GeometryUtils.split_into_inner_outer_polygons(unclipped_offset_polygons)[0]
-			#var unclipped_offset_polygons: Array[PackedVector2Array] = [area.polygon]
-			#var offset_polygons: Array[PackedVector2Array] = unclipped_offset_polygons
-		
-			#var offset_polygons: Array[PackedVector2Array] = []
-			#for unclipped_offset_polygon: PackedVector2Array in unclipped_offset_polygons:
-				#offset_polygons.append_array(
-					#Geometry2D.intersect_polygons(
-						#unclipped_offset_polygon,
-						#area.polygon
-					#)
-				#)
-			#offset_polygons = GeometryUtils.split_into_inner_outer_polygons(offset_polygons)[0]
-			
-			var offset_polygons: Array[PackedVector2Array] = unclipped_offset_polygons
-			
-			#var curves: Array[Curve2D] = []
-			#for offset_polygon: PackedVector2Array in offset_polygons:
-				#var curve: Curve2D = Curve2D.new()
-				##curve.bake_interval = 1
-				#for point: Vector2 in offset_polygon:
-					#curve.add_point(point)
-				#curve.add_point(offset_polygon[0])
-				#curves.append(curve)
-			
-			_offset_areas[area] = offset_polygons
+	# Only owned areas whose polygon changed since the last upload are offset
+	# again and replaced in the agent store
+	var offset_keys: Array[Area] = []
+	var offset_sources: Array[PackedVector2Array] = []
+	for area: Area in sim.areas:
+		if area.owner_id >= 0 and _store_area_versions.get(area, -1) != area.polygon_version:
+			offset_keys.append(area)
+			offset_sources.append(area.polygon)
+	# One native call for every changed area; only the outers are kept.
+	# Use round to avoid jitter, that comes from miter.
+	var offset_results: Array = []
+	if not offset_keys.is_empty():
+		offset_results = sim.offset_polygons_batched(
+			offset_sources,
+			PackedFloat32Array([-POLYLINE_OFFSET]),
+			Geometry2D.JOIN_ROUND
+		)
+	for i: int in offset_results.size():
+		var area: Area = offset_keys[i]
+		var offset_polygons: Array[PackedVector2Array] = []
+		offset_polygons.assign(offset_results[i][0])
+		_offset_areas[area] = offset_polygons
+		_agent_store.set_area(area.polygon_id, area.polygon, offset_polygons)
+		_store_area_versions[area] = area.polygon_version
 			
 	for area: Area in sim.newly_expanded_polylines.keys():
 		if not _offset_areas.has(area):
@@ -724,19 +670,12 @@ func _update_frontlines(sim: Node) -> void:
 		_front_by_area[area] = dict_groups
 
 
-func _assign_optimal(cost: Array) -> Array[int]:
-	# The matrix must be non‑empty and square; keep the same asserts
-	var n: int = cost.size()
-	assert(n > 0 and cost[0].size() == n)
-
-	if n <= HUNGARIAN_MAX_N:
-		return _hungarian(cost)
-	else:
-		return _greedy_assignment(cost)
-
-func _greedy_assignment(cost: Array) -> Array[int]:
-	var n: int = cost.size()
+func _assign_optimal(cost: PackedFloat32Array, n: int) -> PackedInt32Array:
+	# The matrix must be non‑empty and square
+	assert(n > 0 and cost.size() == n * n)
+	return AssignmentSolver.solve(cost, n)
 
+func _greedy_assignment(cost: PackedFloat32Array, n: int) -> PackedInt32Array:
 	# Track which columns are already taken
 	var col_taken: PackedByteArray = PackedByteArray()
 	col_taken.resize(n)
@@ -744,7 +683,7 @@ func _greedy_assignment(cost: Array) -> Array[int]:
 		col_taken[j] = false
 
 	# Resulting assignment
-	var assign: Array[int] = []
+	var assign: PackedInt32Array = PackedInt32Array()
 	assign.resize(n)
 
 	for i: int in range(n):
@@ -753,7 +692,7 @@ func _greedy_assignment(cost: Array) -> Array[int]:
 
 		for j: int in range(n):
 			if col_taken[j] == 0:
-				var v: float = cost[i][j]
+				var v: float = cost[i * n + j]
 				if v < best_val:
 					best_val = v
 					best_col = j
@@ -770,12 +709,17 @@ func _greedy_assignment(cost: Array) -> Array[int]:
 # ─────────────────────────────────────────────
 func _assign_slots() -> void:
 	# Clear existing fake agents since they'll be recreated during assignment
-	_fake_agents.clear()
+	_clear_fake_agents()
+	_tick_states = _agent_store.get_states()
+	_tick_positions = _agent_store.get_positions()
+
+	# 0) count living agents per controlled area
+	var count_per_area: Dictionary = _count_living_agents_per_area(_tick_states)
 
 	# Check if any areas have frontlines - if not, clear all groups
 	var has_any_frontlines: bool = false
-	for area: Area in _front_by_area.keys():
-		for group: Area in _front_by_area[area]:
+	for area: Area in count_per_area.keys():
+		for group: Area in _front_by_area.get(area, {}):
 			for fronts: Dictionary in _front_by_area[area][group]:
 				if fronts.size() != 0:
 					has_any_frontlines = true
@@ -785,14 +729,12 @@ func _assign_slots() -> void:
 		# No frontlines exist, so clear all groups
 		for ag in _agents:
 			ag.group = null
+		_agent_store.clear_groups()
 		return
 	
-	# 0) remember where everyone was before we start reshuffling
+	# 0-bis) remember where everyone was before we start reshuffling
 	_store_prev_groups()
 
-	# 0-bis) count living agents per controlled area
-	var count_per_area: Dictionary = _count_living_agents_per_area()
-
 	# ─── process one area at a time ───
 	for area in count_per_area.keys():
 		var needed: int = count_per_area[area]
@@ -819,6 +761,48 @@ func _assign_slots() -> void:
 		# 5–8) agent redistribution & Hungarian assignment
 		_distribute_and_assign_agents(area, groups, group_slots)
 
+	# Regroups first: a later slot assignment of the same agent wins
+	_agent_store.set_groups(_regrouped_indices, _regrouped_groups)
+	_agent_store.set_assignments(_assigned_indices, _assigned_slots, _assigned_groups, _assigned_holding)
+	_regrouped_indices.clear()
+	_regrouped_groups.clear()
+	_assigned_indices.clear()
+	_assigned_slots.clear()
+	_assigned_groups.clear()
+	_assigned_holding.clear()
+
+
+# Store group index of an original area, -1 for none
+func _group_index_of(grp: Area) -> int:
+	if grp == null:
+		return -1
+	if not _group_index.has(grp):
+		_group_index[grp] = _groups.size()
+		_groups.append(grp)
+	return _group_index[grp]
+
+
+# Moves the agent to another group; queued for the store
+func _regroup_agent(ag: Agent, grp: Area) -> void:
+	ag.group = grp
+	_regrouped_indices.append(ag.index)
+	_regrouped_groups.append(_group_index_of(grp))
+
+
+# Gives the agent a slot of its group; queued for the store
+func _assign_agent(ag: Agent, slot_pos: Vector2, grp: Area, holding: bool) -> void:
+	ag.group = grp
+	_assigned_indices.append(ag.index)
+	_assigned_slots.append(slot_pos)
+	_assigned_groups.append(_group_index_of(grp))
+	_assigned_holding.append(1 if holding else 0)
+
+
+func _clear_fake_agents() -> void:
+	_fake_positions.clear()
+	_fake_owners.clear()
+	_fake_holding.clear()
+
 
 # ─────────── Helper 0a ───────────
 func _store_prev_groups() -> void:
@@ -827,10 +811,10 @@ func _store_prev_groups() -> void:
 
 
 # ─────────── Helper 0b ───────────
-func _count_living_agents_per_area() -> Dictionary:
+func _count_living_agents_per_area(states: PackedInt32Array) -> Dictionary:
 	var count_per_area: Dictionary = {}
 	for ag: Agent in _agents:
-		if ag.state != State.DYING:
+		if states[ag.index] != State.DYING:
 			count_per_area[ag.area] = count_per_area.get(ag.area, 0) + 1
 	return count_per_area
 
@@ -1019,7 +1003,7 @@ func _distribute_and_assign_agents(
 	var deficits: Array = []
 
 	for ag: Agent in _agents:
-		if ag.area != area or ag.state == State.DYING:
+		if ag.area != area or _tick_states[ag.index] == State.DYING:
 			continue
 		if agents_by_group.has(ag.group) and agents_by_group[ag.group].size() < group_slots[ag.group]:
 			agents_by_group[ag.group].append(ag)
@@ -1051,12 +1035,12 @@ func _move_surplus_to_deficits(
 		group_slots: Dictionary
 ) -> void:
 	var m: int = surplus.size()
-	var cost_sd: Array = []
+	var cost_sd: PackedFloat32Array = PackedFloat32Array()
+	cost_sd.resize(m * m)
 	for i_r: int in range(m):
-		var row: Array = []
 		for j_c: int in range(m):
 			var g_def: Area = deficits[j_c]
-			var agent_pos: Vector2 = surplus[i_r].pos
+			var agent_pos: Vector2 = _tick_positions[surplus[i_r].index]
 			var target_pos: Vector2 = g_def.center
 			
 			# Get navigation path distance instead of Euclidean distance
@@ -1086,17 +1070,17 @@ func _move_surplus_to_deficits(
 			var group_penalty: float = 0.0
 			if group_slots.get(surplus[i_r].prev_group, 0) != 0 and surplus[i_r].prev_group != g_def:
 				# Use a very large penalty to make it extremely unlikely for agents to hop groups
-				group_penalty = 1.0e12
+				# (small enough that float32 costs still tell path lengths apart)
+				group_penalty = 1.0e7
 			
-			row.append(path_distance + group_penalty)
-		cost_sd.append(row)
+			cost_sd[i_r * m + j_c] = path_distance + group_penalty
 
-	var assign: Array[int] = _assign_optimal(cost_sd)
+	var assign: PackedInt32Array = _assign_optimal(cost_sd, m)
 	
 	for i_r: int in range(m):
 		var ag_move: Agent = surplus[i_r]
 		var grp_new: Area = deficits[assign[i_r]]
-		ag_move.group = grp_new
+		_regroup_agent(ag_move, grp_new)
 		agents_by_group[grp_new].append(ag_move)
 
 # ───────────────────────────────────────────────────────────────
@@ -1390,6 +1374,10 @@ func _hungarian_inside_groups(
 		agents_by_group: Dictionary,
 		slots_by_group: Dictionary
 ) -> void:
+	# Per group: incumbents are assigned first, entrants then take the real
+	# slots left over. Each stage solves the matrices of every group in one
+	# native call.
+	var plans: Array[Dictionary] = []
 	for grp in agents_by_group.keys():
 		var ags: Array = agents_by_group[grp]
 		var sls: Array = slots_by_group[grp]
@@ -1407,21 +1395,18 @@ func _hungarian_inside_groups(
 			else:
 				fake_agent_slots.append({"slot": slot, "index": i})
 		
+		var plan: Dictionary = {
+			"group": grp,
+			"agents": ags,
+			"real_slots": real_agent_slots,
+			"fake_slots": fake_agent_slots,
+			"n_inc": 0,
+			"n_ent": 0,
+		}
+		plans.append(plan)
 		var n_real_slots: int = real_agent_slots.size()
 		if n_real_slots == 0:
-			# All slots are fake agent slots - need to get the actual area from agents
-			if ags.size() > 0:
-				var agent_area: Area = ags[0].area
-				for slot_info: Dictionary in fake_agent_slots:
-					var slot: Dictionary = slot_info["slot"]
-					var fake_agent: Agent = Agent.new()
-					fake_agent.area = agent_area
-					fake_agent.pos = get_closest_point_to_offset(slot["pos"], fake_agent.area)
-					fake_agent.alpha = unit_alpha
-					fake_agent.state = State.ALIVE
-					fake_agent.holding = slot["holding"]
-					fake_agent.group = grp
-					_fake_agents.append(fake_agent)
+			# All slots are fake agent slots - only fake agents are created
 			continue
 		
 		#assert(ags.size() == n_real_slots)
@@ -1431,7 +1416,10 @@ func _hungarian_inside_groups(
 			# If we have too many agents, truncate the list
 			if ags.size() > n_real_slots:
 				ags = ags.slice(0, n_real_slots)
+				plan["agents"] = ags
 			# If we have too few agents, we'll just fill what we can
+		if ags.is_empty():
+			continue
 		
 		var agents_to_assign: int = min(ags.size(), n_real_slots)
 
@@ -1439,38 +1427,49 @@ func _hungarian_inside_groups(
 		var incumbents: Array = []
 		var entrants: Array = []
 		for ag in ags:
-			if ag.state == State.DYING: continue
-			if ag.prev_group == grp and ag.state != State.SPAWNING:
+			var state: int = _tick_states[ag.index]
+			if state == State.DYING: continue
+			if ag.prev_group == grp and state != State.SPAWNING:
 				incumbents.append(ag)
 			else:
 				entrants.append(ag)
 
 		# 1) incumbents → Hungarian over real agent slots only (with dummy rows)
 		var k_inc: int = min(incumbents.size(), agents_to_assign)
-		var cost_inc: Array = []
+		var cost_inc: PackedFloat32Array = PackedFloat32Array()
+		cost_inc.resize(agents_to_assign * agents_to_assign)
 		for r: int in range(agents_to_assign):
-			var row: Array = []
 			for c: int in range(agents_to_assign):
 				if r < k_inc:
-					assert(
-						not is_inf(incumbents[r].pos.x) and
-						not is_inf(incumbents[r].pos.y) and
-						not is_nan(incumbents[r].pos.x) and
-						not is_nan(incumbents[r].pos.y)
-					)
-					row.append(incumbents[r].pos.distance_squared_to(real_agent_slots[c]["slot"]["pos"]))
+					var incumbent_pos: Vector2 = _tick_positions[incumbents[r].index]
+					assert(incumbent_pos.is_finite())
+					cost_inc[r * agents_to_assign + c] = incumbent_pos.distance_squared_to(real_agent_slots[c]["slot"]["pos"])
 				else:
-					row.append(1.0e12)
-			cost_inc.append(row)
+					cost_inc[r * agents_to_assign + c] = 1.0e12
 
-		var assign_inc: Array[int]
-		if (
+		plan["optimal"] = (
 			_sim().intersecting_walkable_area_start_of_tick()[grp].has(ags[0].area) and
 			_sim().intersecting_walkable_area_start_of_tick()[grp][ags[0].area].size() < 2
-		):
-			assign_inc = _assign_optimal(cost_inc)
-		else:
-			assign_inc = _greedy_assignment(cost_inc)
+		)
+		plan["incumbents"] = incumbents
+		plan["entrants"] = entrants
+		plan["n_real"] = agents_to_assign
+		plan["k_inc"] = k_inc
+		plan["n_inc"] = agents_to_assign
+		plan["cost_inc"] = cost_inc
+
+	_assign_plans(plans, "n_inc", "cost_inc", "assign_inc")
+
+	for plan: Dictionary in plans:
+		if plan["n_inc"] == 0:
+			continue
+		var grp: Area = plan["group"]
+		var real_agent_slots: Array = plan["real_slots"]
+		var incumbents: Array = plan["incumbents"]
+		var entrants: Array = plan["entrants"]
+		var agents_to_assign: int = plan["n_real"]
+		var k_inc: int = plan["k_inc"]
+		var assign_inc: PackedInt32Array = plan["assign_inc"]
 
 		# reserve chosen real agent slots
 		var taken_real: PackedByteArray = PackedByteArray()
@@ -1482,9 +1481,7 @@ func _hungarian_inside_groups(
 			var ag_inc: Agent = incumbents[r]
 			var sl_idx: int = assign_inc[r]
 			var slot: Dictionary = real_agent_slots[sl_idx]["slot"]
-			ag_inc.slot = slot["pos"]
-			ag_inc.group = grp
-			ag_inc.holding = slot["holding"]
+			_assign_agent(ag_inc, slot["pos"], grp, slot["holding"])
 			taken_real[sl_idx] = true
 
 		# 2) entrants → Hungarian on remaining real agent slots
@@ -1498,125 +1495,69 @@ func _hungarian_inside_groups(
 			var k_ent: int = min(entrants.size(), remaining_agents, free_real_slots.size())
 			if k_ent > 0:
 				var n_free: int = free_real_slots.size()
-				var cost_ent: Array = []
+				var cost_ent: PackedFloat32Array = PackedFloat32Array()
+				cost_ent.resize(n_free * n_free)
 				for r: int in range(n_free):
-					var row: Array = []
 					for c: int in range(n_free):
 						if r < k_ent:
-							row.append(entrants[r].pos.distance_squared_to(free_real_slots[c]["slot"]["pos"]))
+							cost_ent[r * n_free + c] = _tick_positions[entrants[r].index].distance_squared_to(free_real_slots[c]["slot"]["pos"])
 						else:
-							row.append(1.0e12)
-					cost_ent.append(row)
-
-				var assign_ent: Array[int]
-				if (
-					_sim().intersecting_walkable_area_start_of_tick()[grp].has(ags[0].area) and
-					_sim().intersecting_walkable_area_start_of_tick()[grp][ags[0].area].size() < 2
-				):
-					assign_ent = _assign_optimal(cost_ent)
-				else:
-					assign_ent = _greedy_assignment(cost_ent)
-				for r: int in range(k_ent):
-					var ag_ent: Agent = entrants[r]
-					var sl_idx: int = assign_ent[r]
-					var slot: Dictionary = free_real_slots[sl_idx]["slot"]
-					ag_ent.slot = slot["pos"]
-					ag_ent.group = grp
-					ag_ent.holding = slot["holding"]
+							cost_ent[r * n_free + c] = 1.0e12
+				plan["free_real_slots"] = free_real_slots
+				plan["k_ent"] = k_ent
+				plan["n_ent"] = n_free
+				plan["cost_ent"] = cost_ent
+
+	_assign_plans(plans, "n_ent", "cost_ent", "assign_ent")
+
+	for plan: Dictionary in plans:
+		var grp: Area = plan["group"]
+		if plan["n_ent"] > 0:
+			var entrants: Array = plan["entrants"]
+			var free_real_slots: Array = plan["free_real_slots"]
+			var assign_ent: PackedInt32Array = plan["assign_ent"]
+			for r: int in range(plan["k_ent"]):
+				var ag_ent: Agent = entrants[r]
+				var sl_idx: int = assign_ent[r]
+				var slot: Dictionary = free_real_slots[sl_idx]["slot"]
+				_assign_agent(ag_ent, slot["pos"], grp, slot["holding"])
 		
 		# 3) Create fake agents for fake agent slots
+		var ags: Array = plan["agents"]
 		if ags.size() > 0:
 			var agent_area: Area = ags[0].area
-			for slot_info: Dictionary in fake_agent_slots:
+			for slot_info: Dictionary in plan["fake_slots"]:
 				var slot: Dictionary = slot_info["slot"]
-				var fake_agent: Agent = Agent.new()
-				fake_agent.area = agent_area
-				fake_agent.pos = get_closest_point_to_offset(slot["pos"], fake_agent.area)
-				fake_agent.alpha = unit_alpha
-				fake_agent.state = State.ALIVE
-				fake_agent.holding = slot["holding"]
-				fake_agent.group = grp
-				_fake_agents.append(fake_agent)
-
-# Hungarian implementation (square cost matrix)
-func _hungarian(cost: Array) -> Array[int]:
-	var n: int = cost.size()
-	
-	# Assert that cost matrix is valid - all values are real numbers
-	assert(n > 0, "Cost matrix must not be empty")
-	for i: int in range(n):
-		assert(cost[i].size() == n, "Cost matrix must be square")
-		for j: int in range(n):
-			assert(is_finite(cost[i][j]), "Cost matrix must contain only finite values (not NaN or INF)")
-	
-	var u: Array[float] = []
-	var v: Array[float] = []
-	var p: Array[int] = []
-	var way: Array[int] = []
-	u.resize(n + 1)
-	v.resize(n + 1)
-	p.resize(n + 1)
-	way.resize(n + 1)
-	
-	for i: int in range(1, n + 1):
-		p[0] = i
-		var j0: int = 0
-		var minv: Array[float] = []
-		var used: Array[bool] = []
-		minv.resize(n + 1)
-		used.resize(n + 1)
-		
-		for j: int in range(n + 1):
-			minv[j] = INF
-			used[j] = false
-		
-		while true:
-			used[j0] = true
-			var i0: int = p[j0]
-			var delta: float = INF
-			var j1: int = 0
-			
-			for j: int in range(1, n + 1):
-				if not used[j]:
-					var cur: float = cost[i0 - 1][j - 1] - u[i0] - v[j]
-					if cur < minv[j]:
-						minv[j] = cur
-						way[j] = j0
-					if minv[j] < delta:
-						delta = minv[j]
-						j1 = j
-			
-			for j: int in range(n + 1):
-				if used[j]:
-					u[p[j]] += delta
-					v[j] -= delta
-				else:
-					minv[j] -= delta
-			
-			j0 = j1
-			if p[j0] == 0:
-				break
-		
-		while true:
-			var j1: int = way[j0]
-			p[j0] = p[j1]
-			j0 = j1
-			if j0 == 0:
-				break
-	
-	var ans: Array[int] = []
-	ans.resize(n)
-	for j: int in range(1, n + 1):
-		var i: int = p[j]
-		ans[i - 1] = j - 1
-	
-	return ans
-
-# Helper function to check if a value is finite (not NaN or INF)
-func is_finite(value: float) -> bool:
-	if is_nan(value) or is_inf(value):
-		return false
-	return true
+				_fake_positions.append(get_closest_point_to_offset(slot["pos"], agent_area))
+				_fake_owners.append(agent_area.owner_id)
+				_fake_holding.append(1 if slot["holding"] else 0)
+
+# Solves the square matrix plan[cost_key] (plan[size_key] rows) of every plan
+# with a nonzero size and stores its row → column assignment in
+# plan[assign_key]. Optimal plans share one AssignmentSolver call, the rest
+# are assigned greedily.
+func _assign_plans(plans: Array[Dictionary], size_key: String, cost_key: String, assign_key: String) -> void:
+	var costs: PackedFloat32Array = PackedFloat32Array()
+	var sizes: PackedInt32Array = PackedInt32Array()
+	var batched: Array[Dictionary] = []
+	for plan: Dictionary in plans:
+		var n: int = plan[size_key]
+		if n == 0:
+			continue
+		if plan["optimal"]:
+			costs.append_array(plan[cost_key])
+			sizes.append(n)
+			batched.append(plan)
+		else:
+			plan[assign_key] = _greedy_assignment(plan[cost_key], n)
+	if batched.is_empty():
+		return
+	var solution: PackedInt32Array = AssignmentSolver.solve_groups(costs, sizes, AUCTION_MIN_N)
+	var offset: int = 0
+	for plan: Dictionary in batched:
+		var n: int = plan[size_key]
+		plan[assign_key] = solution.slice(offset, offset + n)
+		offset += n
 
 
 func get_closest_point_to_offset(
@@ -1639,114 +1580,72 @@ func get_closest_point_to_offset(
 	return closest_point
 	
 # ─────────── Integration (movement) ───────────
+# Fades, containment, slot targets, routing and movement run natively on the
+# agent store.
 func _integrate_agents(delta: float) -> void:
-	var i: int = 0
-	while i < _agents.size():
-		var ag: Agent = _agents[i]
-		# ─── fade‑in / fade‑out handling ───
-		if ag.state == State.SPAWNING:
-			ag.alpha += delta / spawn_fade_time
-			if ag.alpha >= unit_alpha:
-				ag.alpha = unit_alpha
-				ag.state = State.ALIVE
-		elif ag.state == State.DYING:
-			ag.alpha -= delta / die_fade_time
-			if ag.alpha <= 0.0:
-				# Remove trail data for this agent
-				if _trail_manager != null:
-					_trail_manager.remove_trails(ag.id)
-				_agents.remove_at(i)
-				continue
-
-		if ag.area.polygon.size() <= 2:
-			i += 1
+	var count: int = _agents.size()
+	if count == 0:
+		return
+	var sim: GameSimulationComponent = _sim()
+
+	# Expansion speed boost of an agent = its group's unit-strength rate ×
+	# its area's strength density (get_expansion_speed is linear in strength)
+	var strength_keys: PackedInt64Array = PackedInt64Array()
+	var strengths: PackedFloat32Array = PackedFloat32Array()
+	for area: Area in _store_area_versions.keys():
+		strength_keys.append(area.polygon_id)
+		strengths.append(sim.get_strength_density(area))
+	_agent_store.set_area_strengths(strength_keys, strengths)
+
+	var rates: PackedFloat32Array = PackedFloat32Array()
+	rates.resize(_groups.size())
+	for g: int in range(_groups.size()):
+		var grp: Area = _groups[g]
+		if sim.USE_UNION and not sim.union_walkable_areas_to_original_walkable_areas.has(grp):
+			rates[g] = -1.0
 			continue
-		
-		#ag.pos = get_closest_point_to_offset(ag.pos, ag.area)
-		if not GeometryUtils.is_point_in_polygon(ag.pos, ag.area.polygon):
-			ag.pos = GeometryUtils.clamp_point_to_polygon_with_curve(ag.area.polygon, ag.pos, _area_curves[ag.area])
-
-		# ─── navigation update (alive only) ───
-		if ag.state != State.DYING:
-			var target_pos: Vector2 = ag.slot
-
-			target_pos = get_closest_point_to_offset(target_pos, ag.area)
-
-			var region_rid: RID = _region_by_area.get(ag.area, RID())
-			if region_rid != RID():
-				# Calculate a fresh path every tick
-				ag._path = NavigationServer2D.map_get_path(
-					_nav_map,
-					ag.pos,
-					target_pos,
-					true,
-					_region_to_navigation_layer[_region_by_area[ag.area]]
-				)
-	
-				var dist: float = 0.0
-				var prev_pos: Vector2 = ag.pos
-				for path_pos: Vector2 in ag._path:
-					dist += (path_pos-prev_pos).length()
-					prev_pos = path_pos
-
-				if ag._path.size() >= 2:
-					var next_pt: Vector2 = ag._path[1]
-					var final_pt: Vector2 = ag._path[-1]
-					var to_next: Vector2 = next_pt - ag.pos
-					var desired_speed: float = dist / slot_reach_time
-				
-					# Only apply expansion speed boost for offensive lines (not holding/defensive lines)
-					if not ag.holding and ag.group != null:
-						
-						if (
-							not _sim().USE_UNION or
-							_sim().union_walkable_areas_to_original_walkable_areas.has(ag.group)
-						):
-							# TODO use air, borders, min, max
-							var expansion_speed: float = Global.get_expansion_speed(
-								GameSimulationComponent.EXPANSION_SPEED,
-								_sim().get_strength_density(ag.area),
-								_sim().map,
-								ag.group if not _sim().USE_UNION else _sim().union_walkable_areas_to_original_walkable_areas[ag.group][0],
-								false,
-							)
-							#desired_speed = max(desired_speed, 1.0*expansion_speed)
-							
-							# To get fast but smooth movement close.
-							desired_speed = max(desired_speed, 1.0 * expansion_speed * (pow(dist+1, 1.0/2.0)-1))
-							# To get fast movement far away.
-							desired_speed = max(desired_speed, 0.05 * expansion_speed * dist)
-							
-					#if desired_speed > max_speed:
-						#print(1)
-					desired_speed = max(min(max_speed, desired_speed), min_speed)
-					
-					#var distance_to_goal: float = sqrt((final_pt-ag.pos).length())
-					#desired_speed = max(distance_to_goal / delta, desired_speed)
-					var desired_vel: Vector2 = to_next.normalized() * desired_speed
-					ag.vel = desired_vel
-				else:
-					ag.vel = Vector2.ZERO
+		# TODO use air, borders, min, max
+		rates[g] = Global.get_expansion_speed(
+			GameSimulationComponent.EXPANSION_SPEED,
+			1.0,
+			sim.map,
+			grp if not sim.USE_UNION else sim.union_walkable_areas_to_original_walkable_areas[grp][0],
+			false,
+		)
+	_agent_store.set_group_rates(rates)
 
-			# Cap absolute speed
-			if ag.vel.length() > max_speed:
-				ag.vel = ag.vel.normalized() * max_speed
+	var navigating: PackedInt32Array = _agent_store.begin_step(delta)
 
-		# ─── apply velocity ───
-		var old_pos: Vector2 = ag.pos
-		ag.pos += ag.vel * delta
-		
-		# Add trail segment if agent moved and trail manager exists
-		if _trail_manager != null and ag.state != State.DYING and ag.vel.length() >= TRAIL_MINIMUM_LENGTH:
-			_trail_manager.add_trail_segment(ag.pos, ag.id, ag.area.owner_id)
-		
-		#ag.pos = ag._path[-1]
-		#ag.pos = GeometryUtils.clamp_point_to_polygon(ag.area.polygon, ag.pos)
-		#if not GeometryUtils.is_point_in_polygon(ag.pos, ag.area.polygon):
-			#print(ag.pos, ", ",  NavigationServer2D.region_get_closest_point(_region_by_area[ag.area],ag.pos))
-			#ag.pos = NavigationServer2D.region_get_closest_point(_region_by_area[ag.area],ag.pos)
-		#ag.pos = NavigationServer2D.map_get_closest_point(_region_by_area[ag.area],ag.pos)
-		i += 1
+	# ─── navigation update (alive only) ───
+	# Cached per-area routes; NaN lengths (no navigation yet) keep the velocity
+	var routes: Array = _navigation_cache.route(
+		navigating,
+		_agent_store.get_area_keys(),
+		_agent_store.get_positions(),
+		_agent_store.get_targets()
+	)
+	var waypoints: PackedVector2Array = routes[0]
+	var path_lengths: PackedFloat32Array = routes[1]
+
+	# ─── apply velocity ───
+	_agent_store.finish_step(delta, waypoints, path_lengths)
+
+	# Add trail segment if agent moved and trail manager exists
+	if _trail_manager != null:
+		var positions: PackedVector2Array = _agent_store.get_positions()
+		for i: int in _agent_store.get_moving_agents(TRAIL_MINIMUM_LENGTH):
+			var ag: Agent = _agents[i]
+			_trail_manager.add_trail_segment(positions[i], ag.id, ag.area.owner_id)
+
+	# Faded out agents are dropped; their trails went when they started dying
+	var kept: PackedInt32Array = _agent_store.compact()
+	if kept.size() != count:
+		var survivors: Array[Agent] = []
+		survivors.resize(kept.size())
+		for k: int in range(kept.size()):
+			survivors[k] = _agents[kept[k]]
+			survivors[k].index = k
+		_agents = survivors
 
 # Legacy drawing functions removed - now using MultiMesh GPU instancing	
 